@@ -84,6 +84,11 @@ public abstract class Pixels {
     private final float scalex;
     private final float scaley;
 
+    // The area, in pixels, that differs from the previously uploaded frame.
+    // A negative damage width means that the whole image must be uploaded.
+    private int damageX, damageY;
+    private int damageWidth = -1, damageHeight = -1;
+
     protected Pixels(final int width, final int height, final ByteBuffer pixels) {
         this(width, height, pixels, 1.0f, 1.0f);
     }
@@ -175,6 +180,83 @@ public abstract class Pixels {
         return this.bytesPerComponent;
     }
 
+    /**
+     * Restricts the area that needs to be uploaded to the screen to the
+     * given rectangle, clipped to the bounds of this {@code Pixels} object.
+     * Views which retain their previous contents may use this to avoid
+     * copying unchanged pixels.
+     */
+    public final void setDamage(int x, int y, int w, int h) {
+        int x1 = Math.min(x + w, this.width);
+        int y1 = Math.min(y + h, this.height);
+        this.damageX = Math.max(x, 0);
+        this.damageY = Math.max(y, 0);
+        this.damageWidth = Math.max(x1 - this.damageX, 0);
+        this.damageHeight = Math.max(y1 - this.damageY, 0);
+    }
+
+    /**
+     * Marks the entire image as needing to be uploaded to the screen.
+     */
+    public final void damageAll() {
+        this.damageX = this.damageY = 0;
+        this.damageWidth = this.damageHeight = -1;
+    }
+
+    /**
+     * Extends the damaged area of this {@code Pixels} object by the damaged
+     * area of {@code other}, typically a frame that was superseded before it
+     * could be uploaded.
+     */
+    public final void addDamage(Pixels other) {
+        if (isFullyDamaged()) {
+            return;
+        }
+        if (other.isFullyDamaged() ||
+                other.width != this.width || other.height != this.height) {
+            damageAll();
+            return;
+        }
+        if (other.damageWidth == 0 || other.damageHeight == 0) {
+            return;
+        }
+        if (this.damageWidth == 0 || this.damageHeight == 0) {
+            setDamage(other.damageX, other.damageY, other.damageWidth, other.damageHeight);
+            return;
+        }
+        int x0 = Math.min(this.damageX, other.damageX);
+        int y0 = Math.min(this.damageY, other.damageY);
+        int x1 = Math.max(this.damageX + this.damageWidth, other.damageX + other.damageWidth);
+        int y1 = Math.max(this.damageY + this.damageHeight, other.damageY + other.damageHeight);
+        setDamage(x0, y0, x1 - x0, y1 - y0);
+    }
+
+    public final boolean isFullyDamaged() {
+        return this.damageWidth < 0;
+    }
+
+    public final int getDamageX() {
+        return this.damageX;
+    }
+
+    public final int getDamageY() {
+        return this.damageY;
+    }
+
+    /**
+     * @return the width of the damaged area, or -1 if the whole image is damaged
+     */
+    public final int getDamageWidth() {
+        return this.damageWidth;
+    }
+
+    /**
+     * @return the height of the damaged area, or -1 if the whole image is damaged
+     */
+    public final int getDamageHeight() {
+        return this.damageHeight;
+    }
+
     /**
      * Rewinds and returns the buffer used to create this {@code Pixels} object.
      *
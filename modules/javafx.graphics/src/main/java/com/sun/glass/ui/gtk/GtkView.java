@@ -86,24 +86,33 @@ final class GtkView extends View {
     @Override
     protected void _uploadPixels(long ptr, Pixels pixels) {
         Buffer data = pixels.getPixels();
+        int dx = pixels.getDamageX();
+        int dy = pixels.getDamageY();
+        int dw = pixels.getDamageWidth();
+        int dh = pixels.getDamageHeight();
         if (data.isDirect() == true) {
-            _uploadPixelsDirect(ptr, data, pixels.getWidth(), pixels.getHeight());
+            _uploadPixelsDirect(ptr, data, pixels.getWidth(), pixels.getHeight(), dx, dy, dw, dh);
         } else if (data.hasArray() == true) {
             if (pixels.getBytesPerComponent() == 1) {
                 ByteBuffer bytes = (ByteBuffer)data;
-                _uploadPixelsByteArray(ptr, bytes.array(), bytes.arrayOffset(), pixels.getWidth(), pixels.getHeight());
+                _uploadPixelsByteArray(ptr, bytes.array(), bytes.arrayOffset(), pixels.getWidth(), pixels.getHeight(), dx, dy, dw, dh);
             } else {
                 IntBuffer ints = (IntBuffer)data;
-                _uploadPixelsIntArray(ptr, ints.array(), ints.arrayOffset(), pixels.getWidth(), pixels.getHeight());
+                _uploadPixelsIntArray(ptr, ints.array(), ints.arrayOffset(), pixels.getWidth(), pixels.getHeight(), dx, dy, dw, dh);
             }
         } else {
             // gznote: what are the circumstances under which this can happen?
-            _uploadPixelsDirect(ptr, pixels.asByteBuffer(), pixels.getWidth(), pixels.getHeight());
+            _uploadPixelsDirect(ptr, pixels.asByteBuffer(), pixels.getWidth(), pixels.getHeight(), dx, dy, dw, dh);
         }
     }
-    private native void _uploadPixelsDirect(long viewPtr, Buffer pixels, int width, int height);
-    private native void _uploadPixelsByteArray(long viewPtr, byte[] pixels, int offset, int width, int height);
-    private native void _uploadPixelsIntArray(long viewPtr, int[] pixels, int offset, int width, int height);
+    // The dx, dy, dw, dh arguments describe the damaged area to repaint,
+    // a negative dw or dh repaints the whole view
+    private native void _uploadPixelsDirect(long viewPtr, Buffer pixels, int width, int height,
+                                            int dx, int dy, int dw, int dh);
+    private native void _uploadPixelsByteArray(long viewPtr, byte[] pixels, int offset, int width, int height,
+                                               int dx, int dy, int dw, int dh);
+    private native void _uploadPixelsIntArray(long viewPtr, int[] pixels, int offset, int width, int height,
+                                              int dx, int dy, int dw, int dh);
 
     @Override
     protected native boolean _enterFullscreen(long ptr, boolean animate, boolean keepRatio, boolean hideCursor);
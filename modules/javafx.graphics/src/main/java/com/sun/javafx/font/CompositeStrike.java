@@ -163,6 +163,27 @@ public class CompositeStrike implements FontStrike {
         return getStrikeSlot(slot).getGlyph(slotglyphCode);
     }
 
+    public void prepareGlyphs(int[] glyphCodes, int count) {
+        int[] slotGlyphCodes = null;
+        boolean[] done = null;
+        for (int i = 0; i < count; i++) {
+            int slot = (glyphCodes[i] >>> 24);
+            if (done != null && done[slot]) continue;
+            if (slotGlyphCodes == null) {
+                slotGlyphCodes = new int[count];
+                done = new boolean[256];
+            }
+            int slotCount = 0;
+            for (int j = i; j < count; j++) {
+                if ((glyphCodes[j] >>> 24) == slot) {
+                    slotGlyphCodes[slotCount++] = glyphCodes[j] & CompositeGlyphMapper.GLYPHMASK;
+                }
+            }
+            getStrikeSlot(slot).prepareGlyphs(slotGlyphCodes, slotCount);
+            done[slot] = true;
+        }
+    }
+
      /**
      * Access to individual character advances are frequently needed for layout
      * understand that advance may vary for single glyph if ligatures or kerning
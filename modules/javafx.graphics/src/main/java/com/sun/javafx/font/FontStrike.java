@@ -47,6 +47,13 @@ public interface FontStrike {
     public Metrics getMetrics();
     public Glyph getGlyph(char symbol);
     public Glyph getGlyph(int glyphCode);
+
+    /**
+     * Hints that the given glyphs are about to be rasterized, allowing
+     * implementations to render them as a batch rather than one at a time
+     * from {@link Glyph#getPixelData(int)}. Implementations may ignore it.
+     */
+    public void prepareGlyphs(int[] glyphCodes, int count);
     public void clearDesc(); // for cache management.
     public int getAAMode();
 
@@ -27,6 +27,7 @@ package com.sun.javafx.font;
 
 import com.sun.javafx.geom.RectBounds;
 import com.sun.javafx.geom.Shape;
+import java.nio.ByteBuffer;
 
 public interface Glyph {
     public int getGlyphCode();
@@ -43,6 +44,16 @@ public interface Glyph {
      * @see FontStrike#getQuantizedPosition(com.sun.javafx.geom.Point2D)
      */
     public byte[] getPixelData(int subPixel);
+
+    /**
+     * Returns the same mask as {@link #getPixelData(int)}, from the current
+     * position to the limit of the buffer. Implementations that render masks
+     * into native memory return it without copying it to a byte array.
+     */
+    public default ByteBuffer getPixelBuffer(int subPixel) {
+        byte[] data = getPixelData(subPixel);
+        return data != null ? ByteBuffer.wrap(data) : null;
+    }
     public float getPixelXAdvance();
     public float getPixelYAdvance();
     public boolean isLCDGlyph();
@@ -174,6 +174,9 @@ public abstract class PrismFontStrike<T extends PrismFontFile> implements FontSt
         return glyph;
     }
 
+    public void prepareGlyphs(int[] glyphCodes, int count) {
+    }
+
     protected abstract Path2D createGlyphOutline(int glyphCode);
 
     public Shape getOutline(GlyphList gl, BaseTransform transform) {
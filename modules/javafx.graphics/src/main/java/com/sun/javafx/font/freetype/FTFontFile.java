@@ -33,6 +33,7 @@ import com.sun.javafx.font.PrismFontFile;
 import com.sun.javafx.font.PrismFontStrike;
 import com.sun.javafx.geom.Path2D;
 import com.sun.javafx.geom.transform.BaseTransform;
+import java.nio.ByteBuffer;
 
 class FTFontFile extends PrismFontFile {
     /*
@@ -52,6 +53,16 @@ class FTFontFile extends PrismFontFile {
     private long face;
     private FTDisposer disposer;
 
+    /* initGlyphs() renders masks into a shared direct page and every glyph
+     * keeps a slice of it, which the glyph cache uploads to its texture as
+     * is. A page is filled across batches and is freed with the last glyph
+     * that refers to it. Guarded by the same lock.
+     */
+    private static final int MASK_PAGE_SIZE = 64 * 1024;
+    private ByteBuffer maskPage;
+    private int maskPageOffset;
+    private int[] batchRecords;
+
     FTFontFile(String name, String filename, int fIndex, boolean register,
                boolean embedded, boolean copy, boolean tracked) throws Exception {
         super(name, filename, fIndex, register, embedded, copy, tracked);
@@ -117,18 +128,17 @@ class FTFontFile extends PrismFontFile {
         return OSFreetype.FT_Outline_Decompose(face);
     }
 
-    synchronized void initGlyph(FTGlyph glyph, FTFontStrike strike) {
-        float size = strike.getSize();
-        if (size == 0) {
-            glyph.buffer = new byte[0];
-            glyph.bitmap = new FT_Bitmap();
-            return;
-        }
-        int size26dot6 = (int)(size * 64);
-        OSFreetype.FT_Set_Char_Size(face, 0, size26dot6, 72, 72);
+    private boolean isLCD(FTFontStrike strike) {
+        return strike.getAAMode() == FontResource.AA_LCD &&
+               FTFactory.LCD_SUPPORT;
+    }
 
-        boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
-                      FTFactory.LCD_SUPPORT;
+    /* Sets the face size and transform for the strike and returns the
+     * load flags used to render its glyphs.
+     */
+    private int setupStrike(FTFontStrike strike, boolean lcd) {
+        int size26dot6 = (int)(strike.getSize() * 64);
+        OSFreetype.FT_Set_Char_Size(face, 0, size26dot6, 72, 72);
 
         int flags = OSFreetype.FT_LOAD_RENDER | OSFreetype.FT_LOAD_NO_HINTING | OSFreetype.FT_LOAD_NO_BITMAP;
         FT_Matrix matrix = strike.matrix;
@@ -142,6 +152,87 @@ class FTFontFile extends PrismFontFile {
         } else {
             flags |= OSFreetype.FT_LOAD_TARGET_NORMAL;
         }
+        return flags;
+    }
+
+    /* Renders several glyphs of the same strike with a single native call.
+     * Glyphs which can not be rendered this way are left uninitialized and
+     * go through initGlyph() when they are first used.
+     */
+    synchronized void initGlyphs(FTGlyph[] glyphs, int count, FTFontStrike strike) {
+        if (strike.getSize() == 0) return;
+        boolean lcd = isLCD(strike);
+        int flags = setupStrike(strike, lcd);
+
+        int[] glyphCodes = new int[count];
+        for (int i = 0; i < count; i++) {
+            glyphCodes[i] = glyphs[i].getGlyphCode();
+        }
+        int recordSize = OSFreetype.GLYPH_RECORD_SIZE;
+        if (batchRecords == null || batchRecords.length < count * recordSize) {
+            batchRecords = new int[count * recordSize];
+        }
+
+        int start = 0;
+        while (start < count) {
+            if (maskPage == null) {
+                maskPage = ByteBuffer.allocateDirect(MASK_PAGE_SIZE);
+                maskPageOffset = 0;
+            }
+            int done = OSFreetype.renderGlyphs(face, flags, glyphCodes, start,
+                                               count - start, maskPage,
+                                               maskPageOffset, batchRecords);
+            if (done <= 0) {
+                if (maskPageOffset == 0) {
+                    /* The glyph does not fit in a page, leave it to initGlyph() */
+                    start++;
+                } else {
+                    maskPage = null;
+                }
+                continue;
+            }
+            for (int i = 0; i < done; i++) {
+                int rec = i * recordSize;
+                int offset = batchRecords[rec + OSFreetype.GLYPH_OFFSET];
+                if (offset < 0) continue;
+                FT_Bitmap bitmap = new FT_Bitmap();
+                bitmap.width = batchRecords[rec + OSFreetype.GLYPH_WIDTH];
+                bitmap.rows = batchRecords[rec + OSFreetype.GLYPH_ROWS];
+                bitmap.pitch = bitmap.width;
+                bitmap.pixel_mode = (byte)batchRecords[rec + OSFreetype.GLYPH_PIXEL_MODE];
+                int size = bitmap.width * bitmap.rows;
+
+                FTGlyph glyph = glyphs[start + i];
+                if (size > 0) {
+                    maskPage.limit(offset + size);
+                    maskPage.position(offset);
+                    glyph.pixels = maskPage.slice();
+                    maskPage.clear();
+                    maskPageOffset = offset + size;
+                } else {
+                    glyph.buffer = new byte[0];
+                }
+                glyph.bitmap = bitmap;
+                glyph.bitmap_left = batchRecords[rec + OSFreetype.GLYPH_LEFT];
+                glyph.bitmap_top = batchRecords[rec + OSFreetype.GLYPH_TOP];
+                glyph.advanceX = batchRecords[rec + OSFreetype.GLYPH_ADVANCE_X] / 64f;
+                glyph.advanceY = batchRecords[rec + OSFreetype.GLYPH_ADVANCE_Y] / 64f;
+                glyph.userAdvance = batchRecords[rec + OSFreetype.GLYPH_LINEAR_ADVANCE] / 65536.0f;
+                glyph.lcd = lcd;
+            }
+            start += done;
+        }
+    }
+
+    synchronized void initGlyph(FTGlyph glyph, FTFontStrike strike) {
+        float size = strike.getSize();
+        if (size == 0) {
+            glyph.buffer = new byte[0];
+            glyph.bitmap = new FT_Bitmap();
+            return;
+        }
+        boolean lcd = isLCD(strike);
+        int flags = setupStrike(strike, lcd);
 
         int glyphCode = glyph.getGlyphCode();
         int error = OSFreetype.FT_Load_Glyph(face, glyphCode, flags);
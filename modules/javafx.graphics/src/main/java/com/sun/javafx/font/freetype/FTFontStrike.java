@@ -32,6 +32,8 @@ import com.sun.javafx.font.PrismFontFactory;
 import com.sun.javafx.font.PrismFontStrike;
 import com.sun.javafx.geom.Path2D;
 import com.sun.javafx.geom.transform.BaseTransform;
+import java.util.LinkedHashSet;
+import java.util.Set;
 
 class FTFontStrike extends PrismFontStrike<FTFontFile> {
     FT_Matrix matrix;
@@ -83,4 +85,21 @@ class FTFontStrike extends PrismFontStrike<FTFontFile> {
         fontResource.initGlyph(glyph, this);
     }
 
+    @Override
+    public void prepareGlyphs(int[] glyphCodes, int count) {
+        if (drawShapes || count < 2) return;
+        /* A glyph can appear several times in the list */
+        Set<FTGlyph> pending = new LinkedHashSet<>();
+        for (int i = 0; i < count; i++) {
+            FTGlyph glyph = (FTGlyph)getGlyph(glyphCodes[i]);
+            if (glyph.bitmap == null) {
+                pending.add(glyph);
+            }
+        }
+        if (pending.size() > 1) {
+            FTGlyph[] glyphs = pending.toArray(new FTGlyph[pending.size()]);
+            getFontResource().initGlyphs(glyphs, glyphs.length, this);
+        }
+    }
+
 }
@@ -28,11 +28,13 @@ package com.sun.javafx.font.freetype;
 import com.sun.javafx.font.Glyph;
 import com.sun.javafx.geom.RectBounds;
 import com.sun.javafx.geom.Shape;
+import java.nio.ByteBuffer;
 
 class FTGlyph implements Glyph {
     FTFontStrike strike;
     int glyphCode;
     byte[] buffer;
+    ByteBuffer pixels; /* mask rendered by FTFontFile.initGlyphs() */
     FT_Bitmap bitmap;
     int bitmap_left;
     int bitmap_top;
@@ -78,13 +80,26 @@ class FTGlyph implements Glyph {
     @Override
     public byte[] getPixelData() {
         init();
+        if (buffer == null && pixels != null) {
+            byte[] data = new byte[pixels.capacity()];
+            pixels.duplicate().get(data);
+            buffer = data;
+        }
         return buffer;
     }
 
     @Override
     public byte[] getPixelData(int subPixel) {
+        return getPixelData();
+    }
+
+    @Override
+    public ByteBuffer getPixelBuffer(int subPixel) {
         init();
-        return buffer;
+        if (pixels != null) {
+            return pixels.duplicate();
+        }
+        return buffer != null ? ByteBuffer.wrap(buffer) : null;
     }
 
     @Override
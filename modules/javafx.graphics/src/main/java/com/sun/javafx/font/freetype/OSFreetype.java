@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import com.sun.glass.utils.NativeLibLoader;
@@ -94,6 +95,18 @@ class OSFreetype {
     static final int FT_LCD_FILTER_LIGHT   = 2;
     static final int FT_LCD_FILTER_LEGACY  = 16;
 
+    /* Per glyph record written by renderGlyphs() */
+    static final int GLYPH_OFFSET         = 0;
+    static final int GLYPH_WIDTH          = 1;
+    static final int GLYPH_ROWS           = 2;
+    static final int GLYPH_PIXEL_MODE     = 3;
+    static final int GLYPH_LEFT           = 4;
+    static final int GLYPH_TOP            = 5;
+    static final int GLYPH_ADVANCE_X      = 6;
+    static final int GLYPH_ADVANCE_Y      = 7;
+    static final int GLYPH_LINEAR_ADVANCE = 8;
+    static final int GLYPH_RECORD_SIZE    = 9;
+
     static final int FT_LOAD_TARGET_MODE(int x) {
         return (x >> 16 ) & 15;
     }
@@ -111,6 +124,18 @@ class OSFreetype {
     static final native void FT_Set_Transform(long face, FT_Matrix matrix, long delta_x, long delta_y);
     static final native FT_GlyphSlotRec getGlyphSlot(long face);
     static final native byte[] getBitmapData(long face);
+    /**
+     * Loads and renders glyphCodes[start] to glyphCodes[start + count - 1],
+     * packing their bitmaps without row padding into the direct buffer from
+     * offset on and writing GLYPH_RECORD_SIZE ints per glyph into records.
+     * Glyphs that fail to load or render to an unexpected pixel mode get a
+     * GLYPH_OFFSET of -1. Returns the number of glyphs processed, which is
+     * less than count when the buffer is full.
+     */
+    static final native int renderGlyphs(long face, int load_flags,
+                                         int[] glyphCodes, int start, int count,
+                                         ByteBuffer buffer, int offset,
+                                         int[] records);
     static final native boolean isPangoEnabled();
     static final native boolean isHarfbuzzEnabled();
 }
@@ -57,6 +57,16 @@ class OSPango {
     static final int PANGO_WEIGHT_NORMAL = 0x190;
     static final int PANGO_DIRECTION_RTL = 1;
 
+    /* Layout of the array returned by pango_shape(). The header is followed
+     * by the glyphs, the widths and the char index of the cluster of each
+     * glyph, num_glyphs entries each.
+     */
+    static final int SHAPE_NUM_GLYPHS = 0;
+    static final int SHAPE_NUM_CHARS = 1;
+    static final int SHAPE_FONT_LO = 2;
+    static final int SHAPE_FONT_HI = 3;
+    static final int SHAPE_HEADER_SIZE = 4;
+
     static final native void pango_context_set_base_dir(long context, int direction);
     static final native long pango_ft2_font_map_new();
     static final native long pango_font_map_create_context(long fontmap);
@@ -78,7 +88,7 @@ class OSPango {
     static final native void pango_attr_list_unref(long list);
     static final native void pango_attr_list_insert(long list, long attr);
     static final native long pango_itemize(long context, long text, int start_index, int length, long attrs, long cached_iter);
-    static final native PangoGlyphString pango_shape(long text, long pangoItem);
+    static final native int[] pango_shape(long text, long pangoItem);
     static final native void pango_item_free(long item);
 
     /* Miscellaneous (glib, fontconfig) */
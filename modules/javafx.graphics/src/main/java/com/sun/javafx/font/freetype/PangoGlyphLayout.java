@@ -45,9 +45,8 @@ class PangoGlyphLayout extends GlyphLayout {
         fontmap = OSPango.pango_ft2_font_map_new();
     }
 
-    private int getSlot(PGFont font, PangoGlyphString glyphString) {
+    private int getSlot(PGFont font, long fallbackFont) {
         CompositeFontResource fr = (CompositeFontResource)font.getFontResource();
-        long fallbackFont = glyphString.font;
         long fallbackFd = OSPango.pango_font_describe(fallbackFont);
         String fallbackFamily = OSPango.pango_font_description_get_family(fallbackFd);
         int fallbackStyle = OSPango.pango_font_description_get_style(fallbackFd);
@@ -145,9 +144,9 @@ class PangoGlyphLayout extends GlyphLayout {
         long runs = OSPango.pango_itemize(context, str, 0, (int)(end - str), attrList, 0);
 
         if (runs != 0) {
-            /* Shape all PangoItem into PangoGlyphString */
+            /* Shape all PangoItem, see OSPango.SHAPE_HEADER_SIZE for the layout */
             int runsCount = OSPango.g_list_length(runs);
-            PangoGlyphString[] pangoGlyphs = new PangoGlyphString[runsCount];
+            int[][] pangoGlyphs = new int[runsCount][];
             for (int i = 0; i < runsCount; i++) {
                 long pangoItem = OSPango.g_list_nth_data(runs, i);
                 if (pangoItem != 0) {
@@ -158,9 +157,9 @@ class PangoGlyphLayout extends GlyphLayout {
             OSPango.g_list_free(runs);
 
             int glyphCount = 0;
-            for (PangoGlyphString g : pangoGlyphs) {
+            for (int[] g : pangoGlyphs) {
                 if (g != null) {
-                    glyphCount += g.num_glyphs;
+                    glyphCount += g[OSPango.SHAPE_NUM_GLYPHS];
                 }
             }
             int[] glyphs = new int[glyphCount];
@@ -169,14 +168,24 @@ class PangoGlyphLayout extends GlyphLayout {
             int gi = 0;
             int ci = rtl ? run.getLength() : 0;
             int width = 0;
-            for (PangoGlyphString g : pangoGlyphs) {
+            for (int[] g : pangoGlyphs) {
                 if (g != null) {
-                    int slot = composite ? getSlot(font, g) : 0;
-                    if (rtl) ci -= g.num_chars;
-                    for (int i = 0; i < g.num_glyphs; i++) {
+                    int numGlyphs = g[OSPango.SHAPE_NUM_GLYPHS];
+                    int numChars = g[OSPango.SHAPE_NUM_CHARS];
+                    int glyphStart = OSPango.SHAPE_HEADER_SIZE;
+                    int widthStart = glyphStart + numGlyphs;
+                    int clusterStart = widthStart + numGlyphs;
+                    int slot = 0;
+                    if (composite) {
+                        long fallbackFont = ((long)g[OSPango.SHAPE_FONT_HI] << 32) |
+                                            (g[OSPango.SHAPE_FONT_LO] & 0xFFFFFFFFL);
+                        slot = getSlot(font, fallbackFont);
+                    }
+                    if (rtl) ci -= numChars;
+                    for (int i = 0; i < numGlyphs; i++) {
                         int gii = gi + i;
                         if (slot != -1) {
-                            int gg = g.glyphs[i];
+                            int gg = g[glyphStart + i];
 
                             /* Ignoring any glyphs outside the GLYPHMASK range.
                              * Note that Pango uses PANGO_GLYPH_EMPTY (0x0FFFFFFF), PANGO_GLYPH_INVALID_INPUT (0xFFFFFFFF),
@@ -187,13 +196,13 @@ class PangoGlyphLayout extends GlyphLayout {
                             }
                         }
                         if (size != 0) {
-                            width += g.widths[i];
+                            width += g[widthStart + i];
                             pos[2 + (gii << 1)] = ((float)width) / OSPango.PANGO_SCALE;
                         }
-                        indices[gii] = g.log_clusters[i] + ci;
+                        indices[gii] = g[clusterStart + i] + ci;
                     }
-                    if (!rtl) ci += g.num_chars;
-                    gi += g.num_glyphs;
+                    if (!rtl) ci += numChars;
+                    gi += numGlyphs;
                 }
             }
             run.shape(glyphCount, glyphs, pos, indices);
@@ -175,7 +175,8 @@ public class GIFImageLoader2 extends ImageLoaderImpl {
                 iPos += ax;
                 pos += ax;
                 if ((xr -= ax) == 0) {
-                    if (++y == h) { // image is full
+                    updateImageProgress(100.0F * ++y / h);
+                    if (y == h) { // image is full
                         dec.waitForTerminator();
                         return;
                     }
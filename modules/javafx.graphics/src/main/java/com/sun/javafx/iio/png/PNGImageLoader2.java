@@ -29,10 +29,13 @@
  */
 package com.sun.javafx.iio.png;
 
+import com.sun.glass.utils.NativeLibLoader;
 import com.sun.javafx.iio.*;
 import com.sun.javafx.iio.common.*;
 import java.io.*;
 import java.nio.ByteBuffer;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
 import java.util.Arrays;
 import java.util.zip.*;
 
@@ -73,6 +76,30 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
     // Palette data : r,g,b,[a]  -  alpha optional
     private byte palette[][];
 
+    // rows decoded so far and in total, over all interlace passes
+    private int decodedRows, totalRows;
+
+    // the default InflaterInputStream buffer is only 512 bytes
+    private static final int INFLATE_BUFFER_SIZE = 16 * 1024;
+
+    // scanlines are unfiltered by javafx_iio when it is available
+    private static final boolean nativeUnfilter;
+
+    private static native void unfilterRow(byte line[], byte pline[], int fType, int bpp);
+
+    static {
+        @SuppressWarnings("removal")
+        boolean loaded = AccessController.doPrivileged((PrivilegedAction<Boolean>) () -> {
+            try {
+                NativeLibLoader.loadLibrary("javafx_iio");
+                return true;
+            } catch (UnsatisfiedLinkError e) {
+                return false;
+            }
+        });
+        nativeUnfilter = loaded;
+    }
+
     public PNGImageLoader2(InputStream input) throws IOException {
         super(PNGDescriptor.getInstance());
         stream = new DataInputStream(input);
@@ -312,7 +339,10 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
                         ? ImageStorage.ImageType.RGBA
                         : ImageStorage.ImageType.RGB;
             case PNG_COLOR_PALETTE:
-                return ImageStorage.ImageType.PALETTE;
+                // the palette is expanded while the scanlines are decoded
+                return tRNS_present
+                        ? ImageStorage.ImageType.RGBA
+                        : ImageStorage.ImageType.RGB;
             case PNG_COLOR_GRAY_ALPHA:
                 return ImageStorage.ImageType.GRAY_ALPHA;
             case PNG_COLOR_RGB_ALPHA:
@@ -367,6 +397,12 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
     }
 
     private void doFilter(byte line[], byte pline[], int fType, int bpp) {
+        if (nativeUnfilter) {
+            if (fType != PNG_FILTER_NONE) {
+                unfilterRow(line, pline, fType, bpp);
+            }
+            return;
+        }
         switch (fType) {
             case PNG_FILTER_SUB:
                 doSubFilter(line, bpp);
@@ -470,14 +506,15 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
         }
     }
 
-    private void upsampleTo8Palette(byte line[], byte image[], int pos, int w, int step) {
+    // unpacks the 1, 2 or 4 bit palette indices of a line, one per byte
+    private void unpackPaletteIndices(byte line[], byte indices[], int w) {
         int samplesInByte = 8 / bitDepth;
         int maxV = (1 << bitDepth) - 1;
         for (int i = 0, k = 0; i < w; k++, i += samplesInByte) {
             int p = (w - i < samplesInByte) ? w - i : samplesInByte;
             int in = line[k] >> (samplesInByte - p) * bitDepth;
             for (int pp = p - 1; pp >= 0; --pp) {
-                image[pos + (i + pp) * step] = (byte) (in & maxV);
+                indices[i + pp] = (byte) (in & maxV);
                 in >>= bitDepth;
             }
         }
@@ -512,16 +549,47 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
         }
     }
 
+    // palette lines are unpacked by unpackPaletteIndices instead
     private void upsampleTo8(byte line[], byte image[], int pos, int w, int step, int bpp) {
-        if (colorType == PNG_COLOR_PALETTE) { // as is decoder
-            upsampleTo8Palette(line, image, pos, w, step);
-        } else if (bpp == 1) {
+        if (bpp == 1) {
             upsampleTo8Gray(line, image, pos, w, step);
         } else if (tRNS_GRAY_RGB && bpp == 2) {
             upsampleTo8GrayTrns(line, image, pos, w, step);
         }
     }
 
+    private void expandPalette(byte indices[], byte image[], int pos, int w, int step, int bpp) {
+        byte r[] = palette[0], g[] = palette[1], b[] = palette[2];
+        int stepBpp = step * bpp;
+        if (bpp == 4) {
+            byte a[] = palette[3];
+            for (int i = 0, oPos = pos; i != w; oPos += stepBpp, ++i) {
+                int index = indices[i] & 0xFF;
+                image[oPos + 0] = r[index];
+                image[oPos + 1] = g[index];
+                image[oPos + 2] = b[index];
+                image[oPos + 3] = a[index];
+            }
+        } else {
+            for (int i = 0, oPos = pos; i != w; oPos += stepBpp, ++i) {
+                int index = indices[i] & 0xFF;
+                image[oPos + 0] = r[index];
+                image[oPos + 1] = g[index];
+                image[oPos + 2] = b[index];
+            }
+        }
+    }
+
+    private static void readFully(InputStream data, byte line[]) throws IOException {
+        for (int pos = 0, l = line.length; pos != l;) {
+            int n = data.read(line, pos, l - pos);
+            if (n < 0) {
+                throw new EOFException();
+            }
+            pos += n;
+        }
+    }
+
     private static final int starting_y[] = {0, 0, 4, 0, 2, 0, 1, 0};
     private static final int starting_x[] = {0, 4, 0, 2, 0, 1, 0, 0};
     private static final int increment_y[] = {8, 8, 8, 4, 4, 2, 2, 1};
@@ -543,6 +611,8 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
         int scanLineSize = (mipWidth * bitDepth * numBandsPerColorType[colorType] + 7) / 8;
         byte scanLine0[] = new byte[scanLineSize];
         byte scanLine1[] = new byte[scanLineSize];
+        boolean isPalette = colorType == PNG_COLOR_PALETTE;
+        byte indexLine[] = (isPalette && bitDepth < 8) ? new byte[mipWidth] : null;
 
         // numBands might be more than numBandsPerColorType[colorType]
         // to support tRNS
@@ -554,16 +624,21 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
                 throw new EOFException();
             }
 
-            if (data.read(scanLine0) != scanLineSize) {
-                throw new EOFException();
-            }
+            readFully(data, scanLine0);
 
             doFilter(scanLine0, scanLine1, filterByte, srcBpp);
 
             int pos = (mipPos(y, mip, starting_y, increment_y) * width + starting_x[mip]) * resultBpp;
             int step = increment_x[mip];
 
-            if (bitDepth == 16) {
+            if (isPalette) {
+                if (indexLine != null) {
+                    unpackPaletteIndices(scanLine0, indexLine, mipWidth);
+                    expandPalette(indexLine, image, pos, mipWidth, step, resultBpp);
+                } else {
+                    expandPalette(scanLine0, image, pos, mipWidth, step, resultBpp);
+                }
+            } else if (bitDepth == 16) {
                 downsample16to8(scanLine0, image, pos, step, resultBpp);
             } else if (bitDepth < 8) {
                 upsampleTo8(scanLine0, image, pos, mipWidth, step, resultBpp);
@@ -574,60 +649,39 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
             byte scanLineSwp[] = scanLine0;
             scanLine0 = scanLine1;
             scanLine1 = scanLineSwp;
+
+            updateImageProgress(100.0F * ++decodedRows / totalRows);
         }
     }
 
     private void load(byte image[], InputStream data) throws IOException {
+        decodedRows = 0;
         if (isInterlaced) {
+            totalRows = 0;
+            for (int mip = 0; mip != 7; ++mip) {
+                if (width > starting_x[mip] && height > starting_y[mip]) {
+                    totalRows += mipSize(height, mip, starting_y, increment_y);
+                }
+            }
             for (int mip = 0; mip != 7; ++mip) {
                 if (width > starting_x[mip] && height > starting_y[mip]) {
                     loadMip(image, data, mip);
                 }
             }
         } else {
+            totalRows = height;
             loadMip(image, data, 7);
         }
     }
 
-    private ImageFrame decodePalette(byte srcImage[], ImageMetadata metadata) throws IOException {
-        int bpp = tRNS_present ? 4 : 3;
-        if (width >= (Integer.MAX_VALUE / height / bpp)) {
-            throw new IOException("Bad PNG image size!");
-        }
-        byte newImage[] = new byte[width * height * bpp];
-        int l = width * height;
-
-        if (tRNS_present) {
-            for (int i = 0, j = 0; i != l; j += 4, i++) {
-                int index = 0xFF & srcImage[i];
-                newImage[j + 0] = palette[0][index];
-                newImage[j + 1] = palette[1][index];
-                newImage[j + 2] = palette[2][index];
-                newImage[j + 3] = palette[3][index];
-            }
-        } else {
-            for (int i = 0, j = 0; i != l; j += 3, i++) {
-                int index = 0xFF & srcImage[i];
-                newImage[j + 0] = palette[0][index];
-                newImage[j + 1] = palette[1][index];
-                newImage[j + 2] = palette[2][index];
-            }
-        }
-
-        ImageStorage.ImageType type = tRNS_present
-                ? ImageStorage.ImageType.RGBA
-                : ImageStorage.ImageType.RGB;
-
-        return new ImageFrame(type, ByteBuffer.wrap(newImage), width, height,
-                width * bpp, null, metadata);
-    }
-
-    // we won`t decode palette on fly, we will do it later
-    // it is possible that we might want original paletteized image
+    // palette images are expanded to RGB or RGBA while decoding
     // ImageFrame does not support 16 bit color depth,
     // numBandsPerColorType == bytesPerColorType
     // but we will convert RGB->RGBA and L->LA on order to support tRNS
     private int bpp() {
+        if (colorType == PNG_COLOR_PALETTE) {
+            return tRNS_present ? 4 : 3;
+        }
         return numBandsPerColorType[colorType] + (tRNS_GRAY_RGB ? 1 : 0);
     }
 
@@ -649,6 +703,10 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
             return null;
         }
 
+        if (colorType == PNG_COLOR_PALETTE && palette == null) {
+            throw new IOException("Missing PLTE chunk in PNG");
+        }
+
         int bpp = bpp();
         if (width >= (Integer.MAX_VALUE / height / bpp)) {
             throw new IOException("Bad PNG image size!");
@@ -666,7 +724,8 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
 
         PNGIDATChunkInputStream iDat = new PNGIDATChunkInputStream(stream, dataSize);
         Inflater inf = new Inflater();
-        InputStream data = new BufferedInputStream(new InflaterInputStream(iDat, inf));
+        InputStream data = new BufferedInputStream(
+                new InflaterInputStream(iDat, inf, INFLATE_BUFFER_SIZE), INFLATE_BUFFER_SIZE);
 
         try {
             load(bb.array(), data);
@@ -678,9 +737,8 @@ public final class PNGImageLoader2 extends ImageLoaderImpl {
             }
         }
 
-        ImageFrame imgPNG = colorType == PNG_COLOR_PALETTE
-                ? decodePalette(bb.array(), metaData)
-                : new ImageFrame(getType(), bb, width, height, bpp * width, palette, metaData);
+        ImageFrame imgPNG = new ImageFrame(getType(), bb, width, height, bpp * width,
+                colorType == PNG_COLOR_PALETTE ? null : palette, metaData);
 
         if (width != rWidth || height != rHeight) {
             imgPNG = ImageTools.scaleImageFrame(imgPNG, rWidth, rHeight, smooth);
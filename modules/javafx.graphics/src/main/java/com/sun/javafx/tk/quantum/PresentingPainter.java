@@ -25,6 +25,7 @@
 
 package com.sun.javafx.tk.quantum;
 
+import com.sun.javafx.geom.Rectangle;
 import com.sun.javafx.logging.PulseLogger;
 import static com.sun.javafx.logging.PulseLogger.PULSE_LOGGING_ENABLED;
 import com.sun.prism.Graphics;
@@ -88,15 +89,17 @@ final class PresentingPainter extends ViewPainter {
                 Graphics g = presentable.createGraphics();
 
                 ViewScene vs = (ViewScene) sceneState.getScene();
+                Rectangle damage = null;
                 if (g != null) {
                     paintImpl(g);
                     freshBackBuffer = false;
+                    damage = getPaintedRegion();
                 }
 
                 if (PULSE_LOGGING_ENABLED) {
                     PulseLogger.newPhase("Presenting");
                 }
-                if (!presentable.prepare(null)) {
+                if (!presentable.prepare(damage)) {
                     disposePresentable();
                     sceneState.getScene().entireSceneNeedsRepaint();
                     return;
@@ -45,8 +45,12 @@ import java.security.AccessController;
 import java.security.PrivilegedAction;
 import java.security.PrivilegedActionException;
 import java.security.PrivilegedExceptionAction;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.Objects;
 import java.util.concurrent.ExecutorService;
-import java.util.concurrent.Executors;
+import java.util.concurrent.LinkedBlockingQueue;
 import java.util.concurrent.ThreadFactory;
 import java.util.concurrent.ThreadPoolExecutor;
 import java.util.concurrent.TimeUnit;
@@ -77,6 +81,46 @@ class PrismImageLoader2 implements com.sun.javafx.tk.ImageLoader {
         loadAll(stream, width, height, preserveRatio, smooth);
     }
 
+    /**
+     * Loads the image at the given URL, reusing a previously decoded image
+     * for the same URL and size if the decoded image cache is enabled.
+     */
+    static PrismImageLoader2 load(String url, double width, double height,
+                                  boolean preserveRatio, float pixelScale,
+                                  boolean smooth)
+    {
+        return load(DecodedImageCache.INSTANCE, url, width, height,
+                    preserveRatio, pixelScale, smooth);
+    }
+
+    static PrismImageLoader2 load(DecodedImageCache cache, String url,
+                                  double width, double height,
+                                  boolean preserveRatio, float pixelScale,
+                                  boolean smooth)
+    {
+        DecodedImageCache.Key key = cache.createKey(url, width, height,
+                preserveRatio, pixelScale, smooth, callerContext());
+        PrismImageLoader2 loader = cache.get(key);
+        if (loader == null) {
+            loader = new PrismImageLoader2(url, width, height, preserveRatio,
+                                           pixelScale, smooth);
+            cache.put(key, loader);
+        }
+        return loader;
+    }
+
+    /**
+     * Returns the context whose permissions a load is made with, or null
+     * when there is no security manager and so nothing to check. Cached
+     * images are only shared between loads made with equal contexts, so a
+     * cache hit never hands out an image the caller could not have read.
+     */
+    @SuppressWarnings("removal")
+    private static AccessControlContext callerContext() {
+        return System.getSecurityManager() != null
+                ? AccessController.getContext() : null;
+    }
+
     public double getWidth() {
         return width;
     }
@@ -201,6 +245,122 @@ class PrismImageLoader2 implements com.sun.javafx.tk.ImageLoader {
         return imageioLogger;
     }
 
+    private long getByteSize() {
+        long size = 0;
+        for (Image image : images) {
+            size += (long) image.getScanlineStride() * image.getHeight();
+        }
+        return size;
+    }
+
+    /**
+     * A least recently used cache of decoded images, bounded by the number
+     * of pixel bytes it holds (prism.imagecachesize). The cached images are
+     * never modified after loading, so they can be shared by all callers.
+     */
+    static final class DecodedImageCache {
+        static final DecodedImageCache INSTANCE =
+                new DecodedImageCache(PrismSettings.imageCacheSize);
+
+        private final long maxSize;
+        private final Map<Key, PrismImageLoader2> cache =
+                new LinkedHashMap<>(16, 0.75f, true);
+        private long cacheSize;
+
+        DecodedImageCache(long maxSize) {
+            this.maxSize = maxSize;
+        }
+
+        static final class Key {
+            private final String url;
+            private final double width, height;
+            private final boolean preserveRatio;
+            private final float pixelScale;
+            private final boolean smooth;
+            @SuppressWarnings("removal")
+            private final AccessControlContext acc;
+
+            @SuppressWarnings("removal")
+            Key(String url, double width, double height,
+                boolean preserveRatio, float pixelScale, boolean smooth,
+                AccessControlContext acc)
+            {
+                this.url = url;
+                this.width = width;
+                this.height = height;
+                this.preserveRatio = preserveRatio;
+                this.pixelScale = pixelScale;
+                this.smooth = smooth;
+                this.acc = acc;
+            }
+
+            @Override
+            public boolean equals(Object obj) {
+                if (!(obj instanceof Key)) {
+                    return false;
+                }
+                Key other = (Key) obj;
+                return url.equals(other.url)
+                        && width == other.width && height == other.height
+                        && preserveRatio == other.preserveRatio
+                        && pixelScale == other.pixelScale
+                        && smooth == other.smooth
+                        && Objects.equals(acc, other.acc);
+            }
+
+            @Override
+            public int hashCode() {
+                return Objects.hash(url, width, height, preserveRatio,
+                                    pixelScale, smooth, acc);
+            }
+        }
+
+        boolean isEnabled() {
+            return maxSize > 0;
+        }
+
+        @SuppressWarnings("removal")
+        Key createKey(String url, double width, double height,
+                      boolean preserveRatio, float pixelScale,
+                      boolean smooth, AccessControlContext acc)
+        {
+            if (!isEnabled() || url == null) {
+                return null;
+            }
+            return new Key(url, width, height, preserveRatio, pixelScale,
+                           smooth, acc);
+        }
+
+        synchronized PrismImageLoader2 get(Key key) {
+            return key == null ? null : cache.get(key);
+        }
+
+        synchronized void put(Key key, PrismImageLoader2 loader) {
+            if (key == null || loader.images == null || loader.exception != null) {
+                return;
+            }
+            long size = loader.getByteSize();
+            if (size > maxSize) {
+                return;
+            }
+            PrismImageLoader2 old = cache.put(key, loader);
+            if (old != null) {
+                cacheSize -= old.getByteSize();
+            }
+            cacheSize += size;
+
+            Iterator<PrismImageLoader2> it = cache.values().iterator();
+            while (cacheSize > maxSize && it.hasNext()) {
+                cacheSize -= it.next().getByteSize();
+                it.remove();
+            }
+        }
+
+        synchronized long getSize() {
+            return cacheSize;
+        }
+    }
+
     private class PrismLoadListener implements ImageLoadListener {
         public void imageLoadWarning(ImageLoader loader, String message) {
             getImageioLogger().warning(message);
@@ -226,7 +386,11 @@ class PrismImageLoader2 implements com.sun.javafx.tk.ImageLoader {
         extends AbstractRemoteResource<PrismImageLoader2>
     {
         private static final ExecutorService BG_LOADING_EXECUTOR =
-                createExecutor();
+                createExecutor("Background image loading thread pool");
+        // Remote loads mostly wait for the network, so they get their own
+        // threads and cannot hold up the decoding of local images
+        private static final ExecutorService BG_NETWORK_EXECUTOR =
+                createExecutor("Background image network loading thread pool");
 
         @SuppressWarnings("removal")
         private final AccessControlContext acc;
@@ -257,9 +421,19 @@ class PrismImageLoader2 implements com.sun.javafx.tk.ImageLoader {
         @SuppressWarnings("removal")
         @Override
         public PrismImageLoader2 call() throws IOException {
+            DecodedImageCache cache = DecodedImageCache.INSTANCE;
+            DecodedImageCache.Key key = cache.createKey(url, width, height,
+                    preserveRatio, 1.0f, smooth,
+                    System.getSecurityManager() != null ? acc : null);
+            PrismImageLoader2 cached = cache.get(key);
+            if (cached != null) {
+                return cached;
+            }
             try {
-                return AccessController.doPrivileged(
+                PrismImageLoader2 loader = AccessController.doPrivileged(
                         (PrivilegedExceptionAction<PrismImageLoader2>) () -> AsyncImageLoader.super.call(), acc);
+                cache.put(key, loader);
+                return loader;
             } catch (final PrivilegedActionException e) {
                 final Throwable cause = e.getCause();
 
@@ -273,17 +447,26 @@ class PrismImageLoader2 implements com.sun.javafx.tk.ImageLoader {
 
         @Override
         public void start() {
-            BG_LOADING_EXECUTOR.execute(future);
+            if (isLocal(url)) {
+                BG_LOADING_EXECUTOR.execute(future);
+            } else {
+                BG_NETWORK_EXECUTOR.execute(future);
+            }
+        }
+
+        static boolean isLocal(String url) {
+            return url.startsWith("file:") || url.startsWith("jar:file:")
+                    || url.startsWith("jrt:") || url.startsWith("data:");
         }
 
-        private static ExecutorService createExecutor() {
+        private static ExecutorService createExecutor(String name) {
             @SuppressWarnings("removal")
             final ThreadGroup bgLoadingThreadGroup =
                     AccessController.doPrivileged(
                             (PrivilegedAction<ThreadGroup>) () -> new ThreadGroup(
                                 QuantumToolkit.getFxUserThread()
                                               .getThreadGroup(),
-                                "Background image loading thread pool")
+                                name)
                     );
 
             @SuppressWarnings("removal")
@@ -300,10 +483,16 @@ class PrismImageLoader2 implements com.sun.javafx.tk.ImageLoader {
                             }
                     );
 
-            final ExecutorService bgLoadingExecutor =
-                    Executors.newCachedThreadPool(bgLoadingThreadFactory);
-            ((ThreadPoolExecutor) bgLoadingExecutor).setKeepAliveTime(
-                                                         1, TimeUnit.SECONDS);
+            // Decode at most imageLoaderThreads images at a time, rather
+            // than starting one thread per image, which oversubscribes the
+            // cores when a whole gallery of images is loaded at once.
+            final ThreadPoolExecutor bgLoadingExecutor =
+                    new ThreadPoolExecutor(PrismSettings.imageLoaderThreads,
+                                           PrismSettings.imageLoaderThreads,
+                                           1, TimeUnit.SECONDS,
+                                           new LinkedBlockingQueue<>(),
+                                           bgLoadingThreadFactory);
+            bgLoadingExecutor.allowCoreThreadTimeOut(true);
 
             return bgLoadingExecutor;
         }
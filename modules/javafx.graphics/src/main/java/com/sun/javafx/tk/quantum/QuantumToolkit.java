@@ -781,7 +781,7 @@ public final class QuantumToolkit extends Toolkit {
     }
 
     @Override public ImageLoader loadImage(String url, double width, double height, boolean preserveRatio, boolean smooth) {
-        return new PrismImageLoader2(url, width, height, preserveRatio, getMaxRenderScale(), smooth);
+        return PrismImageLoader2.load(url, width, height, preserveRatio, getMaxRenderScale(), smooth);
     }
 
     @Override public ImageLoader loadImage(InputStream stream, double width, double height,
@@ -1501,24 +1501,91 @@ public final class QuantumToolkit extends Toolkit {
 
             }
 
+            // The previous tile while its pixels are read back asynchronously,
+            // so that the GPU can render the next tile in the meantime.
+            private RTTexture pendingRT;
+            private long pendingReadback;
+            private IntBuffer pendingBuffer;
+            private int pendingX, pendingXOffset, pendingY, pendingYOffset, pendingW, pendingH;
+            // The number of tiles still to be rendered. The last one is read
+            // back synchronously since there is nothing left to overlap with.
+            private int tilesLeft;
+
+            private void finishPendingTile(IntBuffer[] buffers, ResourceFactory rf,
+                                           QuantumImage tileImg, QuantumImage targetImg) {
+                if (pendingReadback == 0L) {
+                    return;
+                }
+                long readback = pendingReadback;
+                RTTexture rt = pendingRT;
+                IntBuffer buffer = pendingBuffer;
+                pendingReadback = 0L;
+                pendingRT = null;
+                pendingBuffer = null;
+                if (rt.finishReadPixels(readback, buffer)) {
+                    targetImg.image.setPixels(pendingXOffset, pendingYOffset, pendingW, pendingH,
+                            javafx.scene.image.PixelFormat.getIntArgbPreInstance(), buffer, pendingW);
+                } else {
+                    // The texture holds another tile by now, render this one again
+                    renderTile(pendingX, pendingXOffset, pendingY, pendingYOffset, pendingW, pendingH,
+                            buffers, rf, tileImg, targetImg, false);
+                }
+            }
+
+            private void disposePendingTile() {
+                if (pendingReadback != 0L) {
+                    pendingRT.disposeReadPixels(pendingReadback);
+                    pendingReadback = 0L;
+                }
+                pendingRT = null;
+                pendingBuffer = null;
+            }
+
+            private void renderTile(int x, int xOffset, int y, int yOffset, int w, int h,
+                                    IntBuffer[] buffers, ResourceFactory rf, QuantumImage tileImg, QuantumImage targetImg) {
+                renderTile(x, xOffset, y, yOffset, w, h, buffers, rf, tileImg, targetImg, --tilesLeft > 0);
+            }
+
             private void renderTile(int x, int xOffset, int y, int yOffset, int w, int h,
-                                    IntBuffer buffer, ResourceFactory rf, QuantumImage tileImg, QuantumImage targetImg) {
+                                    IntBuffer[] buffers, ResourceFactory rf, QuantumImage tileImg, QuantumImage targetImg,
+                                    boolean async) {
                 RTTexture rt = tileImg.getRT(w, h, rf);
                 if (rt == null) {
+                    finishPendingTile(buffers, rf, tileImg, targetImg);
                     return;
                 }
                 Graphics g = rt.createGraphics();
                 draw(g, x + xOffset, y + yOffset, w, h);
+                // Do not overwrite the buffer the pending tile is read into
+                IntBuffer buffer = buffers[0] == pendingBuffer ? buffers[1] : buffers[0];
                 int[] pixels = rt.getPixels();
                 if (pixels != null) {
                     buffer.put(pixels);
                 } else {
+                    long readback = async ?
+                            rt.readPixelsAsync(rt.getContentX(), rt.getContentY(), w, h) : 0L;
+                    if (readback != 0L) {
+                        rt.unlock();
+                        // The previous tile was read while this one was rendered
+                        finishPendingTile(buffers, rf, tileImg, targetImg);
+                        pendingRT = rt;
+                        pendingReadback = readback;
+                        pendingBuffer = buffer;
+                        pendingX = x;
+                        pendingXOffset = xOffset;
+                        pendingY = y;
+                        pendingYOffset = yOffset;
+                        pendingW = w;
+                        pendingH = h;
+                        return;
+                    }
                     rt.readPixels(buffer, rt.getContentX(), rt.getContentY(), w, h);
                 }
                 //Copy tile's pixels into the target image
                 targetImg.image.setPixels(xOffset, yOffset, w, h,
                         javafx.scene.image.PixelFormat.getIntArgbPreInstance(), buffer, w);
                 rt.unlock();
+                finishPendingTile(buffers, rf, tileImg, targetImg);
             }
 
             private void renderWholeImage(int x, int y, int w, int h, ResourceFactory rf, QuantumImage pImage) {
@@ -1610,7 +1677,15 @@ public final class QuantumToolkit extends Toolkit {
                         // +-----------+-----------+  .  +-------+
                         final int mTileWidth = computeTileSize(w, maxTextureSize);
                         final int mTileHeight = computeTileSize(h, maxTextureSize);
-                        IntBuffer buffer = IntBuffer.allocate(mTileWidth * mTileHeight);
+                        // Two buffers, so that one tile can be read back while the
+                        // previous one is copied into the target image
+                        IntBuffer[] buffer = {
+                            IntBuffer.allocate(mTileWidth * mTileHeight),
+                            IntBuffer.allocate(mTileWidth * mTileHeight)
+                        };
+                        final int rTileCount = w % mTileWidth > 0 ? 1 : 0;
+                        final int bTileCount = h % mTileHeight > 0 ? 1 : 0;
+                        tilesLeft = (w / mTileWidth + rTileCount) * (h / mTileHeight + bTileCount);
                         // Walk through all same-size "M" tiles
                         int mTileXOffset = 0;
                         int mTileYOffset = 0;
@@ -1654,6 +1729,7 @@ public final class QuantumToolkit extends Toolkit {
                     errored = true;
                     t.printStackTrace(System.err);
                 } finally {
+                    disposePendingTile();
                     if (tileRttCache != null) {
                         tileRttCache.dispose();
                     }
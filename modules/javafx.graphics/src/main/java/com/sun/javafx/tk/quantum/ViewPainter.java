@@ -100,6 +100,8 @@ abstract class ViewPainter implements Runnable {
     // are never initialized or used.
     private Rectangle dirtyRect;
     private RectBounds clip;
+    private Rectangle paintedRect;
+    private boolean paintedRectValid;
     private RectBounds dirtyRegionTemp;
     private DirtyRegionPool dirtyRegionPool;
     private DirtyRegionContainer dirtyRegionContainer;
@@ -136,6 +138,7 @@ abstract class ViewPainter implements Runnable {
             scaleTx = new Affine3D();
             clip = new RectBounds();
             dirtyRect = new Rectangle();
+            paintedRect = new Rectangle();
             dirtyRegionTemp = new RectBounds();
             dirtyRegionPool = new DirtyRegionPool(PrismSettings.dirtyRegionCount);
             dirtyRegionContainer = dirtyRegionPool.checkOut();
@@ -162,7 +165,18 @@ abstract class ViewPainter implements Runnable {
         }
     }
 
+    /**
+     * Returns the union, in device pixels, of the dirty regions that were
+     * rendered by the last call to {@link #paintImpl}, or null if the whole
+     * view was (or must be assumed to have been) repainted.
+     */
+    protected final Rectangle getPaintedRegion() {
+        return (paintedRectValid && !paintedRect.isEmpty()) ? paintedRect : null;
+    }
+
     protected void paintImpl(final Graphics backBufferGraphics) {
+        paintedRectValid = false;
+
         // We should not be painting anything with a width / height
         // that is <= 0, so we might as well bail right off.
         if (width <= 0 || height <= 0 || backBufferGraphics == null) {
@@ -259,6 +273,12 @@ abstract class ViewPainter implements Runnable {
         final int dirtyRegionSize = status == DirtyRegionContainer.DTR_OK ? dirtyRegionContainer.size() : 0;
 
         if (dirtyRegionSize > 0) {
+            // Track the union of the dirty regions so that presenters which
+            // copy pixels to the screen can limit the copy to what changed.
+            // The debug overlays below paint over the entire view.
+            paintedRectValid = !showDirtyOpts;
+            paintedRect.setBounds(0, 0, -1, -1);
+
             // We set this flag on Graphics so that subsequent code in the render paths of
             // NGNode know whether they ought to be paying attention to dirty region
             // culling bits.
@@ -318,6 +338,7 @@ abstract class ViewPainter implements Runnable {
                     dirtyRect.height = (int) Math.ceil (dirtyRegion.getMaxY() * pixelScaleY) - y0;
                     g.setClipRect(dirtyRect);
                     g.setClipRectIndex(i);
+                    paintedRect.add(dirtyRect);
                     doPaint(g, getRootPath(i));
                     getRootPath(i).clear();
                 }
@@ -31,5 +31,35 @@ public interface RTTexture extends Texture, RenderTarget {
     public int[] getPixels();
     public boolean readPixels(Buffer pixels);
     public boolean readPixels(Buffer pixels, int x, int y, int width, int height);
+
+    /**
+     * Starts reading back the given rectangle without waiting for the GPU.
+     * Returns a handle for {@link #finishReadPixels}, or 0 if the pipeline
+     * has no asynchronous readback, in which case readPixels must be used.
+     */
+    public default long readPixelsAsync(int x, int y, int width, int height) {
+        return 0L;
+    }
+
+    /**
+     * Returns true if finishReadPixels would not block for the given handle.
+     */
+    public default boolean isReadPixelsDone(long readback) {
+        return true;
+    }
+
+    /**
+     * Copies the pixels of a readback started by readPixelsAsync into the
+     * given buffer, waiting for the GPU if needed, and releases the handle.
+     */
+    public default boolean finishReadPixels(long readback, Buffer pixels) {
+        return false;
+    }
+
+    /**
+     * Releases a readback started by readPixelsAsync without reading it.
+     */
+    public default void disposeReadPixels(long readback) {}
+
     public boolean isVolatile();
 }
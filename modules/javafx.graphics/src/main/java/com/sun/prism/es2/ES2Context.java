@@ -40,10 +40,13 @@ import com.sun.prism.Material;
 import com.sun.prism.RTTexture;
 import com.sun.prism.RenderTarget;
 import com.sun.prism.Texture;
+import com.sun.prism.impl.BaseGraphics;
 import com.sun.prism.impl.PrismSettings;
 import com.sun.prism.impl.ps.BaseShaderContext;
 import com.sun.prism.ps.Shader;
 import com.sun.prism.ps.ShaderFactory;
+import java.nio.ByteBuffer;
+import java.nio.FloatBuffer;
 
 class ES2Context extends BaseShaderContext {
 
@@ -69,10 +72,23 @@ class ES2Context extends BaseShaderContext {
     private int indexBuffer = 0;
     private int shaderProgram;
 
+    // MeshViews that render alike apart from their transform are collected
+    // here while they are drawn back to back and issued as one instanced
+    // draw. The first view of the batch provides all other state.
+    private static final int MAX_MESH_INSTANCES = 256;
+    private final boolean meshInstancing;
+    private final float[] instanceMatrices =
+            new float[MAX_MESH_INSTANCES * GLContext.NUM_MATRIX_ELEMENTS];
+    private int numInstances;
+    private ES2MeshView batchMeshView;
+    private Graphics batchGraphics;
+    private ES2PhongMaterial batchMaterial;
+    private final Texture[] batchTextures = new Texture[ES2PhongMaterial.MAX_MAP_TYPE];
+
     public static final int NUM_QUADS = PrismSettings.superShader ? 4096 : 256;
 
     ES2Context(Screen screen, ShaderFactory factory) {
-        super(screen, factory, NUM_QUADS);
+        super(screen, factory, NUM_QUADS, PrismSettings.streamVertexBuffers);
         GLFactory glF = ES2Pipeline.glFactory;
 
         // NOTE: There is issue with the returned value of getNativeScreen.
@@ -87,6 +103,8 @@ class ES2Context extends BaseShaderContext {
                 glF.getShareContext(), PrismSettings.isVsyncEnabled);
         makeCurrent(dummyGLDrawable);
 
+        glContext.setStateCacheEnabled(PrismSettings.nativeStateCache);
+        meshInstancing = PrismSettings.meshInstancing && glContext.isInstancingSupported();
         glContext.enableVertexAttributes();
         quadIndices = genQuadsIndexBuffer(NUM_QUADS);
         setIndexBuffer(quadIndices);
@@ -388,17 +406,20 @@ class ES2Context extends BaseShaderContext {
 
     // TODO: 3D - Should this be called dispose?
     void releaseES2Mesh(long nativeHandle) {
+        flushMeshViewBatch(nativeHandle);
         glContext.releaseES2Mesh(nativeHandle);
     }
 
     boolean buildNativeGeometry(long nativeHandle, float[] vertexBuffer,
             int vertexBufferLength, short[] indexBuffer, int indexBufferLength) {
+        flushMeshViewBatch(nativeHandle);
         return glContext.buildNativeGeometry(nativeHandle, vertexBuffer,
                 vertexBufferLength, indexBuffer, indexBufferLength);
     }
 
     boolean buildNativeGeometry(long nativeHandle, float[] vertexBuffer,
             int vertexBufferLength, int[] indexBuffer, int indexBufferLength) {
+        flushMeshViewBatch(nativeHandle);
         return glContext.buildNativeGeometry(nativeHandle, vertexBuffer,
                 vertexBufferLength, indexBuffer, indexBufferLength);
     }
@@ -409,14 +430,17 @@ class ES2Context extends BaseShaderContext {
 
     // TODO: 3D - Should this be called dispose?
     void releaseES2PhongMaterial(long nativeHandle) {
+        flushMeshViewBatch(nativeHandle);
         glContext.releaseES2PhongMaterial(nativeHandle);
     }
 
     void setSolidColor(long nativeHandle, float r, float g, float b, float a) {
+        flushMeshViewBatch(nativeHandle);
         glContext.setSolidColor(nativeHandle, r, g, b, a);
     }
 
     void setMap(long nativeHandle, int mapType, int texID) {
+        flushMeshViewBatch(nativeHandle);
         glContext.setMap(nativeHandle, mapType, texID);
     }
 
@@ -426,32 +450,38 @@ class ES2Context extends BaseShaderContext {
 
     // TODO: 3D - Should this be called dispose?
     void releaseES2MeshView(long nativeHandle) {
+        flushMeshViewBatch(nativeHandle);
         glContext.releaseES2MeshView(nativeHandle);
     }
 
     void setCullingMode(long nativeHandle, int cullingMode) {
         // NOTE: Native code has set clockwise order as front-facing
+        flushMeshViewBatch(nativeHandle);
         glContext.setCullingMode(nativeHandle, cullingMode);
     }
 
     void setMaterial(long nativeHandle, Material material) {
         ES2PhongMaterial es2Material = (ES2PhongMaterial)material;
 
+        flushMeshViewBatch(nativeHandle);
         glContext.setMaterial(nativeHandle,
                 (es2Material).getNativeHandle());
     }
 
     void setWireframe(long nativeHandle, boolean wireframe) {
+       flushMeshViewBatch(nativeHandle);
        glContext.setWireframe(nativeHandle, wireframe);
     }
 
     void setAmbientLight(long nativeHandle, float r, float g, float b) {
+        flushMeshViewBatch(nativeHandle);
         glContext.setAmbientLight(nativeHandle, r, g, b);
     }
 
     void setLight(long nativeHandle, int index, float x, float y, float z, float r, float g, float b, float w,
             float ca, float la, float qa, float maxRange, float dirX, float dirY, float dirZ,
             float innerAngle, float outerAngle, float falloff) {
+        flushMeshViewBatch(nativeHandle);
         glContext.setLight(nativeHandle, index, x, y, z, r, g, b, w, ca, la, qa, maxRange, dirX, dirY, dirZ,
                 innerAngle, outerAngle, falloff);
     }
@@ -461,6 +491,7 @@ class ES2Context extends BaseShaderContext {
                      int srcX0, int srcY0, int srcX1, int srcY1,
                      int dstX0, int dstY0, int dstX1, int dstY1)
     {
+        flushMeshViewBatch();
         // If dstRTT is null then will blit to currently bound fbo
         int dstFboID = dstRTT == null ? 0 : ((ES2RTTexture)dstRTT).getFboID();
         int srcFboID = ((ES2RTTexture)srcRTT).getFboID();
@@ -470,8 +501,44 @@ class ES2Context extends BaseShaderContext {
     }
 
     void renderMeshView(long nativeHandle, Graphics g, ES2MeshView meshView) {
+        if (!meshInstancing) {
+            ES2PhongMaterial material = meshView.getMaterial();
+            material.lockTextureMaps();
+            ES2Shader shader = setupMeshView(g, meshView, false);
+            updateMeshViewWorldTransform(g);
+            shader.setMatrix("worldMatrix", rawMatrix);
+//            printRawMatrix("worldMatrix");
+            glContext.renderMeshView(nativeHandle);
+            material.unlockTextureMaps();
+            return;
+        }
 
-        ES2Shader shader = (ES2Shader) getPhongShader(meshView);
+        if (batchMeshView != null && (g != batchGraphics
+                || numInstances == MAX_MESH_INSTANCES
+                || !batchMeshView.canBatchWith(meshView)
+                || !isBatchMaterialCurrent())) {
+            flushMeshViewBatch();
+        }
+        if (batchMeshView == null) {
+            batchMaterial = meshView.getMaterial();
+            batchMaterial.lockTextureMaps();
+            for (int i = 0; i < batchTextures.length; i++) {
+                batchTextures[i] = batchMaterial.maps[i].getTexture();
+            }
+            setupMeshView(g, meshView, true);
+            batchMeshView = meshView;
+            batchGraphics = g;
+        }
+        updateMeshViewWorldTransform(g);
+        System.arraycopy(rawMatrix, 0, instanceMatrices,
+                numInstances * GLContext.NUM_MATRIX_ELEMENTS, GLContext.NUM_MATRIX_ELEMENTS);
+        numInstances++;
+    }
+
+    // Selects the phong shader of the mesh view and sets all of its
+    // constants except the world matrix, returns the shader
+    private ES2Shader setupMeshView(Graphics g, ES2MeshView meshView, boolean instanced) {
+        ES2Shader shader = ES2PhongShader.getShader(meshView, this, instanced);
         setShaderProgram(shader.getProgramObject());
 
         // Support retina display by scaling the projViewTx and pass it to the shader.
@@ -488,8 +555,16 @@ class ES2Context extends BaseShaderContext {
         shader.setConstant("camPos", (float) cameraPos.x,
                 (float) cameraPos.y, (float)cameraPos.z);
 
+        ES2PhongShader.setShaderParamaters(shader, meshView, this);
+        return shader;
+    }
+
+    // Computes the world matrix of the mesh view into rawMatrix
+    private void updateMeshViewWorldTransform(Graphics g) {
         // Undo the SwapChain scaling done in createGraphics() because 3D needs
         // this information in the shader (via projViewTx)
+        float pixelScaleFactorX = g.getPixelScaleFactorX();
+        float pixelScaleFactorY = g.getPixelScaleFactorY();
         BaseTransform xform = g.getTransformNoClone();
         if (pixelScaleFactorX != 1.0 || pixelScaleFactorY != 1.0) {
             scratchAffine3DTx.setToIdentity();
@@ -500,13 +575,63 @@ class ES2Context extends BaseShaderContext {
             updateWorldTransform(xform);
         }
         updateRawMatrix(worldTx);
+    }
 
-        shader.setMatrix("worldMatrix", rawMatrix);
-//        printRawMatrix("worldMatrix");
+    // The uniforms and textures of a batch are taken from its material when
+    // the batch starts, so the material must not have changed since
+    private boolean isBatchMaterialCurrent() {
+        for (int i = 0; i < batchTextures.length; i++) {
+            if (batchMaterial.maps[i].isDirty()
+                    || batchMaterial.maps[i].getTexture() != batchTextures[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        ES2PhongShader.setShaderParamaters(shader, meshView, this);
+    /**
+     * Draws the pending batch of mesh views, if any. Must be called before
+     * anything else is rendered or any state the batch relies on changes.
+     */
+    void flushMeshViewBatch() {
+        if (batchMeshView == null) {
+            return;
+        }
+        glContext.renderMeshViewInstanced(batchMeshView.getNativeHandle(),
+                instanceMatrices, numInstances);
+        for (int i = 0; i < batchTextures.length; i++) {
+            if (batchTextures[i] != null) {
+                batchTextures[i].unlock();
+                batchTextures[i] = null;
+            }
+        }
+        numInstances = 0;
+        batchMeshView = null;
+        batchGraphics = null;
+        batchMaterial = null;
+    }
+
+    // Flushes the pending batch if it uses the given mesh view, mesh or
+    // material, which is about to change or go away
+    private void flushMeshViewBatch(long nativeHandle) {
+        if (batchMeshView != null
+                && (nativeHandle == batchMeshView.getNativeHandle()
+                    || nativeHandle == batchMeshView.getMesh().getNativeHandle()
+                    || nativeHandle == batchMaterial.getNativeHandle())) {
+            flushMeshViewBatch();
+        }
+    }
+
+    @Override
+    public void flushVertexBuffer() {
+        flushMeshViewBatch();
+        super.flushVertexBuffer();
+    }
 
-        glContext.renderMeshView(nativeHandle);
+    @Override
+    public void validateClearOp(BaseGraphics g) {
+        flushMeshViewBatch();
+        super.validateClearOp(g);
     }
 
     @Override
@@ -514,6 +639,15 @@ class ES2Context extends BaseShaderContext {
         glContext.drawIndexedQuads(coordArray, colorArray, numVertices);
     }
 
+    @Override
+    protected void renderQuads(FloatBuffer coordBuffer, ByteBuffer colorBuffer, int numVertices) {
+        if (coordBuffer.isDirect()) {
+            glContext.drawIndexedQuads(coordBuffer, colorBuffer, numVertices);
+        } else {
+            super.renderQuads(coordBuffer, colorBuffer, numVertices);
+        }
+    }
+
     void printRawMatrix(String mesg) {
         System.err.println(mesg + " = ");
         for (int i = 0; i < 4; i++) {
@@ -60,4 +60,15 @@ class ES2Light {
     boolean isPointLight() {
         return falloff == 0 && outerAngle == 180;
     }
+
+    boolean isSameAs(ES2Light light) {
+        return light != null
+                && x == light.x && y == light.y && z == light.z
+                && r == light.r && g == light.g && b == light.b && w == light.w
+                && ca == light.ca && la == light.la && qa == light.qa
+                && maxRange == light.maxRange
+                && dirX == light.dirX && dirY == light.dirY && dirZ == light.dirZ
+                && innerAngle == light.innerAngle && outerAngle == light.outerAngle
+                && falloff == light.falloff;
+    }
 }
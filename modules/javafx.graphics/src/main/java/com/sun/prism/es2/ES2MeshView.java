@@ -41,6 +41,8 @@ class ES2MeshView extends BaseMeshView {
     private float ambientLightRed = 0;
     private float ambientLightBlue = 0;
     private float ambientLightGreen = 0;
+    private int cullingMode;
+    private boolean wireframe;
 
     // NOTE: We only support up to 3 point lights at the present
     private ES2Light[] lights = new ES2Light[3];
@@ -66,6 +68,7 @@ class ES2MeshView extends BaseMeshView {
 
     @Override
     public void setCullingMode(int cullingMode) {
+        this.cullingMode = cullingMode;
         context.setCullingMode(nativeHandle, cullingMode);
     }
 
@@ -77,6 +80,7 @@ class ES2MeshView extends BaseMeshView {
 
     @Override
     public void setWireframe(boolean wireframe) {
+        this.wireframe = wireframe;
         context.setWireframe(nativeHandle, wireframe);
     }
 
@@ -119,15 +123,46 @@ class ES2MeshView extends BaseMeshView {
 
     @Override
     public void render(Graphics g) {
-        material.lockTextureMaps();
+        // The context locks the texture maps for as long as it needs them,
+        // which may be past this call when the draw is batched
         context.renderMeshView(nativeHandle, g, this);
-        material.unlockTextureMaps();
     }
 
     ES2PhongMaterial getMaterial() {
         return material;
     }
 
+    ES2Mesh getMesh() {
+        return mesh;
+    }
+
+    long getNativeHandle() {
+        return nativeHandle;
+    }
+
+    /**
+     * Returns true if this mesh view renders exactly like the given one
+     * apart from its transform, so that both can be drawn in a single
+     * instanced draw call.
+     */
+    boolean canBatchWith(ES2MeshView meshView) {
+        if (meshView.mesh != mesh || meshView.material != material
+                || meshView.cullingMode != cullingMode
+                || meshView.wireframe != wireframe
+                || meshView.ambientLightRed != ambientLightRed
+                || meshView.ambientLightGreen != ambientLightGreen
+                || meshView.ambientLightBlue != ambientLightBlue) {
+            return false;
+        }
+        for (int i = 0; i < lights.length; i++) {
+            ES2Light light = lights[i];
+            if (light == null ? meshView.lights[i] != null : !light.isSameAs(meshView.lights[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     @Override
     public void dispose() {
         // TODO: 3D - Need a mechanism to "decRefCount" Mesh and Material
@@ -342,6 +342,38 @@ class ES2RTTexture extends ES2Texture<ES2RTTextureData>
                  getContentWidth(), getContentHeight());
     }
 
+    @Override
+    public long readPixelsAsync(int x, int y, int width, int height) {
+        context.flushVertexBuffer();
+        GLContext glContext = context.getGLContext();
+        int id = glContext.getBoundFBO();
+        int fboID = getFboID();
+        boolean changeBoundFBO = id != fboID;
+        if (changeBoundFBO) {
+            glContext.bindFBO(fboID);
+        }
+        long readback = glContext.readPixelsAsync(x, y, width, height);
+        if (changeBoundFBO) {
+            glContext.bindFBO(id);
+        }
+        return readback;
+    }
+
+    @Override
+    public boolean isReadPixelsDone(long readback) {
+        return context.getGLContext().isReadPixelsDone(readback);
+    }
+
+    @Override
+    public boolean finishReadPixels(long readback, Buffer pixels) {
+        return context.getGLContext().finishReadPixels(readback, pixels);
+    }
+
+    @Override
+    public void disposeReadPixels(long readback) {
+        context.getGLContext().disposeReadPixels(readback);
+    }
+
     @Override
     public int getFboID() {
         return resource.getResource().getFboID();
@@ -27,6 +27,7 @@ package com.sun.prism.es2;
 
 import java.nio.Buffer;
 import java.nio.ByteBuffer;
+import java.nio.FloatBuffer;
 import java.nio.IntBuffer;
 import com.sun.javafx.PlatformUtil;
 import com.sun.prism.MeshView;
@@ -115,10 +116,20 @@ abstract class GLContext {
     // Use by Uniform Matrix
     final static int NUM_MATRIX_ELEMENTS          = 16;
 
+    // Categories of GL calls elided by the native state cache, used as
+    // indices into the array filled in by getStateCacheCounters
+    final static int STATECACHE_TEXTURE           = 0;
+    final static int STATECACHE_PROGRAM           = 1;
+    final static int STATECACHE_BLEND             = 2;
+    final static int STATECACHE_UNIFORM           = 3;
+    final static int STATECACHE_SCISSOR           = 4;
+    final static int STATECACHE_NUM_COUNTERS      = 5;
+
     long nativeCtxInfo;
     private int maxTextureSize = -1;
     private Boolean nonPowTwoExtAvailable;
     private Boolean clampToZeroAvailable;
+    private Boolean instancingAvailable;
 
     // TODO : Consider moving these cached values to ES2Context.
     // track some other state here to avoid redundant state changes
@@ -137,7 +148,7 @@ abstract class GLContext {
     private static native void nActiveTexture(long nativeCtxInfo, int texUnit);
     private static native void nBindFBO(long nativeCtxInfo, int nativeFBOID);
     private static native void nBindTexture(long nativeCtxInfo, int texID);
-    private static native void nBlendFunc(int sFactor, int dFactor);
+    private static native void nBlendFunc(long nativeCtxInfo, int sFactor, int dFactor);
     private static native void nClearBuffers(long nativeCtxInfo,
             float red, float green, float blue, float alpha,
             boolean clearColor, boolean clearDepth, boolean ignoreScissor);
@@ -160,7 +171,7 @@ abstract class GLContext {
     private static native void nDisposeShaders(long nativeCtxInfo,
             int pID, int vID, int[] fID);
     private static native void nFinish();
-    private static native int nGenAndBindTexture();
+    private static native int nGenAndBindTexture(long nativeCtxInfo);
     private static native int nGetFBO();
     private static native int nGetIntParam(int pname);
     private static native int nGetMaxSampleSize();
@@ -171,6 +182,12 @@ abstract class GLContext {
             Buffer buffer, byte[] pixelArr, int x, int y, int w, int h);
     private static native boolean nReadPixelsInt(long nativeCtxInfo, int length,
             Buffer buffer, int[] pixelArr, int x, int y, int w, int h);
+    private static native long nReadPixelsAsync(long nativeCtxInfo, int x, int y,
+            int w, int h);
+    private static native boolean nIsReadPixelsDone(long nativeCtxInfo, long nativeReadback);
+    private static native boolean nFinishReadPixelsAsync(long nativeCtxInfo,
+            long nativeReadback, int length, Buffer buffer, Object pixelArr);
+    private static native void nDisposeReadPixelsAsync(long nativeCtxInfo, long nativeReadback);
     private static native void nScissorTest(long nativeCtxInfo, boolean enable,
             int x, int y, int w, int h);
     private static native void nSetDepthTest(long nativeCtxInfo, boolean depthTest);
@@ -219,11 +236,16 @@ abstract class GLContext {
     private static native void nUpdateWrapState(long nativeCtxInfo, int texID,
             int wrapMode);
     private static native void nUseProgram(long nativeCtxInfo, int pID);
+    private static native void nSetStateCacheEnabled(long nativeCtxInfo, boolean enabled);
+    private static native void nGetStateCacheCounters(long nativeCtxInfo, int[] counters,
+            boolean reset);
 
     private static native void nEnableVertexAttributes(long nativeCtxInfo);
     private static native void nDisableVertexAttributes(long nativeCtxInfo);
     private static native void nDrawIndexedQuads(long nativeCtxInfo, int numVertices,
             float dataf[], byte datab[]);
+    private static native void nDrawIndexedQuadsBuffered(long nativeCtxInfo, int numVertices,
+            FloatBuffer dataf, ByteBuffer datab);
     private static native int nCreateIndexBuffer16(long nativeCtxInfo, short data[], int n);
     private static native void nSetIndexBuffer(long nativeCtxInfo, int buffer);
 
@@ -255,6 +277,9 @@ abstract class GLContext {
             int index, float x, float y, float z, float r, float g, float b, float w, float ca, float la, float qa,
             float maxRange, float dirX, float dirY, float dirZ, float innerAngle, float outerAngle, float falloff);
     private static native void nRenderMeshView(long nativeCtxInfo, long nativeMeshViewInfo);
+    private static native boolean nIsInstancingSupported(long nativeCtxInfo);
+    private static native void nRenderMeshViewInstanced(long nativeCtxInfo,
+            long nativeMeshViewInfo, float[] worldMatrices, int numInstances);
     private static native void nBlit(long nativeCtxInfo, int srcFBO, int dstFBO,
             int srcX0, int srcY0, int srcX1, int srcY1,
             int dstX0, int dstY0, int dstX1, int dstY1);
@@ -286,7 +311,7 @@ abstract class GLContext {
     }
 
     void blendFunc(int sFactor, int dFactor) {
-        nBlendFunc(sFactor, dFactor);
+        nBlendFunc(nativeCtxInfo, sFactor, dFactor);
     }
 
     boolean canCreateNonPowTwoTextures() {
@@ -423,7 +448,7 @@ abstract class GLContext {
     }
 
     int genAndBindTexture() {
-        int texID = nGenAndBindTexture();
+        int texID = nGenAndBindTexture(nativeCtxInfo);
         boundTextures[activeTexUnit] = texID;
         return texID;
     }
@@ -555,6 +580,51 @@ abstract class GLContext {
         return res;
     }
 
+    /**
+     * Starts reading the given rectangle of the currently bound framebuffer
+     * into a pixel buffer object without waiting for the GPU. Returns a
+     * handle to be passed to {@link #finishReadPixels}, or 0 if asynchronous
+     * readback is not supported, in which case readPixels should be used.
+     */
+    long readPixelsAsync(int x, int y, int w, int h) {
+        return nReadPixelsAsync(nativeCtxInfo, x, y, w, h);
+    }
+
+    /**
+     * Returns true if the readback started by readPixelsAsync has completed
+     * on the GPU, so that finishReadPixels will not block.
+     */
+    boolean isReadPixelsDone(long readback) {
+        return nIsReadPixelsDone(nativeCtxInfo, readback);
+    }
+
+    /**
+     * Copies the pixels of a readback started by readPixelsAsync into the
+     * given buffer, waiting for the GPU if needed, and releases the handle.
+     */
+    boolean finishReadPixels(long readback, Buffer buffer) {
+        if (buffer instanceof ByteBuffer) {
+            ByteBuffer buf = (ByteBuffer) buffer;
+            byte[] arr = buf.hasArray() ? buf.array() : null;
+            return nFinishReadPixelsAsync(nativeCtxInfo, readback, buf.capacity(), buffer, arr);
+        } else if (buffer instanceof IntBuffer) {
+            IntBuffer buf = (IntBuffer) buffer;
+            int[] arr = buf.hasArray() ? buf.array() : null;
+            // See readPixels about byte order
+            return nFinishReadPixelsAsync(nativeCtxInfo, readback, buf.capacity() * 4, buffer, arr);
+        }
+        nDisposeReadPixelsAsync(nativeCtxInfo, readback);
+        throw new IllegalArgumentException("readPixel: pixel's buffer type is not supported: "
+                + buffer);
+    }
+
+    /**
+     * Releases a readback started by readPixelsAsync without reading it.
+     */
+    void disposeReadPixels(long readback) {
+        nDisposeReadPixelsAsync(nativeCtxInfo, readback);
+    }
+
     void scissorTest(boolean enable, int x, int y, int w, int h) {
         nScissorTest(nativeCtxInfo, enable, x, y, w, h);
     }
@@ -563,6 +633,25 @@ abstract class GLContext {
         nUseProgram(nativeCtxInfo, progid);
     }
 
+    /**
+     * Enables or disables the native shadow state cache, which skips GL
+     * calls that would not change the current state. Enabling the cache
+     * discards any state it knew about before.
+     */
+    void setStateCacheEnabled(boolean enabled) {
+        nSetStateCacheEnabled(nativeCtxInfo, enabled);
+    }
+
+    /**
+     * Returns the number of GL calls elided by the native state cache for
+     * each of the STATECACHE_* categories, optionally resetting the counters.
+     */
+    int[] getStateCacheCounters(boolean reset) {
+        int[] counters = new int[STATECACHE_NUM_COUNTERS];
+        nGetStateCacheCounters(nativeCtxInfo, counters, reset);
+        return counters;
+    }
+
     void texParamsMinMax(int pname, boolean useMipmap) {
         int min = pname;
         int max = pname;
@@ -723,6 +812,12 @@ abstract class GLContext {
         nDrawIndexedQuads(nativeCtxInfo, numVertices, coords, colors);
     }
 
+    // The buffers are the direct buffers VertexBuffer writes into; they
+    // are uploaded to the streaming vertex buffer object as they are
+    void drawIndexedQuads(FloatBuffer coords, ByteBuffer colors, int numVertices) {
+        nDrawIndexedQuadsBuffered(nativeCtxInfo, numVertices, coords, colors);
+    }
+
     int createIndexBuffer16(short data[]) {
         return nCreateIndexBuffer16(nativeCtxInfo, data, data.length);
     }
@@ -819,4 +914,26 @@ abstract class GLContext {
     void renderMeshView(long nativeMeshViewInfo) {
         nRenderMeshView(nativeCtxInfo, nativeMeshViewInfo);
     }
+
+    /**
+     * Returns true if glDrawElementsInstanced and glVertexAttribDivisor are
+     * available, so that renderMeshViewInstanced can be used.
+     */
+    boolean isInstancingSupported() {
+        if (instancingAvailable == null) {
+            instancingAvailable = nIsInstancingSupported(nativeCtxInfo);
+        }
+        return instancingAvailable;
+    }
+
+    /**
+     * Draws the mesh view numInstances times in a single instanced draw.
+     * worldMatrices holds one column major 4x4 world matrix per instance
+     * and the current program must be built for instanced rendering.
+     */
+    void renderMeshViewInstanced(long nativeMeshViewInfo, float[] worldMatrices,
+            int numInstances) {
+        nRenderMeshViewInstanced(nativeCtxInfo, nativeMeshViewInfo, worldMatrices,
+                numInstances);
+    }
 }
@@ -26,6 +26,7 @@
 package com.sun.prism.impl;
 
 import java.nio.ByteBuffer;
+import java.nio.FloatBuffer;
 import java.util.HashMap;
 import java.util.Iterator;
 import java.util.Map;
@@ -81,9 +82,20 @@ public abstract class BaseContext {
         lcdGlyphCaches = new HashMap<FontStrike, GlyphCache>();
 
     protected BaseContext(Screen screen, ResourceFactory factory, int vbQuads) {
+        this(screen, factory, vbQuads, false);
+    }
+
+    /**
+     * @param directVertexBuffer whether the vertex buffer keeps its data
+     *        in direct NIO buffers, for pipelines that override
+     *        {@link #renderQuads(FloatBuffer, ByteBuffer, int)} to hand
+     *        them to native code without copying
+     */
+    protected BaseContext(Screen screen, ResourceFactory factory, int vbQuads,
+                          boolean directVertexBuffer) {
         this.screen = screen;
         this.factory = factory;
-        this.vertexBuffer = new VertexBuffer(this, vbQuads);
+        this.vertexBuffer = new VertexBuffer(this, vbQuads, directVertexBuffer);
     }
 
     protected void setDeviceParametersFor2D() {}
@@ -120,9 +132,9 @@ public abstract class BaseContext {
         }
     }
 
-    public void drawQuads(float coordArray[], byte colorArray[], int numVertices) {
+    public void drawQuads(FloatBuffer coordBuffer, ByteBuffer colorBuffer, int numVertices) {
         flushMask();
-        renderQuads(coordArray, colorArray, numVertices);
+        renderQuads(coordBuffer, colorBuffer, numVertices);
     }
 
     protected GeneralTransform3D getPerspectiveTransformNoClone() {
@@ -139,6 +151,16 @@ public abstract class BaseContext {
 
     protected abstract void renderQuads(float coordArray[], byte colorArray[], int numVertices);
 
+    /**
+     * Renders quads from the vertex buffer. The default implementation
+     * passes the arrays backing the buffers to
+     * {@link #renderQuads(float[], byte[], int)}, so contexts with a direct
+     * vertex buffer must override it.
+     */
+    protected void renderQuads(FloatBuffer coordBuffer, ByteBuffer colorBuffer, int numVertices) {
+        renderQuads(coordBuffer.array(), colorBuffer.array(), numVertices);
+    }
+
     /**
      *
      * This method will call releaseRenderTarget method to reset last
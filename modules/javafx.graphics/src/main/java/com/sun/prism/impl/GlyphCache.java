@@ -79,6 +79,9 @@ public class GlyphCache {
 
     private RectanglePacker packer;
 
+    // Scratch array for the glyph codes passed to FontStrike.prepareGlyphs
+    private int[] prepareCodes = new int[0];
+
     private boolean isLCDCache;
 
     /* Share a RectanglePacker and its associated texture cache
@@ -133,6 +136,7 @@ public class GlyphCache {
         int len = gl.getGlyphCount();
         Color currentColor = null;
         Point2D pt = new Point2D();
+        boolean prepared = false;
 
         for (int gi = 0; gi < len; gi++) {
             int gc = gl.getGlyphCode(gi);
@@ -146,7 +150,16 @@ public class GlyphCache {
             pt.setLocation(x + gl.getPosX(gi), y + gl.getPosY(gi));
             xform.transform(pt, pt);
             int subPixel = strike.getQuantizedPosition(pt);
-            GlyphData data = getCachedGlyph(gc, subPixel);
+            GlyphData data = lookupCachedGlyph(gc, subPixel);
+            if (data == null) {
+                if (!prepared) {
+                    // First miss in this list, give the strike a chance to
+                    // rasterize the remaining glyphs in one go.
+                    prepareGlyphs(gl, gi, len);
+                    prepared = true;
+                }
+                data = getCachedGlyph(gc, subPixel);
+            }
             if (data != null) {
                 if (clip != null) {
                     // Always check clipping using user space.
@@ -238,6 +251,29 @@ public class GlyphCache {
         packer.clear();
     }
 
+    private void prepareGlyphs(GlyphList gl, int start, int len) {
+        if (len - start > prepareCodes.length) {
+            prepareCodes = new int[len - start];
+        }
+        int count = 0;
+        for (int gi = start; gi < len; gi++) {
+            int gc = gl.getGlyphCode(gi);
+            if ((gc & CompositeGlyphMapper.GLYPHMASK) == CharToGlyphMapper.INVISIBLE_GLYPH_ID) {
+                continue;
+            }
+            prepareCodes[count++] = gc;
+        }
+        strike.prepareGlyphs(prepareCodes, count);
+    }
+
+    private GlyphData lookupCachedGlyph(int glyphCode, int subPixel) {
+        int segIndex = glyphCode >>> SEGSHIFT;
+        int subIndex = glyphCode & SEGMASK;
+        segIndex |= (subPixel << SUBPIXEL_SHIFT);
+        GlyphData[] segment = glyphDataMap.get(segIndex);
+        return segment != null ? segment[subIndex] : null;
+    }
+
     private GlyphData getCachedGlyph(int glyphCode, int subPixel) {
         int segIndex = glyphCode >>> SEGSHIFT;
         int subIndex = glyphCode & SEGMASK;
@@ -256,8 +292,8 @@ public class GlyphCache {
         GlyphData data = null;
         Glyph glyph = strike.getGlyph(glyphCode);
         if (glyph != null) {
-            byte[] glyphImage = glyph.getPixelData(subPixel);
-            if (glyphImage == null || glyphImage.length == 0) {
+            ByteBuffer glyphImage = glyph.getPixelBuffer(subPixel);
+            if (glyphImage == null || !glyphImage.hasRemaining()) {
                 data = new GlyphData(0, 0, 0,
                                      glyph.getPixelXAdvance(),
                                      glyph.getPixelYAdvance(),
@@ -267,11 +303,12 @@ public class GlyphCache {
                 // NOTE : if the MaskData can be stored back directly
                 // in the glyph, even as an opaque type, it should save
                 // repeated work next time the glyph is used.
-                MaskData maskData = MaskData.create(glyphImage,
-                                                    glyph.getOriginX(),
-                                                    glyph.getOriginY(),
-                                                    glyph.getWidth(),
-                                                    glyph.getHeight());
+                MaskData maskData = new MaskData();
+                maskData.update(glyphImage,
+                                glyph.getOriginX(),
+                                glyph.getOriginY(),
+                                glyph.getWidth(),
+                                glyph.getHeight());
 
                 // Make room for the rectangle on the backing store
                 int border = 1;
@@ -85,6 +85,11 @@ public final class PrismSettings {
     public static final boolean forceUploadingPainter;
     public static final boolean forceAlphaTestShader;
     public static final boolean forceNonAntialiasedShape;
+    public static final boolean streamVertexBuffers;
+    public static final boolean nativeStateCache;
+    public static final boolean meshInstancing;
+    public static final int imageLoaderThreads;
+    public static final long imageCacheSize;
 
     public static enum RasterizerType {
         DoubleMarlin("Double Precision Marlin Rasterizer");
@@ -354,6 +359,30 @@ public final class PrismSettings {
         // Force non anti-aliasing (not smooth) shape rendering
         forceNonAntialiasedShape = getBoolean(systemProperties, "prism.forceNonAntialiasedShape", false);
 
+        // Upload ES2 quad batches through a streaming vertex buffer object
+        // instead of drawing from client side vertex arrays
+        streamVertexBuffers = getBoolean(systemProperties, "prism.streamvbo", true);
+
+        // Skip redundant GL state changes in the native ES2 context. Off by
+        // default on Mac and iOS, where the context is shared with Glass.
+        nativeStateCache = getBoolean(systemProperties, "prism.statecache",
+                !PlatformUtil.isMac() && !PlatformUtil.isIOS());
+
+        // Draw consecutive ES2 MeshViews sharing a mesh and a material with
+        // a single instanced draw call when the GL supports instancing
+        meshInstancing = getBoolean(systemProperties, "prism.meshinstancing", true);
+
+        // Number of threads that load and decode background images. Loading
+        // includes reading the stream, so allow some more threads than cores.
+        imageLoaderThreads = Math.max(1, getInt(systemProperties, "prism.imageloaderthreads",
+                Math.max(4, 2 * Runtime.getRuntime().availableProcessors()),
+                "Try -Dprism.imageloaderthreads=<number>"));
+
+        // Maximum number of bytes of decoded images kept for reuse by later
+        // loads of the same URL at the same size, 0 disables the cache
+        imageCacheSize = getLong(systemProperties, "prism.imagecachesize", 0,
+                "Try -Dprism.imagecachesize=<long>[kKmMgG]");
+
     }
 
     private static int parseInt(String s, int dflt, int trueDflt,
@@ -64,6 +64,8 @@ public class QueuedPixelSource implements PixelSource {
     private final List<WeakReference<Pixels>> saved =
          new ArrayList<WeakReference<Pixels>>(3);
     private final boolean useDirectBuffers;
+    // Set when a delivery was dropped so the next one repaints everything
+    private boolean damageLost;
 
     public QueuedPixelSource(boolean useDirectBuffers) {
         this.useDirectBuffers = useDirectBuffers;
@@ -94,6 +96,9 @@ public class QueuedPixelSource implements PixelSource {
         if (beingConsumed != null) {
             throw new IllegalStateException("cannot skip while processing: "+beingConsumed);
         }
+        if (enqueued != null) {
+            damageLost = true;
+        }
         enqueued = null;
     }
 
@@ -136,6 +141,7 @@ public class QueuedPixelSource implements PixelSource {
                 p.getScaleXUnsafe() == scalex &&
                 p.getScaleYUnsafe() == scaley)
             {
+                p.damageAll();
                 return p;
             }
             // Whether or not we reuse its buffer, this Pixels object is going away.
@@ -166,10 +172,18 @@ public class QueuedPixelSource implements PixelSource {
      * Place the indicated {@code Pixels} object into the enqueued state,
      * replacing any other objects that are currently enqueued but not yet
      * being used by the consumer.
+     * The damaged area of a replaced object is merged into the new one so
+     * that no changes are lost when a consumer uploads only damaged areas.
      *
      * @param pixels the {@code Pixels} object to be enqueued
      */
     public synchronized void enqueuePixels(Pixels pixels) {
+        if (damageLost) {
+            pixels.damageAll();
+            damageLost = false;
+        } else if (enqueued != null) {
+            pixels.addDamage(enqueued);
+        }
         enqueued = pixels;
     }
 }
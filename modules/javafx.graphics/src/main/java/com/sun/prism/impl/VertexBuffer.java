@@ -27,7 +27,9 @@ package com.sun.prism.impl;
 
 import com.sun.javafx.geom.transform.AffineBase;
 import com.sun.prism.paint.Color;
-import java.util.Arrays;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
 
 public final class VertexBuffer {
 
@@ -47,18 +49,47 @@ public final class VertexBuffer {
 
     protected byte r, g, b, a;
 
-    protected byte  colorArray[];
-    protected float coordArray[];
+    // Vertices are written with absolute puts straight into these
+    // buffers. Direct buffers can be handed to the pipeline without
+    // copying; heap buffers wrap the arrays the pipeline expects.
+    protected ByteBuffer  colorBuffer;
+    protected FloatBuffer coordBuffer;
 
     private final BaseContext ownerCtx;
+    private final boolean direct;
+    private final float scratch[] = new float[2];
 
     public VertexBuffer(BaseContext owner, int maxQuads) {
+        this(owner, maxQuads, false);
+    }
+
+    public VertexBuffer(BaseContext owner, int maxQuads, boolean direct) {
         this.ownerCtx = owner;
+        this.direct = direct;
         capacity = maxQuads * VERTS_PER_QUAD;
         index = 0;
 
-        colorArray = new byte [capacity * BYTES_PER_VERT];
-        coordArray = new float[capacity * FLOATS_PER_VERT];
+        colorBuffer = allocateColors(capacity);
+        coordBuffer = allocateCoords(capacity);
+    }
+
+    private ByteBuffer allocateColors(int numVerts) {
+        int size = numVerts * BYTES_PER_VERT;
+        return direct
+                ? ByteBuffer.allocateDirect(size).order(ByteOrder.nativeOrder())
+                : ByteBuffer.wrap(new byte[size]);
+    }
+
+    private FloatBuffer allocateCoords(int numVerts) {
+        int size = numVerts * FLOATS_PER_VERT;
+        return direct
+                ? ByteBuffer.allocateDirect(size * Float.BYTES)
+                        .order(ByteOrder.nativeOrder()).asFloatBuffer()
+                : FloatBuffer.wrap(new float[size]);
+    }
+
+    public final boolean isDirect() {
+        return direct;
     }
 
     public final void setPerVertexColor(Color c, float extraAlpha) {
@@ -81,10 +112,10 @@ public final class VertexBuffer {
 
     private void putColor(int idx) {
         int i = idx * BYTES_PER_VERT;
-        colorArray[i+0] = r;
-        colorArray[i+1] = g;
-        colorArray[i+2] = b;
-        colorArray[i+3] = a;
+        colorBuffer.put(i+0, r);
+        colorBuffer.put(i+1, g);
+        colorBuffer.put(i+2, b);
+        colorBuffer.put(i+3, a);
     }
 
     /**
@@ -95,7 +126,7 @@ public final class VertexBuffer {
      */
     public final void flush() {
         if (index > 0) {
-            ownerCtx.drawQuads(coordArray, colorArray, index);
+            ownerCtx.drawQuads(coordBuffer, colorBuffer, index);
             index = 0;
         }
     }
@@ -106,8 +137,12 @@ public final class VertexBuffer {
 
     private void grow() {
         capacity *= 2;
-        colorArray = Arrays.copyOf(colorArray, capacity * BYTES_PER_VERT);
-        coordArray = Arrays.copyOf(coordArray, capacity * FLOATS_PER_VERT);
+        ByteBuffer colors = allocateColors(capacity);
+        colors.put(colorBuffer.clear());
+        colorBuffer = colors;
+        FloatBuffer coords = allocateCoords(capacity);
+        coords.put(coordBuffer.clear());
+        coordBuffer = coords;
     }
 
     public final void addVert(float x, float y) {
@@ -117,9 +152,9 @@ public final class VertexBuffer {
         }
 
         int i = FLOATS_PER_VERT * index;
-        coordArray[i+0] = x;
-        coordArray[i+1] = y;
-        coordArray[i+2] = 0f;
+        coordBuffer.put(i+0, x);
+        coordBuffer.put(i+1, y);
+        coordBuffer.put(i+2, 0f);
         putColor(index);
         index++;
     }
@@ -131,11 +166,11 @@ public final class VertexBuffer {
         }
 
         int i = FLOATS_PER_VERT * index;
-        coordArray[i+0] = x;
-        coordArray[i+1] = y;
-        coordArray[i+2] = 0f;
-        coordArray[i+3] = tx;
-        coordArray[i+4] = ty;
+        coordBuffer.put(i+0, x);
+        coordBuffer.put(i+1, y);
+        coordBuffer.put(i+2, 0f);
+        coordBuffer.put(i+3, tx);
+        coordBuffer.put(i+4, ty);
         putColor(index);
         index++;
     }
@@ -147,13 +182,13 @@ public final class VertexBuffer {
         }
 
         int i = FLOATS_PER_VERT * index;
-        coordArray[i+0] = x;
-        coordArray[i+1] = y;
-        coordArray[i+2] = 0f;
-        coordArray[i+3] = t0x;
-        coordArray[i+4] = t0y;
-        coordArray[i+5] = t1x;
-        coordArray[i+6] = t1y;
+        coordBuffer.put(i+0, x);
+        coordBuffer.put(i+1, y);
+        coordBuffer.put(i+2, 0f);
+        coordBuffer.put(i+3, t0x);
+        coordBuffer.put(i+4, t0y);
+        coordBuffer.put(i+5, t1x);
+        coordBuffer.put(i+6, t1y);
         putColor(index);
         index++;
     }
@@ -161,9 +196,9 @@ public final class VertexBuffer {
     private void addVertNoCheck(float x, float y) {
         // note: assumes caller has already checked capacity
         int i = FLOATS_PER_VERT * index;
-        coordArray[i+0] = x;
-        coordArray[i+1] = y;
-        coordArray[i+2] = 0f;
+        coordBuffer.put(i+0, x);
+        coordBuffer.put(i+1, y);
+        coordBuffer.put(i+2, 0f);
         putColor(index);
         index++;
     }
@@ -171,11 +206,11 @@ public final class VertexBuffer {
     private void addVertNoCheck(float x, float y, float tx, float ty) {
         // note: assumes caller has already checked capacity
         int i = FLOATS_PER_VERT * index;
-        coordArray[i+0] = x;
-        coordArray[i+1] = y;
-        coordArray[i+2] = 0f;
-        coordArray[i+3] = tx;
-        coordArray[i+4] = ty;
+        coordBuffer.put(i+0, x);
+        coordBuffer.put(i+1, y);
+        coordBuffer.put(i+2, 0f);
+        coordBuffer.put(i+3, tx);
+        coordBuffer.put(i+4, ty);
         putColor(index);
         index++;
     }
@@ -183,20 +218,30 @@ public final class VertexBuffer {
     private void addVertNoCheck(float x, float y, float t0x, float t0y, float t1x, float t1y) {
         // note: assumes caller has already checked capacity
         int i = FLOATS_PER_VERT * index;
-        coordArray[i+0] = x;
-        coordArray[i+1] = y;
-        coordArray[i+2] = 0f;
-        coordArray[i+3] = t0x;
-        coordArray[i+4] = t0y;
-        coordArray[i+5] = t1x;
-        coordArray[i+6] = t1y;
+        coordBuffer.put(i+0, x);
+        coordBuffer.put(i+1, y);
+        coordBuffer.put(i+2, 0f);
+        coordBuffer.put(i+3, t0x);
+        coordBuffer.put(i+4, t0y);
+        coordBuffer.put(i+5, t1x);
+        coordBuffer.put(i+6, t1y);
         putColor(index);
         index++;
     }
 
+    // Transforms the point at srcOff and stores the result at dstOff
+    private void transform(AffineBase tx, int srcOff, int dstOff) {
+        float pt[] = scratch;
+        pt[0] = coordBuffer.get(srcOff);
+        pt[1] = coordBuffer.get(srcOff + 1);
+        tx.transform(pt, 0, pt, 0, 1);
+        coordBuffer.put(dstOff, pt[0]);
+        coordBuffer.put(dstOff + 1, pt[1]);
+    }
+
     private void ensureCapacityForQuad() {
         if (index + VERTS_PER_QUAD > capacity) {
-            ownerCtx.drawQuads(coordArray, colorArray, index);
+            ownerCtx.drawQuads(coordBuffer, colorBuffer, index);
             index = 0;
         }
     }
@@ -260,13 +305,13 @@ public final class VertexBuffer {
 
         if (tx != null) {
             int i = FLOATS_PER_VERT * index - FLOATS_PER_VERT;
-            tx.transform(coordArray, i+VCOFF, coordArray, i+TC2OFF, 1);
+            transform(tx, i+VCOFF, i+TC2OFF);
             i -= FLOATS_PER_VERT;
-            tx.transform(coordArray, i+VCOFF, coordArray, i+TC2OFF, 1);
+            transform(tx, i+VCOFF, i+TC2OFF);
             i -= FLOATS_PER_VERT;
-            tx.transform(coordArray, i+VCOFF, coordArray, i+TC2OFF, 1);
+            transform(tx, i+VCOFF, i+TC2OFF);
             i -= FLOATS_PER_VERT;
-            tx.transform(coordArray, i+VCOFF, coordArray, i+TC2OFF, 1);
+            transform(tx, i+VCOFF, i+TC2OFF);
         }
     }
 
@@ -278,40 +323,40 @@ public final class VertexBuffer {
 //        ensureCapacityForQuad();
         int idx = index;
         if (idx + VERTS_PER_QUAD > capacity) {
-            ownerCtx.drawQuads(coordArray, colorArray, idx);
+            ownerCtx.drawQuads(coordBuffer, colorBuffer, idx);
             idx = index = 0;
         }
 
         int i = FLOATS_PER_VERT * idx;
-        float farr[] = coordArray;
+        FloatBuffer farr = coordBuffer;
 
         float text = isText ? 1 : 0;
         float image = isText ? 0 : 1;
 
 //        addVertNoCheck(dx1, dy1, tx1, ty1);
-        farr[  i] = dx1; farr[++i] = dy1; farr[++i] = 0;
-        farr[++i] = tx1; farr[++i] = ty1;
-        farr[++i] = image; farr[++i] = text; i++;
+        farr.put(i, dx1); farr.put(++i, dy1); farr.put(++i, 0);
+        farr.put(++i, tx1); farr.put(++i, ty1);
+        farr.put(++i, image); farr.put(++i, text); i++;
 //        addVertNoCheck(dx1, dy2, tx1, ty2);
-        farr[  i] = dx1; farr[++i] = dy2; farr[++i] = 0;
-        farr[++i] = tx1; farr[++i] = ty2;
-        farr[++i] = image; farr[++i] = text; i++;
+        farr.put(i, dx1); farr.put(++i, dy2); farr.put(++i, 0);
+        farr.put(++i, tx1); farr.put(++i, ty2);
+        farr.put(++i, image); farr.put(++i, text); i++;
 //        addVertNoCheck(dx2, dy1, tx2, ty1);
-        farr[  i] = dx2; farr[++i] = dy1; farr[++i] = 0;
-        farr[++i] = tx2; farr[++i] = ty1;
-        farr[++i] = image; farr[++i] = text; i++;
+        farr.put(i, dx2); farr.put(++i, dy1); farr.put(++i, 0);
+        farr.put(++i, tx2); farr.put(++i, ty1);
+        farr.put(++i, image); farr.put(++i, text); i++;
 //        addVertNoCheck(dx2, dy2, tx2, ty2);
-        farr[  i] = dx2; farr[++i] = dy2; farr[++i] = 0;
-        farr[++i] = tx2; farr[++i] = ty2;
-        farr[++i] = image; farr[++i] = text; i++;
+        farr.put(i, dx2); farr.put(++i, dy2); farr.put(++i, 0);
+        farr.put(++i, tx2); farr.put(++i, ty2);
+        farr.put(++i, image); farr.put(++i, text); i++;
 
-        byte barr[] = colorArray;
+        ByteBuffer barr = colorBuffer;
         byte r = this.r, g = this.g, b = this.b, a = this.a;
         int j = BYTES_PER_VERT * idx;
-        barr[  j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
+        barr.put(j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
 
         index = idx + VERTS_PER_QUAD;
     }
@@ -323,36 +368,36 @@ public final class VertexBuffer {
 //        ensureCapacityForQuad();
         int idx = index;
         if (idx + VERTS_PER_QUAD > capacity) {
-            ownerCtx.drawQuads(coordArray, colorArray, idx);
+            ownerCtx.drawQuads(coordBuffer, colorBuffer, idx);
             idx = index = 0;
         }
 
         int i = FLOATS_PER_VERT * idx;
-        float farr[] = coordArray;
+        FloatBuffer farr = coordBuffer;
 
 //        addVertNoCheck(dx1, dy1, tx1, ty1);
-        farr[  i] = dx1; farr[++i] = dy1; farr[++i] = 0;
-        farr[++i] = tx1; farr[++i] = ty1;
+        farr.put(i, dx1); farr.put(++i, dy1); farr.put(++i, 0);
+        farr.put(++i, tx1); farr.put(++i, ty1);
         i += 3;
 //        addVertNoCheck(dx1, dy2, tx1, ty2);
-        farr[  i] = dx1; farr[++i] = dy2; farr[++i] = 0;
-        farr[++i] = tx1; farr[++i] = ty2;
+        farr.put(i, dx1); farr.put(++i, dy2); farr.put(++i, 0);
+        farr.put(++i, tx1); farr.put(++i, ty2);
         i += 3;
 //        addVertNoCheck(dx2, dy1, tx2, ty1);
-        farr[  i] = dx2; farr[++i] = dy1; farr[++i] = 0;
-        farr[++i] = tx2; farr[++i] = ty1;
+        farr.put(i, dx2); farr.put(++i, dy1); farr.put(++i, 0);
+        farr.put(++i, tx2); farr.put(++i, ty1);
         i += 3;
 //        addVertNoCheck(dx2, dy2, tx2, ty2);
-        farr[  i] = dx2; farr[++i] = dy2; farr[++i] = 0;
-        farr[++i] = tx2; farr[++i] = ty2;
+        farr.put(i, dx2); farr.put(++i, dy2); farr.put(++i, 0);
+        farr.put(++i, tx2); farr.put(++i, ty2);
 
-        byte barr[] = colorArray;
+        ByteBuffer barr = colorBuffer;
         byte r = this.r, g = this.g, b = this.b, a = this.a;
         int j = BYTES_PER_VERT * idx;
-        barr[  j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
+        barr.put(j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
 
         index = idx + VERTS_PER_QUAD;
     }
@@ -363,42 +408,42 @@ public final class VertexBuffer {
     {
         int idx = index;
         if (idx + VERTS_PER_QUAD > capacity) {
-            ownerCtx.drawQuads(coordArray, colorArray, idx);
+            ownerCtx.drawQuads(coordBuffer, colorBuffer, idx);
             idx = index = 0;
         }
 
         int i = FLOATS_PER_VERT * idx;
-        float farr[] = coordArray;
+        FloatBuffer farr = coordBuffer;
 
         // addVertNoCheck(dx1, dy1, tx1, ty1, topopacity);
-        farr[  i] = dx1; farr[++i] = dy1; farr[++i] = 0;
-        farr[++i] = tx1; farr[++i] = ty1;
+        farr.put(i, dx1); farr.put(++i, dy1); farr.put(++i, 0);
+        farr.put(++i, tx1); farr.put(++i, ty1);
         i += 3;
 
         // addVertNoCheck(dx1, dy2, tx1, ty2, botopacity);
-        farr[  i] = dx1; farr[++i] = dy2; farr[++i] = 0;
-        farr[++i] = tx1; farr[++i] = ty2;
+        farr.put(i, dx1); farr.put(++i, dy2); farr.put(++i, 0);
+        farr.put(++i, tx1); farr.put(++i, ty2);
         i += 3;
 
         // addVertNoCheck(dx2, dy1, tx2, ty1, topopacity);
-        farr[  i] = dx2; farr[++i] = dy1; farr[++i] = 0;
-        farr[++i] = tx2; farr[++i] = ty1;
+        farr.put(i, dx2); farr.put(++i, dy1); farr.put(++i, 0);
+        farr.put(++i, tx2); farr.put(++i, ty1);
         i += 3;
 
         // addVertNoCheck(dx2, dy2, tx2, ty2, botopacity);
-        farr[  i] = dx2; farr[++i] = dy2; farr[++i] = 0;
-        farr[++i] = tx2; farr[++i] = ty2;
+        farr.put(i, dx2); farr.put(++i, dy2); farr.put(++i, 0);
+        farr.put(++i, tx2); farr.put(++i, ty2);
 
-        byte barr[] = colorArray;
+        ByteBuffer barr = colorBuffer;
         int j = BYTES_PER_VERT * idx;
 
         byte to = (byte)(topopacity * 0xff);
         byte bo = (byte)(botopacity * 0xff);
 
-        barr[  j] = to; barr[++j] = to; barr[++j] = to; barr[++j] = to;
-        barr[++j] = bo; barr[++j] = bo; barr[++j] = bo; barr[++j] = bo;
-        barr[++j] = to; barr[++j] = to; barr[++j] = to; barr[++j] = to;
-        barr[++j] = bo; barr[++j] = bo; barr[++j] = bo; barr[++j] = bo;
+        barr.put(j, to); barr.put(++j, to); barr.put(++j, to); barr.put(++j, to);
+        barr.put(++j, bo); barr.put(++j, bo); barr.put(++j, bo); barr.put(++j, bo);
+        barr.put(++j, to); barr.put(++j, to); barr.put(++j, to); barr.put(++j, to);
+        barr.put(++j, bo); barr.put(++j, bo); barr.put(++j, bo); barr.put(++j, bo);
 
         index = idx + VERTS_PER_QUAD;
     }
@@ -416,13 +461,13 @@ public final class VertexBuffer {
                        vx11, vy11, vx22, vy11, vx11, vy22, vx22, vy22);
 
         int i = FLOATS_PER_VERT * index - FLOATS_PER_VERT;
-        tx.transform(coordArray, i+TC2OFF, coordArray, i+TC2OFF, 1);
+        transform(tx, i+TC2OFF, i+TC2OFF);
         i -= FLOATS_PER_VERT;
-        tx.transform(coordArray, i+TC2OFF, coordArray, i+TC2OFF, 1);
+        transform(tx, i+TC2OFF, i+TC2OFF);
         i -= FLOATS_PER_VERT;
-        tx.transform(coordArray, i+TC2OFF, coordArray, i+TC2OFF, 1);
+        transform(tx, i+TC2OFF, i+TC2OFF);
         i -= FLOATS_PER_VERT;
-        tx.transform(coordArray, i+TC2OFF, coordArray, i+TC2OFF, 1);
+        transform(tx, i+TC2OFF, i+TC2OFF);
     }
 
     public final void addMappedPgram(
@@ -434,40 +479,40 @@ public final class VertexBuffer {
     {
         int idx = index;
         if (idx + VERTS_PER_QUAD > capacity) {
-            ownerCtx.drawQuads(coordArray, colorArray, idx);
+            ownerCtx.drawQuads(coordBuffer, colorBuffer, idx);
             idx = index = 0;
         }
 
         int i = FLOATS_PER_VERT * idx;
-        float farr[] = coordArray;
+        FloatBuffer farr = coordBuffer;
 
         //addVertNoCheck(dx11, dy11, ux11, uy11, vx, vy);
-        farr[i]   = dx11; farr[++i] = dy11; farr[++i] = 0;
-        farr[++i] = ux11; farr[++i] = uy11;
-        farr[++i] = vx; farr[++i] = vy;
+        farr.put(i, dx11); farr.put(++i, dy11); farr.put(++i, 0);
+        farr.put(++i, ux11); farr.put(++i, uy11);
+        farr.put(++i, vx); farr.put(++i, vy);
 
         //addVertNoCheck(dx12, dy12, ux12, uy12, vx, vy);
-        farr[++i] = dx12; farr[++i] = dy12; farr[++i] = 0;
-        farr[++i] = ux12; farr[++i] = uy12;
-        farr[++i] = vx; farr[++i] = vy;
+        farr.put(++i, dx12); farr.put(++i, dy12); farr.put(++i, 0);
+        farr.put(++i, ux12); farr.put(++i, uy12);
+        farr.put(++i, vx); farr.put(++i, vy);
 
         //addVertNoCheck(dx21, dy21, ux21, uy21, vx, vy);
-        farr[++i] = dx21; farr[++i] = dy21; farr[++i] = 0;
-        farr[++i] = ux21; farr[++i] = uy21;
-        farr[++i] = vx; farr[++i] = vy;
+        farr.put(++i, dx21); farr.put(++i, dy21); farr.put(++i, 0);
+        farr.put(++i, ux21); farr.put(++i, uy21);
+        farr.put(++i, vx); farr.put(++i, vy);
 
             //addVertNoCheck(dx22, dy22, ux22, uy22, vx, vy);
-        farr[++i] = dx22; farr[++i] = dy22; farr[++i] = 0;
-        farr[++i] = ux22; farr[++i] = uy22;
-        farr[++i] = vx; farr[++i] = vy;
+        farr.put(++i, dx22); farr.put(++i, dy22); farr.put(++i, 0);
+        farr.put(++i, ux22); farr.put(++i, uy22);
+        farr.put(++i, vx); farr.put(++i, vy);
 
-        byte barr[] = colorArray;
+        ByteBuffer barr = colorBuffer;
         byte r = this.r, g = this.g, b = this.b, a = this.a;
         int j = BYTES_PER_VERT * idx;
-        barr[  j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
+        barr.put(j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
 
         index = idx + VERTS_PER_QUAD;
     }
@@ -482,40 +527,40 @@ public final class VertexBuffer {
     {
         int idx = index;
         if (idx + VERTS_PER_QUAD > capacity) {
-            ownerCtx.drawQuads(coordArray, colorArray, idx);
+            ownerCtx.drawQuads(coordBuffer, colorBuffer, idx);
             idx = index = 0;
         }
 
         int i = FLOATS_PER_VERT * idx;
-        float farr[] = coordArray;
+        FloatBuffer farr = coordBuffer;
 
         //addVertNoCheck(dx11, dy11, ux11, uy11, vx, vy);
-        farr[i]   = dx11; farr[++i] = dy11; farr[++i] = 0;
-        farr[++i] = ux11; farr[++i] = uy11;
-        farr[++i] = vx11; farr[++i] = vy11;
+        farr.put(i, dx11); farr.put(++i, dy11); farr.put(++i, 0);
+        farr.put(++i, ux11); farr.put(++i, uy11);
+        farr.put(++i, vx11); farr.put(++i, vy11);
 
         //addVertNoCheck(dx12, dy12, ux12, uy12, vx, vy);
-        farr[++i] = dx12; farr[++i] = dy12; farr[++i] = 0;
-        farr[++i] = ux12; farr[++i] = uy12;
-        farr[++i] = vx12; farr[++i] = vy12;
+        farr.put(++i, dx12); farr.put(++i, dy12); farr.put(++i, 0);
+        farr.put(++i, ux12); farr.put(++i, uy12);
+        farr.put(++i, vx12); farr.put(++i, vy12);
 
         //addVertNoCheck(dx21, dy21, ux21, uy21, vx, vy);
-        farr[++i] = dx21; farr[++i] = dy21; farr[++i] = 0;
-        farr[++i] = ux21; farr[++i] = uy21;
-        farr[++i] = vx21; farr[++i] = vy21;
+        farr.put(++i, dx21); farr.put(++i, dy21); farr.put(++i, 0);
+        farr.put(++i, ux21); farr.put(++i, uy21);
+        farr.put(++i, vx21); farr.put(++i, vy21);
 
         //addVertNoCheck(dx22, dy22, ux22, uy22, vx, vy);
-        farr[++i] = dx22; farr[++i] = dy22; farr[++i] = 0;
-        farr[++i] = ux22; farr[++i] = uy22;
-        farr[++i] = vx22; farr[++i] = vy22;
+        farr.put(++i, dx22); farr.put(++i, dy22); farr.put(++i, 0);
+        farr.put(++i, ux22); farr.put(++i, uy22);
+        farr.put(++i, vx22); farr.put(++i, vy22);
 
-        byte barr[] = colorArray;
+        ByteBuffer barr = colorBuffer;
         byte r = this.r, g = this.g, b = this.b, a = this.a;
         int j = BYTES_PER_VERT * idx;
-        barr[  j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
-        barr[++j] = r; barr[++j] = g; barr[++j] = b; barr[++j] = a;
+        barr.put(j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
+        barr.put(++j, r); barr.put(++j, g); barr.put(++j, b); barr.put(++j, a);
 
         index = idx + VERTS_PER_QUAD;
     }
@@ -161,7 +161,12 @@ public abstract class BaseShaderContext extends BaseContext {
     private State state;
 
     protected BaseShaderContext(Screen screen, ShaderFactory factory, int vbQuads) {
-        super(screen, factory, vbQuads);
+        this(screen, factory, vbQuads, false);
+    }
+
+    protected BaseShaderContext(Screen screen, ShaderFactory factory, int vbQuads,
+                                boolean directVertexBuffer) {
+        super(screen, factory, vbQuads, directVertexBuffer);
         this.factory = factory;
         init();
     }
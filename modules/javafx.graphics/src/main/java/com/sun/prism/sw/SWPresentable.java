@@ -54,7 +54,6 @@ final class SWPresentable extends SWRTTexture implements Presentable {
             /*
              * RT-27374
              * TODO: make sure the imgrep matches the Pixels.getNativeFormat()
-             * TODO: dirty region support
              */
             int w = getPhysicalWidth();
             int h = getPhysicalHeight();
@@ -62,7 +61,13 @@ final class SWPresentable extends SWRTTexture implements Presentable {
             IntBuffer pixBuf = (IntBuffer) pixels.getPixels();
             IntBuffer buf = getSurface().getDataIntBuffer();
             assert buf.hasArray();
+            // The Pixels object may hold an older frame, so it is always
+            // refreshed in full; only the upload is limited to the dirty region.
             System.arraycopy(buf.array(), 0, pixBuf.array(), 0, w*h);
+            if (dirtyregion != null) {
+                pixels.setDamage(dirtyregion.x, dirtyregion.y,
+                                 dirtyregion.width, dirtyregion.height);
+            }
             return true;
         } else {
             return false;
@@ -397,6 +397,85 @@ JNIEXPORT jbyteArray JNICALL OS_NATIVE(getBitmapData)(JNIEnv *env, jclass that,
     return result;
 }
 
+#define GLYPH_REC(i, field) \
+    lprecords[(i) * com_sun_javafx_font_freetype_OSFreetype_GLYPH_RECORD_SIZE + \
+              com_sun_javafx_font_freetype_OSFreetype_##field]
+
+JNIEXPORT jint JNICALL OS_NATIVE(renderGlyphs)
+    (JNIEnv *env, jclass that, jlong facePtr, jint loadFlags, jintArray glyphCodes,
+     jint start, jint count, jobject buffer, jint bufferOffset, jintArray records)
+{
+    jint *lpcodes = NULL;
+    jint *lprecords = NULL;
+    unsigned char *dst;
+    jlong capacity;
+    jlong offset = bufferOffset;
+    jint i = 0;
+    FT_Face face = (FT_Face)facePtr;
+
+    if (!face || !glyphCodes || !buffer || !records) return 0;
+    if (start < 0 || count <= 0) return 0;
+    if (start > (*env)->GetArrayLength(env, glyphCodes) - count) return 0;
+    if (count > (*env)->GetArrayLength(env, records) /
+                com_sun_javafx_font_freetype_OSFreetype_GLYPH_RECORD_SIZE) return 0;
+    dst = (unsigned char *)(*env)->GetDirectBufferAddress(env, buffer);
+    capacity = (*env)->GetDirectBufferCapacity(env, buffer);
+    if (!dst || capacity <= 0 || bufferOffset < 0 || bufferOffset > capacity) return 0;
+
+    if ((lpcodes = (*env)->GetIntArrayElements(env, glyphCodes, NULL)) == NULL) goto fail;
+    if ((lprecords = (*env)->GetIntArrayElements(env, records, NULL)) == NULL) goto fail;
+
+    for (i = 0; i < count; i++) {
+        FT_GlyphSlot slot;
+        FT_Bitmap *bitmap;
+        jlong size;
+        unsigned int y;
+
+        GLYPH_REC(i, GLYPH_OFFSET) = -1;
+        if (FT_Load_Glyph(face, (FT_UInt)lpcodes[start + i], (FT_Int32)loadFlags)) {
+            continue;
+        }
+        slot = face->glyph;
+        if (!slot) continue;
+        bitmap = &slot->bitmap;
+
+        /* Same restriction as FTFontFile.initGlyph(), only gray and LCD masks
+         * are expected, anything else is left for the single glyph path. */
+        if (bitmap->pixel_mode != FT_PIXEL_MODE_GRAY &&
+            bitmap->pixel_mode != FT_PIXEL_MODE_LCD) {
+            continue;
+        }
+        if (bitmap->width > 0 && bitmap->rows > 0) {
+            if (!bitmap->buffer || bitmap->pitch < (int)bitmap->width) continue;
+        }
+        size = (jlong)bitmap->width * bitmap->rows;
+        if (size > capacity - offset) {
+            /* Buffer full, the caller continues with the next batch */
+            break;
+        }
+        for (y = 0; y < bitmap->rows; y++) {
+            memcpy(dst + offset + (jlong)y * bitmap->width,
+                   bitmap->buffer + (size_t)y * bitmap->pitch,
+                   bitmap->width);
+        }
+        GLYPH_REC(i, GLYPH_OFFSET) = (jint)offset;
+        GLYPH_REC(i, GLYPH_WIDTH) = (jint)bitmap->width;
+        GLYPH_REC(i, GLYPH_ROWS) = (jint)bitmap->rows;
+        GLYPH_REC(i, GLYPH_PIXEL_MODE) = (jint)bitmap->pixel_mode;
+        GLYPH_REC(i, GLYPH_LEFT) = (jint)slot->bitmap_left;
+        GLYPH_REC(i, GLYPH_TOP) = (jint)slot->bitmap_top;
+        GLYPH_REC(i, GLYPH_ADVANCE_X) = (jint)slot->advance.x;
+        GLYPH_REC(i, GLYPH_ADVANCE_Y) = (jint)slot->advance.y;
+        GLYPH_REC(i, GLYPH_LINEAR_ADVANCE) = (jint)slot->linearHoriAdvance;
+        offset += size;
+    }
+
+fail:
+    if (lprecords) (*env)->ReleaseIntArrayElements(env, records, lprecords, 0);
+    if (lpcodes) (*env)->ReleaseIntArrayElements(env, glyphCodes, lpcodes, JNI_ABORT);
+    return i;
+}
+
 JNIEXPORT void JNICALL OS_NATIVE(FT_1Set_1Transform)
     (JNIEnv *env, jclass that, jlong arg0, jobject arg1, jlong arg2, jlong arg3)
 {
@@ -31,6 +31,7 @@
 #include <pango/pango.h>
 #include <pango/pangoft2.h>
 #include <dlfcn.h>
+#include <string.h>
 
 #ifdef STATIC_BUILD
 JNIEXPORT jint JNICALL
@@ -70,70 +71,156 @@ jboolean checkAndClearException(JNIEnv *env)
 /*                                                                        */
 /**************************************************************************/
 
-typedef struct PangoGlyphString_FID_CACHE {
-    int cached;
-    jclass clazz;
-    jfieldID num_glyphs, glyphs, widths, log_clusters, offset, length, num_chars, font;
-    jmethodID init;
-} PangoGlyphString_FID_CACHE;
+/* Layout of the int[] returned by pango_shape() */
+#define SHAPE_NUM_GLYPHS com_sun_javafx_font_freetype_OSPango_SHAPE_NUM_GLYPHS
+#define SHAPE_NUM_CHARS  com_sun_javafx_font_freetype_OSPango_SHAPE_NUM_CHARS
+#define SHAPE_FONT_LO    com_sun_javafx_font_freetype_OSPango_SHAPE_FONT_LO
+#define SHAPE_FONT_HI    com_sun_javafx_font_freetype_OSPango_SHAPE_FONT_HI
+#define SHAPE_HEADER     com_sun_javafx_font_freetype_OSPango_SHAPE_HEADER_SIZE
 
-PangoGlyphString_FID_CACHE PangoGlyphStringFc;
+/*
+ * Shaping results are cached by text, font and analysis so that runs which
+ * are laid out again (re-wrapping, repeated labels, table cells) do not go
+ * through pango_shape(). The cache holds a reference to the font so that its
+ * address can not be reused by a different font while the entry is alive.
+ */
+#define SHAPE_CACHE_SIZE        256
+#define SHAPE_CACHE_MAX_TEXT    2048
+
+typedef struct ShapeCacheEntry {
+    /* key */
+    gchar *text;
+    gint length;
+    PangoFont *font;
+    guint8 level;
+    guint8 gravity;
+    guint8 flags;
+    guint8 script;
+    PangoLanguage *language;
+    guint hash;
+    /* value */
+    jint *shape;
+    jsize shapeLength;
+    GList link;
+} ShapeCacheEntry;
+
+static GMutex shapeCacheLock;
+static GHashTable *shapeCache;
+static GQueue shapeCacheLRU = G_QUEUE_INIT;
+
+static guint shapeKeyHash(const gchar *text, gint length, const PangoAnalysis *analysis)
+{
+    guint h = 5381;
+    gint i;
+    for (i = 0; i < length; i++) {
+        h = (h << 5) + h + (guchar)text[i];
+    }
+    h ^= g_direct_hash(analysis->font);
+    h ^= g_direct_hash(analysis->language) * 31;
+    h ^= (analysis->level << 24) | (analysis->script << 8) |
+         (analysis->gravity << 4) | analysis->flags;
+    return h;
+}
 
-void cachePangoGlyphStringFields(JNIEnv *env)
+static guint shapeCacheHash(gconstpointer key)
 {
-    if (PangoGlyphStringFc.cached) return;
-    jclass tmpClass = (*env)->FindClass(env, "com/sun/javafx/font/freetype/PangoGlyphString");
-    if (checkAndClearException(env) || !tmpClass) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or tmpClass == NULL");
-        return;
-    }
-    PangoGlyphStringFc.clazz =  (jclass)(*env)->NewGlobalRef(env, tmpClass);
-    PangoGlyphStringFc.num_glyphs = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "num_glyphs", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.num_glyphs) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or num_glyphs == NULL");
-        return;
-    }
-    PangoGlyphStringFc.glyphs = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "glyphs", "[I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.glyphs) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or glyphs == NULL");
-        return;
-    }
-    PangoGlyphStringFc.widths = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "widths", "[I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.widths) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or widths == NULL");
-        return;
-    }
-    PangoGlyphStringFc.log_clusters = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "log_clusters", "[I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.log_clusters) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or log_clusters == NULL");
-        return;
-    }
-    PangoGlyphStringFc.offset = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "offset", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.offset) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or offset == NULL");
-        return;
-    }
-    PangoGlyphStringFc.length = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "length", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.length) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or length == NULL");
-        return;
+    return ((const ShapeCacheEntry *)key)->hash;
+}
+
+static gboolean shapeCacheEqual(gconstpointer a, gconstpointer b)
+{
+    const ShapeCacheEntry *e1 = (const ShapeCacheEntry *)a;
+    const ShapeCacheEntry *e2 = (const ShapeCacheEntry *)b;
+    return e1->hash == e2->hash &&
+           e1->length == e2->length &&
+           e1->font == e2->font &&
+           e1->level == e2->level &&
+           e1->gravity == e2->gravity &&
+           e1->flags == e2->flags &&
+           e1->script == e2->script &&
+           e1->language == e2->language &&
+           memcmp(e1->text, e2->text, e1->length) == 0;
+}
+
+static void freeShapeCacheEntry(ShapeCacheEntry *entry)
+{
+    if (entry->font) g_object_unref(entry->font);
+    g_free(entry->text);
+    g_free(entry->shape);
+    g_free(entry);
+}
+
+static void fillShapeKey(ShapeCacheEntry *key, const gchar *text, gint length,
+                         const PangoAnalysis *analysis)
+{
+    key->text = (gchar *)text;
+    key->length = length;
+    key->font = analysis->font;
+    key->level = analysis->level;
+    key->gravity = analysis->gravity;
+    key->flags = analysis->flags;
+    key->script = analysis->script;
+    key->language = analysis->language;
+    key->hash = shapeKeyHash(text, length, analysis);
+}
+
+static jint *copyShape(const jint *shape, jsize shapeLength)
+{
+    jint *copy = g_new(jint, shapeLength);
+    memcpy(copy, shape, shapeLength * sizeof(jint));
+    return copy;
+}
+
+/* Returns a copy of the cached shape for the key, or NULL. */
+static jint *lookupShape(ShapeCacheEntry *key, jsize *shapeLength)
+{
+    jint *result = NULL;
+    ShapeCacheEntry *entry;
+    g_mutex_lock(&shapeCacheLock);
+    if (shapeCache) {
+        entry = (ShapeCacheEntry *)g_hash_table_lookup(shapeCache, key);
+        if (entry) {
+            g_queue_unlink(&shapeCacheLRU, &entry->link);
+            g_queue_push_head_link(&shapeCacheLRU, &entry->link);
+            result = copyShape(entry->shape, entry->shapeLength);
+            *shapeLength = entry->shapeLength;
+        }
     }
-    PangoGlyphStringFc.num_chars = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "num_chars", "I");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.num_chars) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or num_chars == NULL");
-        return;
+    g_mutex_unlock(&shapeCacheLock);
+    return result;
+}
+
+static void storeShape(ShapeCacheEntry *key, const jint *shape, jsize shapeLength)
+{
+    ShapeCacheEntry *entry = g_new0(ShapeCacheEntry, 1);
+    *entry = *key;
+    entry->text = g_new(gchar, key->length);
+    memcpy(entry->text, key->text, key->length);
+    entry->shape = copyShape(shape, shapeLength);
+    entry->shapeLength = shapeLength;
+    entry->link.data = entry;
+    entry->link.next = entry->link.prev = NULL;
+    g_object_ref(entry->font);
+
+    g_mutex_lock(&shapeCacheLock);
+    if (!shapeCache) {
+        shapeCache = g_hash_table_new(shapeCacheHash, shapeCacheEqual);
     }
-    PangoGlyphStringFc.font = (*env)->GetFieldID(env, PangoGlyphStringFc.clazz, "font", "J");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.font) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or font == NULL");
+    if (g_hash_table_lookup(shapeCache, entry)) {
+        /* Another thread shaped the same run */
+        g_mutex_unlock(&shapeCacheLock);
+        freeShapeCacheEntry(entry);
         return;
     }
-    PangoGlyphStringFc.init = (*env)->GetMethodID(env, PangoGlyphStringFc.clazz, "<init>", "()V");
-    if (checkAndClearException(env) || !PangoGlyphStringFc.init) {
-        fprintf(stderr, "cachePangoGlyphStringFields error: JNI exception or init == NULL");
-        return;
+    if (g_queue_get_length(&shapeCacheLRU) >= SHAPE_CACHE_SIZE) {
+        GList *last = g_queue_pop_tail_link(&shapeCacheLRU);
+        ShapeCacheEntry *old = (ShapeCacheEntry *)last->data;
+        g_hash_table_remove(shapeCache, old);
+        freeShapeCacheEntry(old);
     }
-    PangoGlyphStringFc.cached = 1;
+    g_hash_table_add(shapeCache, entry);
+    g_queue_push_head_link(&shapeCacheLRU, &entry->link);
+    g_mutex_unlock(&shapeCacheLock);
 }
 
 /**************************************************************************/
@@ -144,68 +231,84 @@ void cachePangoGlyphStringFields(JNIEnv *env)
 
 /** Custom **/
 
-JNIEXPORT jobject JNICALL OS_NATIVE(pango_1shape)
+JNIEXPORT jintArray JNICALL OS_NATIVE(pango_1shape)
     (JNIEnv *env, jclass that, jlong str, jlong pangoItem)
 {
     if (!str) return NULL;
     if (!pangoItem) return NULL;
     PangoItem *item = (PangoItem *)pangoItem;
     PangoAnalysis analysis = item->analysis;
-    if (!pangoItem) return NULL;
     const gchar *text= (const gchar *)(str + item->offset);
-    PangoGlyphString *glyphString = pango_glyph_string_new();
-    if (!glyphString) return NULL;
-
-    jobject result = NULL;
-    pango_shape(text, item->length, &analysis, glyphString);
-    int count = glyphString->num_glyphs;
-    if(count == 0) goto fail;
-
-    jintArray glyphsArray = (*env)->NewIntArray(env, count);
-    jintArray widthsArray = (*env)->NewIntArray(env, count);
-    jintArray clusterArray = (*env)->NewIntArray(env, count);
-    if (glyphsArray && widthsArray && clusterArray) {
-        jint glyphs[count];
-        jint widths[count];
-        jint cluster[count];
-        int i;
-        for (i = 0; i < count; i++) {
-            glyphs[i] = glyphString->glyphs[i].glyph;
-            widths[i] = glyphString->glyphs[i].geometry.width;
-            /* translate byte index to char index */
-            cluster[i] = (jint)g_utf8_pointer_to_offset(text, text + glyphString->log_clusters[i]);
+    jintArray result = NULL;
+    jint *shape = NULL;
+    jsize shapeLength = 0;
+    jint *charIndex = NULL;
+    PangoGlyphString *glyphString = NULL;
+    ShapeCacheEntry key;
+
+    /* Runs with extra attributes are shaped with properties that are
+     * not part of the key, they are never cached. */
+    gboolean cacheable = analysis.font != NULL &&
+                         analysis.extra_attrs == NULL &&
+                         item->length <= SHAPE_CACHE_MAX_TEXT;
+    if (cacheable) {
+        fillShapeKey(&key, text, item->length, &analysis);
+        shape = lookupShape(&key, &shapeLength);
+    }
+
+    if (!shape) {
+        int count, i;
+        const gchar *p;
+        glyphString = pango_glyph_string_new();
+        if (!glyphString) return NULL;
+        pango_shape(text, item->length, &analysis, glyphString);
+        count = glyphString->num_glyphs;
+        if (count == 0) goto fail;
+
+        /* Translate the byte index of each cluster to a char index in a
+         * single pass over the text instead of one scan per glyph. */
+        charIndex = g_new(jint, item->length + 1);
+        p = text;
+        for (i = 0; p < text + item->length; i++) {
+            const gchar *next = g_utf8_next_char(p);
+            while (p < next && p < text + item->length) {
+                charIndex[p - text] = i;
+                p++;
+            }
         }
-        (*env)->SetIntArrayRegion(env, glyphsArray, 0, count, glyphs);
-        if ((*env)->ExceptionOccurred(env)) {
-            fprintf(stderr, "OS_NATIVE error: JNI exception");
-            goto fail;
+        charIndex[item->length] = i;
+
+        shapeLength = SHAPE_HEADER + 3 * count;
+        shape = g_new(jint, shapeLength);
+        shape[SHAPE_NUM_GLYPHS] = count;
+        shape[SHAPE_NUM_CHARS] = item->num_chars;
+        shape[SHAPE_FONT_LO] = (jint)((jlong)analysis.font);
+        shape[SHAPE_FONT_HI] = (jint)(((jlong)analysis.font) >> 32);
+        for (i = 0; i < count; i++) {
+            gint cluster = glyphString->log_clusters[i];
+            if (cluster < 0 || cluster > item->length) cluster = 0;
+            shape[SHAPE_HEADER + i] = glyphString->glyphs[i].glyph;
+            shape[SHAPE_HEADER + count + i] = glyphString->glyphs[i].geometry.width;
+            shape[SHAPE_HEADER + 2 * count + i] = charIndex[cluster];
         }
-        (*env)->SetIntArrayRegion(env, widthsArray, 0, count, widths);
-        if ((*env)->ExceptionOccurred(env)) {
-            fprintf(stderr, "OS_NATIVE error: JNI exception");
-            goto fail;
+        if (cacheable) {
+            storeShape(&key, shape, shapeLength);
         }
-        (*env)->SetIntArrayRegion(env, clusterArray, 0, count, cluster);
+    }
+
+    result = (*env)->NewIntArray(env, shapeLength);
+    if (result) {
+        (*env)->SetIntArrayRegion(env, result, 0, shapeLength, shape);
         if ((*env)->ExceptionOccurred(env)) {
             fprintf(stderr, "OS_NATIVE error: JNI exception");
-            goto fail;
-        }
-        if (!PangoGlyphStringFc.cached) cachePangoGlyphStringFields(env);
-        result = (*env)->NewObject(env, PangoGlyphStringFc.clazz, PangoGlyphStringFc.init);
-        if (result) {
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.num_glyphs, count);
-            (*env)->SetObjectField(env, result, PangoGlyphStringFc.glyphs, glyphsArray);
-            (*env)->SetObjectField(env, result, PangoGlyphStringFc.widths, widthsArray);
-            (*env)->SetObjectField(env, result, PangoGlyphStringFc.log_clusters, clusterArray);
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.offset, item->offset);
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.length, item->length);
-            (*env)->SetIntField(env, result, PangoGlyphStringFc.num_chars, item->num_chars);
-            (*env)->SetLongField(env, result, PangoGlyphStringFc.font, (jlong)analysis.font);
+            result = NULL;
         }
     }
 
 fail:
-    pango_glyph_string_free(glyphString);
+    g_free(charIndex);
+    g_free(shape);
+    if (glyphString) pango_glyph_string_free(glyphString);
     return result;
 }
 
@@ -514,9 +514,28 @@ void WindowContextBase::process_key(GdkEventKey* event) {
     }
 }
 
-void WindowContextBase::paint(void* data, jint width, jint height) {
+void WindowContextBase::paint(void* data, jint width, jint height,
+        jint dx, jint dy, jint dw, jint dh) {
+    // A negative damage size means the whole image has changed. Otherwise
+    // only the damaged rectangle is pushed to the window, the rest of the
+    // window still holds the previously uploaded frame.
+    if (dw < 0 || dh < 0) {
+        dx = 0;
+        dy = 0;
+        dw = width;
+        dh = height;
+    } else {
+        if (dx < 0) { dw += dx; dx = 0; }
+        if (dy < 0) { dh += dy; dy = 0; }
+        if (dx + dw > width) dw = width - dx;
+        if (dy + dh > height) dh = height - dy;
+        if (dw <= 0 || dh <= 0) {
+            return;
+        }
+    }
+
 #ifdef GLASS_GTK3
-    cairo_rectangle_int_t rect = {0, 0, width, height};
+    cairo_rectangle_int_t rect = {dx, dy, dw, dh};
     cairo_region_t *region = cairo_region_create_rectangle(&rect);
     gdk_window_begin_paint_region(gdk_window, region);
 #endif
@@ -530,6 +549,8 @@ void WindowContextBase::paint(void* data, jint width, jint height) {
 
     applyShapeMask(data, width, height);
 
+    cairo_rectangle(context, dx, dy, dw, dh);
+    cairo_clip(context);
     cairo_set_source_surface(context, cairo_surface, 0, 0);
     cairo_set_operator(context, CAIRO_OPERATOR_SOURCE);
     cairo_paint(context);
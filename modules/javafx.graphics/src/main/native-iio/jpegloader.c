@@ -1531,10 +1531,6 @@ JNIEXPORT jint JNICALL Java_com_sun_javafx_iio_jpeg_JPEGImageLoader_startDecompr
     struct jpeg_source_mgr *src = cinfo->src;
     sun_jpeg_error_ptr jerr;
 
-    jfloat x_scale;
-    jfloat y_scale;
-    jfloat max_scale;
-
     if (GET_ARRAYS(env, data, &cinfo->src->next_input_byte) == NOT_OK) {
         ThrowByName(env,
                 "java/io/IOException",
@@ -1568,27 +1564,31 @@ JNIEXPORT jint JNICALL Java_com_sun_javafx_iio_jpeg_JPEGImageLoader_startDecompr
      *     unsigned int scale_num, scale_denom
      *
      *     Scale the image by the fraction scale_num/scale_denom.  Default is
-     *     1/1, or no scaling.  Currently, the only supported scaling ratios
-     *     are 1/1, 1/2, 1/4, and 1/8.  (The library design allows for arbitrary
-     *     scaling ratios but this is not likely to be implemented any time soon.)
+     *     1/1, or no scaling.  Currently, the supported scaling ratios are
+     *     M/N with all M from 1 to 16, where N is the source DCT size, which
+     *     is 8 for baseline JPEG.
      *     Smaller scaling ratios permit significantly faster decoding since
      *     fewer pixels need be processed and a simpler IDCT method can be used.
+     *
+     * Pick the smallest M/8 for which the decoded image is still at least
+     * as large as the requested one in both directions, so that the Java
+     * side only has to do the final (smooth) downscale by less than 2x.
      */
 
-    cinfo->scale_num = 1;
+    cinfo->scale_denom = 8;
+    cinfo->scale_num = 8;
 
-    x_scale = (jfloat) dest_width / (jfloat) cinfo->image_width;
-    y_scale = (jfloat) dest_height / (jfloat) cinfo->image_height;
-    max_scale = x_scale > y_scale ? x_scale : y_scale;
+    if (dest_width > 0 && dest_height > 0 &&
+            (JDIMENSION) dest_width < cinfo->image_width &&
+            (JDIMENSION) dest_height < cinfo->image_height) {
+        /* image dimensions are limited to JPEG_MAX_DIMENSION, no overflow */
+        unsigned int x_num =
+                (dest_width * 8 + cinfo->image_width - 1) / cinfo->image_width;
+        unsigned int y_num =
+                (dest_height * 8 + cinfo->image_height - 1) / cinfo->image_height;
+        unsigned int num = x_num > y_num ? x_num : y_num;
 
-    if (max_scale > 0.5) {
-        cinfo->scale_denom = 1;
-    } else if (max_scale > 0.25) {
-        cinfo->scale_denom = 2;
-    } else if (max_scale > 0.125) {
-        cinfo->scale_denom = 4;
-    } else {
-        cinfo->scale_denom = 8;
+        cinfo->scale_num = num < 1 ? 1 : (num > 8 ? 8 : num);
     }
 
     jpeg_start_decompress(cinfo);
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Scanline unfiltering for the PNG loader. The rows are inflated by
+ * java.util.zip.Inflater and then reconstructed here, in place.
+ *
+ * The Sub, Average and Paeth filters depend on the previous pixel of the
+ * same row, so the SSE2 versions process one 3 or 4 byte pixel per step
+ * with all its bytes at once. The Up filter has no such dependency and is
+ * applied 16 bytes at a time.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "jni.h"
+
+#include "com_sun_javafx_iio_png_PNGImageLoader2.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PNG_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* The filter types, as in PNGImageLoader2 */
+#define PNG_FILTER_NONE    0
+#define PNG_FILTER_SUB     1
+#define PNG_FILTER_UP      2
+#define PNG_FILTER_AVERAGE 3
+#define PNG_FILTER_PAETH   4
+
+static void unfilterSub(unsigned char *line, int length, int bpp) {
+    int i;
+    for (i = bpp; i < length; i++) {
+        line[i] = (unsigned char) (line[i] + line[i - bpp]);
+    }
+}
+
+static void unfilterUp(unsigned char *line, const unsigned char *pline, int length) {
+    int i = 0;
+#ifdef PNG_SSE2
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *) (line + i));
+        __m128i b = _mm_loadu_si128((const __m128i *) (pline + i));
+        _mm_storeu_si128((__m128i *) (line + i), _mm_add_epi8(x, b));
+    }
+#endif
+    for (; i < length; i++) {
+        line[i] = (unsigned char) (line[i] + pline[i]);
+    }
+}
+
+static void unfilterAverage(unsigned char *line, const unsigned char *pline, int length, int bpp) {
+    int i;
+    for (i = 0; i < bpp && i < length; i++) {
+        line[i] = (unsigned char) (line[i] + (pline[i] >> 1));
+    }
+    for (; i < length; i++) {
+        line[i] = (unsigned char) (line[i] + ((line[i - bpp] + pline[i]) >> 1));
+    }
+}
+
+static int paethPredictor(int a, int b, int c) {
+    int pa = abs(b - c);
+    int pb = abs(a - c);
+    int pc = abs(b - c + a - c);
+    return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+}
+
+static void unfilterPaeth(unsigned char *line, const unsigned char *pline, int length, int bpp) {
+    int i;
+    for (i = 0; i < bpp && i < length; i++) {
+        line[i] = (unsigned char) (line[i] + pline[i]);
+    }
+    for (; i < length; i++) {
+        line[i] = (unsigned char) (line[i] + paethPredictor(line[i - bpp], pline[i], pline[i - bpp]));
+    }
+}
+
+#ifdef PNG_SSE2
+
+static __m128i loadPixel(const unsigned char *p, int bpp) {
+    int v = 0;
+    memcpy(&v, p, bpp);
+    return _mm_cvtsi32_si128(v);
+}
+
+static void storePixel(unsigned char *p, __m128i x, int bpp) {
+    int v = _mm_cvtsi128_si32(x);
+    memcpy(p, &v, bpp);
+}
+
+static void unfilterSubSSE2(unsigned char *line, int length, int bpp) {
+    __m128i a = _mm_setzero_si128();
+    int i;
+    for (i = 0; i < length; i += bpp) {
+        a = _mm_add_epi8(loadPixel(line + i, bpp), a);
+        storePixel(line + i, a, bpp);
+    }
+}
+
+static void unfilterAverageSSE2(unsigned char *line, const unsigned char *pline, int length, int bpp) {
+    __m128i a = _mm_setzero_si128();
+    __m128i one = _mm_set1_epi8(1);
+    int i;
+    for (i = 0; i < length; i += bpp) {
+        __m128i b = loadPixel(pline + i, bpp);
+        /* _mm_avg_epu8 rounds up, the filter rounds down */
+        __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+        a = _mm_add_epi8(loadPixel(line + i, bpp), avg);
+        storePixel(line + i, a, bpp);
+    }
+}
+
+static __m128i abs16(__m128i x) {
+    return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+static __m128i select16(__m128i mask, __m128i x, __m128i y) {
+    return _mm_or_si128(_mm_and_si128(mask, x), _mm_andnot_si128(mask, y));
+}
+
+static void unfilterPaethSSE2(unsigned char *line, const unsigned char *pline, int length, int bpp) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i a = zero, c = zero;
+    int i;
+    for (i = 0; i < length; i += bpp) {
+        /* The predictor is computed on 16 bit lanes */
+        __m128i b = _mm_unpacklo_epi8(loadPixel(pline + i, bpp), zero);
+        __m128i pa = _mm_sub_epi16(b, c);
+        __m128i pb = _mm_sub_epi16(a, c);
+        __m128i pc = abs16(_mm_add_epi16(pa, pb));
+        __m128i smallest, nearest;
+        pa = abs16(pa);
+        pb = abs16(pb);
+        smallest = _mm_min_epi16(_mm_min_epi16(pa, pb), pc);
+
+        /* Ties go to a, then to b */
+        nearest = select16(_mm_cmpeq_epi16(pb, smallest), b, c);
+        nearest = select16(_mm_cmpeq_epi16(pa, smallest), a, nearest);
+
+        a = _mm_add_epi8(loadPixel(line + i, bpp), _mm_packus_epi16(nearest, nearest));
+        storePixel(line + i, a, bpp);
+        a = _mm_unpacklo_epi8(a, zero);
+        c = b;
+    }
+}
+
+#endif /* PNG_SSE2 */
+
+/*
+ * Reconstructs a scanline in place from the previous one. bpp is the
+ * number of bytes per complete pixel, or 1 for bit depths below 8.
+ */
+static void unfilter(unsigned char *line, const unsigned char *pline, int length, int filter, int bpp) {
+#ifdef PNG_SSE2
+    /* The pixel loops need whole 3 or 4 byte pixels, which 8 bit RGB and
+     * RGBA rows always have */
+    jboolean simd = (bpp == 3 || bpp == 4) && length % bpp == 0;
+#endif
+
+    switch (filter) {
+        case PNG_FILTER_SUB:
+#ifdef PNG_SSE2
+            if (simd) {
+                unfilterSubSSE2(line, length, bpp);
+                break;
+            }
+#endif
+            unfilterSub(line, length, bpp);
+            break;
+        case PNG_FILTER_UP:
+            unfilterUp(line, pline, length);
+            break;
+        case PNG_FILTER_AVERAGE:
+#ifdef PNG_SSE2
+            if (simd) {
+                unfilterAverageSSE2(line, pline, length, bpp);
+                break;
+            }
+#endif
+            unfilterAverage(line, pline, length, bpp);
+            break;
+        case PNG_FILTER_PAETH:
+#ifdef PNG_SSE2
+            if (simd) {
+                unfilterPaethSSE2(line, pline, length, bpp);
+                break;
+            }
+#endif
+            unfilterPaeth(line, pline, length, bpp);
+            break;
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_sun_javafx_iio_png_PNGImageLoader2_unfilterRow
+(JNIEnv *env, jclass cls, jbyteArray line, jbyteArray pline, jint filter, jint bpp) {
+    jsize length = (*env)->GetArrayLength(env, line);
+    unsigned char *pLine, *pPline;
+
+    if (filter == PNG_FILTER_NONE || length == 0) {
+        return;
+    }
+    if (bpp <= 0 || (*env)->GetArrayLength(env, pline) < length) {
+        return;
+    }
+
+    pLine = (unsigned char *) (*env)->GetPrimitiveArrayCritical(env, line, NULL);
+    if (pLine == NULL) {
+        return;
+    }
+    pPline = (unsigned char *) (*env)->GetPrimitiveArrayCritical(env, pline, NULL);
+    if (pPline == NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, line, pLine, 0);
+        return;
+    }
+
+    unfilter(pLine, pPline, length, filter, bpp);
+
+    (*env)->ReleasePrimitiveArrayCritical(env, pline, pPline, JNI_ABORT);
+    (*env)->ReleasePrimitiveArrayCritical(env, line, pLine, 0);
+}
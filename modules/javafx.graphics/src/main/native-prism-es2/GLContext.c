@@ -63,6 +63,53 @@ void printGLError(GLenum errCode) {
     }
 }
 
+/*
+ * Textures, programs and uniform values live in the share group rather than
+ * in a single context, and every Prism context shares with the context
+ * returned by GLFactory.getShareContext. The uniform cache is therefore kept
+ * once for the whole share group, and deleting a texture or a program drops
+ * it from the shadow state of every context that caches state. Prism only
+ * renders from one thread, so no locking is needed.
+ */
+#define STATE_CACHE_MAX_CONTEXTS 32
+
+static UniformCacheEntry sharedUniforms[STATE_CACHE_UNIFORM_SLOTS];
+static ContextInfo *cachingContexts[STATE_CACHE_MAX_CONTEXTS];
+
+/*
+ * Adds the context to the set invalidated by texture and program deletion.
+ * Returns JNI_FALSE if the set is full, in which case the context must not
+ * cache state.
+ */
+static jboolean registerCachingContext(ContextInfo *ctxInfo) {
+    int i;
+    int freeSlot = -1;
+
+    for (i = 0; i < STATE_CACHE_MAX_CONTEXTS; i++) {
+        if (cachingContexts[i] == ctxInfo) {
+            return JNI_TRUE;
+        }
+        if ((cachingContexts[i] == NULL) && (freeSlot < 0)) {
+            freeSlot = i;
+        }
+    }
+    if (freeSlot < 0) {
+        return JNI_FALSE;
+    }
+    cachingContexts[freeSlot] = ctxInfo;
+    return JNI_TRUE;
+}
+
+static void unregisterCachingContext(ContextInfo *ctxInfo) {
+    int i;
+
+    for (i = 0; i < STATE_CACHE_MAX_CONTEXTS; i++) {
+        if (cachingContexts[i] == ctxInfo) {
+            cachingContexts[i] = NULL;
+        }
+    }
+}
+
 void initializeCtxInfo(ContextInfo *ctxInfo) {
     if (ctxInfo == NULL) {
         return;
@@ -76,6 +123,22 @@ void deleteCtxInfo(ContextInfo *ctxInfo) {
         return;
     }
 
+    unregisterCachingContext(ctxInfo);
+
+    /* The streaming and instance vertex buffers belong to this context,
+     * which the caller keeps current until it is destroyed below */
+    if ((ctxInfo->streamVbo != 0) && (ctxInfo->glDeleteBuffers != NULL)) {
+        ctxInfo->glDeleteBuffers(1, &ctxInfo->streamVbo);
+        ctxInfo->streamVbo = 0;
+        ctxInfo->streamVboSize = 0;
+        ctxInfo->streamVboOffset = 0;
+    }
+    if ((ctxInfo->instanceVbo != 0) && (ctxInfo->glDeleteBuffers != NULL)) {
+        ctxInfo->glDeleteBuffers(1, &ctxInfo->instanceVbo);
+        ctxInfo->instanceVbo = 0;
+        ctxInfo->instanceVboSize = 0;
+    }
+
     if (ctxInfo->versionStr != NULL) {
         free(ctxInfo->versionStr);
     }
@@ -116,13 +179,174 @@ void deleteCtxInfo(ContextInfo *ctxInfo) {
     memset(ctxInfo, 0, sizeof (ContextInfo));
 }
 
+/*
+ * Forget all shadow state so that the next request of each kind is passed
+ * through to GL. The elided call counters are left untouched.
+ */
+static void resetStateCache(ContextInfo *ctxInfo) {
+    int i;
+
+    ctxInfo->state.activeTexUnit = (GLuint) -1;
+    for (i = 0; i < STATE_CACHE_MAX_TEXTURE_UNITS; i++) {
+        ctxInfo->state.boundTextures[i] = (GLuint) -1;
+    }
+    ctxInfo->state.program = (GLuint) -1;
+    ctxInfo->state.blendSrc = (GLenum) -1;
+    ctxInfo->state.blendDst = (GLenum) -1;
+    ctxInfo->state.scissorBox[0] = 0;
+    ctxInfo->state.scissorBox[1] = 0;
+    ctxInfo->state.scissorBox[2] = -1;
+    ctxInfo->state.scissorBox[3] = -1;
+}
+
+/* Sets the blend function and records it in the state cache */
+static void setBlendFunc(ContextInfo *ctxInfo, GLenum sFactor, GLenum dFactor) {
+    glBlendFunc(sFactor, dFactor);
+    ctxInfo->state.blendSrc = sFactor;
+    ctxInfo->state.blendDst = dFactor;
+}
+
+/* Binds a 2D texture to the active unit and records it in the state cache */
+static void bindTexture2D(ContextInfo *ctxInfo, GLuint texID) {
+    GLuint unit = ctxInfo->state.activeTexUnit;
+
+    glBindTexture(GL_TEXTURE_2D, texID);
+    if (unit < STATE_CACHE_MAX_TEXTURE_UNITS) {
+        ctxInfo->state.boundTextures[unit] = texID;
+    }
+}
+
+static void forgetTextureBinding(ContextInfo *ctxInfo, GLuint texID) {
+    int i;
+
+    for (i = 0; i < STATE_CACHE_MAX_TEXTURE_UNITS; i++) {
+        if (ctxInfo->state.boundTextures[i] == texID) {
+            ctxInfo->state.boundTextures[i] = (GLuint) -1;
+        }
+    }
+}
+
+/*
+ * Drops everything the state cache knows about the given texture, in the
+ * calling context and in every other caching context of the share group.
+ */
+static void invalidateTexture(ContextInfo *ctxInfo, GLuint texID) {
+    int i;
+
+    forgetTextureBinding(ctxInfo, texID);
+    for (i = 0; i < STATE_CACHE_MAX_CONTEXTS; i++) {
+        if (cachingContexts[i] != NULL) {
+            forgetTextureBinding(cachingContexts[i], texID);
+        }
+    }
+}
+
+/*
+ * Drops all cached uniform values of the given program and forgets it as
+ * the current program of every caching context.
+ */
+static void invalidateProgram(ContextInfo *ctxInfo, GLuint program) {
+    int i;
+
+    for (i = 0; i < STATE_CACHE_UNIFORM_SLOTS; i++) {
+        if (sharedUniforms[i].program == program) {
+            sharedUniforms[i].type = 0;
+        }
+    }
+    if (ctxInfo->state.program == program) {
+        ctxInfo->state.program = (GLuint) -1;
+    }
+    for (i = 0; i < STATE_CACHE_MAX_CONTEXTS; i++) {
+        if ((cachingContexts[i] != NULL)
+                && (cachingContexts[i]->state.program == program)) {
+            cachingContexts[i]->state.program = (GLuint) -1;
+        }
+    }
+}
+
+/*
+ * Records a uniform upload of the current program in the shared uniform
+ * cache. Uploads are recorded whether or not the calling context caches
+ * state, since another context may later elide against the same program.
+ * Returns JNI_FALSE if the uniform already holds the given value and the
+ * GL call can be skipped.
+ */
+static jboolean updateUniformCache(ContextInfo *ctxInfo, GLint location,
+        GLenum type, GLint size, const void *values) {
+    GLuint program = ctxInfo->state.program;
+    UniformCacheEntry *entry;
+    size_t numBytes = (size_t) size * 4;
+
+    if ((location < 0) || (program == (GLuint) -1)) {
+        return JNI_TRUE;
+    }
+    entry = &sharedUniforms[
+            (program * 31 + (GLuint) location) & (STATE_CACHE_UNIFORM_SLOTS - 1)];
+    if (ctxInfo->state.stateCacheEnabled
+            && (entry->program == program) && (entry->location == location)
+            && (entry->type == type) && (entry->size == size)
+            && (memcmp(&entry->value, values, numBytes) == 0)) {
+        ctxInfo->state.elidedCalls[com_sun_prism_es2_GLContext_STATECACHE_UNIFORM]++;
+        return JNI_FALSE;
+    }
+    entry->program = program;
+    entry->location = location;
+    entry->type = type;
+    entry->size = size;
+    memcpy(&entry->value, values, numBytes);
+    return JNI_TRUE;
+}
+
+/*
+ * Drops the cached values of count consecutive uniform locations of the
+ * current program, used for uploads that bypass the cache.
+ */
+static void invalidateUniforms(ContextInfo *ctxInfo, GLint location, GLint count) {
+    GLuint program = ctxInfo->state.program;
+    UniformCacheEntry *entry;
+    GLint i;
+
+    if ((location < 0) || (program == (GLuint) -1)) {
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        entry = &sharedUniforms[
+                (program * 31 + (GLuint) (location + i)) & (STATE_CACHE_UNIFORM_SLOTS - 1)];
+        if ((entry->program == program) && (entry->location == location + i)) {
+            entry->type = 0;
+        }
+    }
+}
+
+static jboolean uniformfChanged(ContextInfo *ctxInfo, GLint location, GLint size,
+        GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    GLfloat values[4];
+    values[0] = v0;
+    values[1] = v1;
+    values[2] = v2;
+    values[3] = v3;
+    return updateUniformCache(ctxInfo, location, GL_FLOAT, size, values);
+}
+
+static jboolean uniformiChanged(ContextInfo *ctxInfo, GLint location, GLint size,
+        GLint v0, GLint v1, GLint v2, GLint v3) {
+    GLint values[4];
+    values[0] = v0;
+    values[1] = v1;
+    values[2] = v2;
+    values[3] = v3;
+    return updateUniformCache(ctxInfo, location, GL_INT, size, values);
+}
+
 void initState(ContextInfo *ctxInfo) {
     if (ctxInfo == NULL) {
         return;
     }
 
+    resetStateCache(ctxInfo);
+
     glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    setBlendFunc(ctxInfo, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     // initialize states and properties to
     // match cached states and properties
@@ -221,7 +445,13 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nActiveTexture
     if ((ctxInfo == NULL) || (ctxInfo->glActiveTexture == NULL)) {
         return;
     }
+    if (ctxInfo->state.stateCacheEnabled
+            && (ctxInfo->state.activeTexUnit == (GLuint) texUnit)) {
+        ctxInfo->state.elidedCalls[com_sun_prism_es2_GLContext_STATECACHE_TEXTURE]++;
+        return;
+    }
     ctxInfo->glActiveTexture(GL_TEXTURE0 + texUnit);
+    ctxInfo->state.activeTexUnit = (GLuint) texUnit;
 }
 
 /*
@@ -242,7 +472,19 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nBindFBO
  */
 JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nBindTexture
 (JNIEnv *env, jclass class, jlong nativeCtxInfo, jint texID) {
-    glBindTexture(GL_TEXTURE_2D, texID);
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    GLuint unit;
+    if (ctxInfo == NULL) {
+        return;
+    }
+    unit = ctxInfo->state.activeTexUnit;
+    if (ctxInfo->state.stateCacheEnabled
+            && (unit < STATE_CACHE_MAX_TEXTURE_UNITS)
+            && (ctxInfo->state.boundTextures[unit] == (GLuint) texID)) {
+        ctxInfo->state.elidedCalls[com_sun_prism_es2_GLContext_STATECACHE_TEXTURE]++;
+        return;
+    }
+    bindTexture2D(ctxInfo, (GLuint) texID);
 }
 
 GLenum translateScaleFactor(jint scaleFactor) {
@@ -286,11 +528,23 @@ GLenum translateScaleFactor(jint scaleFactor) {
 /*
  * Class:     com_sun_prism_es2_GLContext
  * Method:    nBlendFunc
- * Signature: (II)V
+ * Signature: (JII)V
  */
 JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nBlendFunc
-(JNIEnv *env, jclass class, jint sFactor, jint dFactor) {
-    glBlendFunc(translateScaleFactor(sFactor), translateScaleFactor(dFactor));
+(JNIEnv *env, jclass class, jlong nativeCtxInfo, jint sFactor, jint dFactor) {
+    GLenum src, dst;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    if (ctxInfo == NULL) {
+        return;
+    }
+    src = translateScaleFactor(sFactor);
+    dst = translateScaleFactor(dFactor);
+    if (ctxInfo->state.stateCacheEnabled
+            && (ctxInfo->state.blendSrc == src) && (ctxInfo->state.blendDst == dst)) {
+        ctxInfo->state.elidedCalls[com_sun_prism_es2_GLContext_STATECACHE_BLEND]++;
+        return;
+    }
+    setBlendFunc(ctxInfo, src, dst);
 }
 
 /*
@@ -604,6 +858,9 @@ JNIEXPORT jint JNICALL Java_com_sun_prism_es2_GLContext_nCreateProgram
 
     (*env)->ReleaseIntArrayElements(env, fragIDArr, fragIDs, JNI_ABORT);
 
+    // The name may have been used by a program deleted earlier
+    invalidateProgram(ctxInfo, shaderProgram);
+
     return shaderProgram;
 }
 
@@ -686,7 +943,8 @@ JNIEXPORT jint JNICALL Java_com_sun_prism_es2_GLContext_nCreateTexture
         return (jint) texID;
     }
 
-    glBindTexture(GL_TEXTURE_2D, texID);
+    invalidateTexture(ctxInfo, texID);
+    bindTexture2D(ctxInfo, texID);
 
     // Reset Error
     glGetError();
@@ -698,6 +956,7 @@ JNIEXPORT jint JNICALL Java_com_sun_prism_es2_GLContext_nCreateTexture
 
     if (err != GL_NO_ERROR) {
         glDeleteTextures(1, &texID);
+        invalidateTexture(ctxInfo, texID);
         texID = 0;
     } else {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -746,6 +1005,7 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nDisposeShaders
     (*env)->ReleaseIntArrayElements(env, fragIDArr, fragIDs, JNI_ABORT);
 
     ctxInfo->glDeleteProgram(shaderProgram);
+    invalidateProgram(ctxInfo, shaderProgram);
 }
 
 /*
@@ -804,8 +1064,12 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nDeleteShader
 JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nDeleteTexture
 (JNIEnv *env, jclass class, jlong nativeCtxInfo, jint texID) {
     GLuint tID = (GLuint) texID;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
     if (tID != 0) {
         glDeleteTextures(1, &tID);
+        if (ctxInfo != NULL) {
+            invalidateTexture(ctxInfo, tID);
+        }
     }
 }
 
@@ -822,13 +1086,19 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nFinish
 /*
  * Class:     com_sun_prism_es2_GLContext
  * Method:    nGenAndBindTexture
- * Signature: ()I
+ * Signature: (J)I
  */
 JNIEXPORT jint JNICALL Java_com_sun_prism_es2_GLContext_nGenAndBindTexture
-(JNIEnv *env, jclass class) {
+(JNIEnv *env, jclass class, jlong nativeCtxInfo) {
     GLuint texID;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
     glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
+    if (ctxInfo == NULL) {
+        glBindTexture(GL_TEXTURE_2D, texID);
+        return texID;
+    }
+    invalidateTexture(ctxInfo, texID);
+    bindTexture2D(ctxInfo, texID);
     return texID;
 }
 
@@ -1079,6 +1349,185 @@ JNIEXPORT jboolean JNICALL Java_com_sun_prism_es2_GLContext_nReadPixelsInt
     return doReadPixels(env, nativeCtxInfo, length, buffer, pixelArr, x, y, w, h);
 }
 
+/*
+ * Maximum time nFinishReadPixelsAsync waits on the fence, in nanoseconds,
+ * before it falls back to glFinish
+ */
+#define READBACK_WAIT_TIMEOUT 1000000000
+
+static void deleteReadbackInfo(ContextInfo *ctxInfo, ReadbackInfo *rbInfo) {
+    if (rbInfo->fence != NULL) {
+        ctxInfo->glDeleteSync(rbInfo->fence);
+    }
+    if (rbInfo->pbo != 0) {
+        ctxInfo->glDeleteBuffers(1, &rbInfo->pbo);
+    }
+    free(rbInfo);
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nReadPixelsAsync
+ * Signature: (JIIII)J
+ */
+JNIEXPORT jlong JNICALL Java_com_sun_prism_es2_GLContext_nReadPixelsAsync
+(JNIEnv *env, jclass class, jlong nativeCtxInfo, jint x, jint y, jint width, jint height) {
+    ReadbackInfo *rbInfo;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    if ((ctxInfo == NULL) || (ctxInfo->glGenBuffers == NULL)
+            || (ctxInfo->glBindBuffer == NULL) || (ctxInfo->glBufferData == NULL)
+            || (ctxInfo->glDeleteBuffers == NULL)
+            || (ctxInfo->glMapBufferRange == NULL) || (ctxInfo->glUnmapBuffer == NULL)
+            || (ctxInfo->glFenceSync == NULL) || (ctxInfo->glClientWaitSync == NULL)
+            || (ctxInfo->glDeleteSync == NULL)) {
+        return 0;
+    }
+
+    if (width <= 0 || height <= 0) {
+        fprintf(stderr, "nReadPixelsAsync: width or height is <= 0\n");
+        return 0;
+    }
+
+    rbInfo = (ReadbackInfo *) calloc(1, sizeof (ReadbackInfo));
+    if (rbInfo == NULL) {
+        fprintf(stderr, "nReadPixelsAsync: Failed in calloc\n");
+        return 0;
+    }
+    rbInfo->width = (GLsizei) width;
+    rbInfo->height = (GLsizei) height;
+    rbInfo->format = ctxInfo->gl2 ? GL_BGRA : GL_RGBA;
+
+    ctxInfo->glGenBuffers(1, &rbInfo->pbo);
+    if (rbInfo->pbo == 0) {
+        free(rbInfo);
+        return 0;
+    }
+
+    // The read is queued into the buffer object and returns immediately
+    ctxInfo->glBindBuffer(GL_PIXEL_PACK_BUFFER, rbInfo->pbo);
+    ctxInfo->glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) width * height * 4,
+            NULL, GL_STREAM_READ);
+    glReadPixels((GLint) x, (GLint) y, (GLsizei) width, (GLsizei) height,
+            rbInfo->format, ctxInfo->gl2 ? GL_UNSIGNED_INT_8_8_8_8_REV : GL_UNSIGNED_BYTE,
+            (GLvoid *) 0);
+    ctxInfo->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    rbInfo->fence = ctxInfo->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (rbInfo->fence == NULL) {
+        deleteReadbackInfo(ctxInfo, rbInfo);
+        return 0;
+    }
+    // Make sure the fence is submitted so that polling it can succeed
+    glFlush();
+
+    return ptr_to_jlong(rbInfo);
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nIsReadPixelsDone
+ * Signature: (JJ)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_sun_prism_es2_GLContext_nIsReadPixelsDone
+(JNIEnv *env, jclass class, jlong nativeCtxInfo, jlong nativeReadback) {
+    GLenum status;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    ReadbackInfo *rbInfo = (ReadbackInfo *) jlong_to_ptr(nativeReadback);
+    if ((ctxInfo == NULL) || (rbInfo == NULL)) {
+        return JNI_TRUE;
+    }
+
+    status = ctxInfo->glClientWaitSync(rbInfo->fence, 0, 0);
+    return ((status == GL_ALREADY_SIGNALED) || (status == GL_CONDITION_SATISFIED))
+            ? JNI_TRUE : JNI_FALSE;
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nFinishReadPixelsAsync
+ * Signature: (JJILjava/nio/Buffer;Ljava/lang/Object;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_sun_prism_es2_GLContext_nFinishReadPixelsAsync
+(JNIEnv *env, jclass class, jlong nativeCtxInfo, jlong nativeReadback,
+        jint length, jobject buffer, jobject pixelArr) {
+    GLvoid *ptr = NULL;
+    GLvoid *src;
+    GLenum status;
+    jsize size;
+    jboolean result = JNI_FALSE;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    ReadbackInfo *rbInfo = (ReadbackInfo *) jlong_to_ptr(nativeReadback);
+    if ((ctxInfo == NULL) || (rbInfo == NULL)) {
+        return JNI_FALSE;
+    }
+
+    // sanity check, do we have enough memory
+    // length, width and height are non-negative
+    if ((length / 4 / rbInfo->width) < rbInfo->height) {
+        fprintf(stderr, "nFinishReadPixelsAsync: pixel buffer too small - length = %d\n",
+                (int) length);
+        deleteReadbackInfo(ctxInfo, rbInfo);
+        return JNI_FALSE;
+    }
+
+    status = ctxInfo->glClientWaitSync(rbInfo->fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+            READBACK_WAIT_TIMEOUT);
+    if ((status == GL_TIMEOUT_EXPIRED) || (status == GL_WAIT_FAILED)) {
+        // Slow GPU or unusable fence: wait for the read like glReadPixels
+        // would. Mapping the buffer below blocks until it is written anyway.
+        glFinish();
+    }
+
+    size = rbInfo->width * rbInfo->height * 4;
+    ctxInfo->glBindBuffer(GL_PIXEL_PACK_BUFFER, rbInfo->pbo);
+    src = ctxInfo->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (src != NULL) {
+        ptr = (GLvoid *) (pixelArr ?
+                ((char *) (*env)->GetPrimitiveArrayCritical(env, pixelArr, NULL)) :
+                ((char *) (*env)->GetDirectBufferAddress(env, buffer)));
+        if (ptr != NULL) {
+            memcpy(ptr, src, size);
+            if (rbInfo->format == GL_RGBA) {
+                jsize i;
+                GLubyte* c = (GLubyte*) ptr;
+                GLubyte temp;
+                for (i = 0; i < rbInfo->width * rbInfo->height; i++) {
+                    temp = c[0];
+                    c[0] = c[2];
+                    c[2] = temp;
+                    c += 4;
+                }
+            }
+            if (pixelArr != NULL) {
+                (*env)->ReleasePrimitiveArrayCritical(env, pixelArr, ptr, 0);
+            }
+            result = JNI_TRUE;
+        } else {
+            fprintf(stderr, "nFinishReadPixelsAsync: pixel buffer is NULL\n");
+        }
+        ctxInfo->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    ctxInfo->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    deleteReadbackInfo(ctxInfo, rbInfo);
+    return result;
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nDisposeReadPixelsAsync
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nDisposeReadPixelsAsync
+(JNIEnv *env, jclass class, jlong nativeCtxInfo, jlong nativeReadback) {
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    ReadbackInfo *rbInfo = (ReadbackInfo *) jlong_to_ptr(nativeReadback);
+    if ((ctxInfo == NULL) || (rbInfo == NULL)) {
+        return;
+    }
+    deleteReadbackInfo(ctxInfo, rbInfo);
+}
+
 /*
  * Class:     com_sun_prism_es2_GLContext
  * Method:    nScissorTest
@@ -1097,7 +1546,20 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nScissorTest
             glEnable(GL_SCISSOR_TEST);
             ctxInfo->state.scissorEnabled = JNI_TRUE;
         }
+        // The scissor box is kept by GL while the test is disabled
+        if (ctxInfo->state.stateCacheEnabled
+                && (ctxInfo->state.scissorBox[0] == x)
+                && (ctxInfo->state.scissorBox[1] == y)
+                && (ctxInfo->state.scissorBox[2] == w)
+                && (ctxInfo->state.scissorBox[3] == h)) {
+            ctxInfo->state.elidedCalls[com_sun_prism_es2_GLContext_STATECACHE_SCISSOR]++;
+            return;
+        }
         glScissor(x, y, w, h);
+        ctxInfo->state.scissorBox[0] = x;
+        ctxInfo->state.scissorBox[1] = y;
+        ctxInfo->state.scissorBox[2] = w;
+        ctxInfo->state.scissorBox[3] = h;
     } else if (ctxInfo->state.scissorEnabled) {
         glDisable(GL_SCISSOR_TEST);
         ctxInfo->state.scissorEnabled = JNI_FALSE;
@@ -1315,6 +1777,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform1f
     if (ctxInfo == NULL) {
         return;
     }
+    if (!uniformfChanged(ctxInfo, location, 1, v0, 0.0f, 0.0f, 0.0f)) {
+        return;
+    }
     ctxInfo->glUniform1f(location, v0);
 }
 
@@ -1330,6 +1795,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform2f
     if (ctxInfo == NULL) {
         return;
     }
+    if (!uniformfChanged(ctxInfo, location, 2, v0, v1, 0.0f, 0.0f)) {
+        return;
+    }
     ctxInfo->glUniform2f(location, v0, v1);
 }
 
@@ -1345,6 +1813,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform3f
     if (ctxInfo == NULL) {
         return;
     }
+    if (!uniformfChanged(ctxInfo, location, 3, v0, v1, v2, 0.0f)) {
+        return;
+    }
     ctxInfo->glUniform3f(location, v0, v1, v2);
 }
 
@@ -1360,6 +1831,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform4f
     if (ctxInfo == NULL) {
         return;
     }
+    if (!uniformfChanged(ctxInfo, location, 4, v0, v1, v2, v3)) {
+        return;
+    }
     ctxInfo->glUniform4f(location, v0, v1, v2, v3);
 }
 
@@ -1380,6 +1854,7 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform4fv0
         _ptr2 = (GLfloat *) (((char *) (*env)->GetDirectBufferAddress(env, value))
                 + valueByteOffset);
     }
+    invalidateUniforms(ctxInfo, location, count);
     ctxInfo->glUniform4fv((GLint) location, (GLsizei) count, (GLfloat *) _ptr2);
 }
 
@@ -1406,6 +1881,7 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform4fv1
         ptrPlusOffset = ptr + valueByteOffset;
 
     }
+    invalidateUniforms(ctxInfo, location, count);
     ctxInfo->glUniform4fv((GLint) location, (GLsizei) count, (GLfloat *) ptrPlusOffset);
     if (value != NULL) {
         (*env)->ReleasePrimitiveArrayCritical(env, value, ptr, 0);
@@ -1423,6 +1899,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform1i
     if ((ctxInfo == NULL) || (ctxInfo->glUniform1i == NULL)) {
         return;
     }
+    if (!uniformiChanged(ctxInfo, location, 1, v0, 0, 0, 0)) {
+        return;
+    }
     ctxInfo->glUniform1i(location, v0);
 }
 
@@ -1437,6 +1916,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform2i
     if ((ctxInfo == NULL) || (ctxInfo->glUniform2i == NULL)) {
         return;
     }
+    if (!uniformiChanged(ctxInfo, location, 2, v0, v1, 0, 0)) {
+        return;
+    }
     ctxInfo->glUniform2i(location, v0, v1);
 }
 
@@ -1452,6 +1934,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform3i
     if ((ctxInfo == NULL) || (ctxInfo->glUniform3i == NULL)) {
         return;
     }
+    if (!uniformiChanged(ctxInfo, location, 3, v0, v1, v2, 0)) {
+        return;
+    }
     ctxInfo->glUniform3i(location, v0, v1, v2);
 }
 
@@ -1467,6 +1952,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform4i
     if ((ctxInfo == NULL) || (ctxInfo->glUniform4i == NULL)) {
         return;
     }
+    if (!uniformiChanged(ctxInfo, location, 4, v0, v1, v2, v3)) {
+        return;
+    }
     ctxInfo->glUniform4i(location, v0, v1, v2, v3);
 }
 
@@ -1488,6 +1976,7 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform4iv0
         _ptr2 = (GLint *) (((char *) (*env)->GetDirectBufferAddress(env, value))
                 + valueByteOffset);
     }
+    invalidateUniforms(ctxInfo, location, count);
     ctxInfo->glUniform4iv((GLint) location, (GLsizei) count, (GLint *) _ptr2);
 }
 
@@ -1514,6 +2003,7 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniform4iv1
         }
         ptrPlusOffset = ptr + valueByteOffset;
     }
+    invalidateUniforms(ctxInfo, location, count);
     ctxInfo->glUniform4iv((GLint) location, (GLsizei) count, (GLint *) ptrPlusOffset);
     if (value != NULL) {
         (*env)->ReleasePrimitiveArrayCritical(env, value, ptr, 0);
@@ -1541,6 +2031,7 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUniformMatrix4fv
             return;
         }
     }
+    invalidateUniforms(ctxInfo, location, 1);
     ctxInfo->glUniformMatrix4fv((GLint) location, 1, (GLboolean) transpose, _ptr);
 
     if (_ptr) (*env)->ReleasePrimitiveArrayCritical(env, values, _ptr, JNI_ABORT);
@@ -1584,7 +2075,58 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nUseProgram
     if ((ctxInfo == NULL) || (ctxInfo->glUseProgram == NULL)) {
         return;
     }
+    if (ctxInfo->state.stateCacheEnabled && (ctxInfo->state.program == (GLuint) pID)) {
+        ctxInfo->state.elidedCalls[com_sun_prism_es2_GLContext_STATECACHE_PROGRAM]++;
+        return;
+    }
     ctxInfo->glUseProgram(pID);
+    ctxInfo->state.program = (GLuint) pID;
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nSetStateCacheEnabled
+ * Signature: (JZ)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nSetStateCacheEnabled
+(JNIEnv *env, jclass class, jlong nativeCtxInfo, jboolean enabled) {
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    if (ctxInfo == NULL) {
+        return;
+    }
+    if (enabled && !ctxInfo->state.stateCacheEnabled) {
+        if (!registerCachingContext(ctxInfo)) {
+            // Deletions could not reach this context's shadow state
+            return;
+        }
+        // State may have changed behind our back while disabled
+        resetStateCache(ctxInfo);
+    } else if (!enabled) {
+        unregisterCachingContext(ctxInfo);
+    }
+    ctxInfo->state.stateCacheEnabled = enabled;
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nGetStateCacheCounters
+ * Signature: (J[IZ)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nGetStateCacheCounters
+(JNIEnv *env, jclass class, jlong nativeCtxInfo, jintArray counters, jboolean reset) {
+    jsize length;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    if ((ctxInfo == NULL) || (counters == NULL)) {
+        return;
+    }
+    length = (*env)->GetArrayLength(env, counters);
+    if (length > STATE_CACHE_NUM_COUNTERS) {
+        length = STATE_CACHE_NUM_COUNTERS;
+    }
+    (*env)->SetIntArrayRegion(env, counters, 0, length, ctxInfo->state.elidedCalls);
+    if (reset) {
+        memset(ctxInfo->state.elidedCalls, 0, sizeof (ctxInfo->state.elidedCalls));
+    }
 }
 
 /*
@@ -1680,6 +2222,116 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nDrawIndexedQuads
     if (pFloat) (*env)->ReleasePrimitiveArrayCritical(env, dataf, pFloat, JNI_ABORT);
 }
 
+/* Initial size of the streaming vertex buffer, grown on demand */
+#define STREAM_VBO_INITIAL_SIZE (1024 * 1024)
+/* Offsets into the streaming vertex buffer are kept 16 byte aligned */
+#define STREAM_VBO_ALIGN(n) (((n) + 15) & ~((GLintptr) 15))
+
+/*
+ * Reserve size bytes in the streaming vertex buffer and return the offset
+ * of the reserved range, or -1 if the buffer could not be created.
+ * When the buffer is full its storage is orphaned with a NULL glBufferData
+ * so the driver can hand out fresh memory without waiting for the GPU to
+ * finish with the batches that are still in flight.
+ * The streaming buffer is left bound to GL_ARRAY_BUFFER.
+ */
+static GLintptr reserveStreamVbo(ContextInfo *ctx, GLsizeiptr size) {
+    GLintptr offset;
+
+    if (ctx->streamVbo == 0) {
+        ctx->glGenBuffers(1, &ctx->streamVbo);
+        if (ctx->streamVbo == 0) {
+            return -1;
+        }
+        ctx->streamVboSize = 0;
+    }
+    ctx->glBindBuffer(GL_ARRAY_BUFFER, ctx->streamVbo);
+    ctx->boundMeshInfo = NULL;
+
+    if (size > ctx->streamVboSize) {
+        GLsizeiptr newSize = ctx->streamVboSize > 0
+                ? ctx->streamVboSize : STREAM_VBO_INITIAL_SIZE;
+        while (newSize < size) {
+            newSize *= 2;
+        }
+        ctx->glBufferData(GL_ARRAY_BUFFER, newSize, NULL, GL_STREAM_DRAW);
+        ctx->streamVboSize = newSize;
+        ctx->streamVboOffset = 0;
+    } else if (ctx->streamVboOffset + size > ctx->streamVboSize) {
+        ctx->glBufferData(GL_ARRAY_BUFFER, ctx->streamVboSize, NULL, GL_STREAM_DRAW);
+        ctx->streamVboOffset = 0;
+    }
+
+    offset = ctx->streamVboOffset;
+    ctx->streamVboOffset = STREAM_VBO_ALIGN(offset + size);
+    return offset;
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nDrawIndexedQuadsBuffered
+ * Signature: (JILjava/nio/FloatBuffer;Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nDrawIndexedQuadsBuffered
+  (JNIEnv *env, jclass class, jlong nativeCtxInfo, jint numVertices,
+   jobject dataf, jobject datab)
+{
+    float *pFloat;
+    char *pByte;
+    GLsizeiptr floatSize, byteSize;
+    GLintptr floatOffset, byteOffset;
+    int numQuads = numVertices / 4;
+
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    if ((ctxInfo == NULL) || (ctxInfo->glVertexAttribPointer == NULL)) {
+        return;
+    }
+
+    pFloat = (float *)(*env)->GetDirectBufferAddress(env, dataf);
+    pByte = (char *)(*env)->GetDirectBufferAddress(env, datab);
+    if ((pFloat == NULL) || (pByte == NULL)) {
+        return;
+    }
+
+    if ((ctxInfo->glGenBuffers == NULL) || (ctxInfo->glBindBuffer == NULL) ||
+            (ctxInfo->glBufferData == NULL) || (ctxInfo->glBufferSubData == NULL)) {
+        // No buffer object support, draw straight from the direct buffers
+        setVertexAttributePointers(ctxInfo, pFloat, pByte);
+        glDrawElements(GL_TRIANGLES, numQuads * 2 * 3, GL_UNSIGNED_SHORT, 0);
+        return;
+    }
+
+    floatSize = (GLsizeiptr) coordStride * numVertices;
+    byteSize = (GLsizeiptr) colorStride * numVertices;
+    floatOffset = reserveStreamVbo(ctxInfo, STREAM_VBO_ALIGN(floatSize) + byteSize);
+    if (floatOffset < 0) {
+        setVertexAttributePointers(ctxInfo, pFloat, pByte);
+        glDrawElements(GL_TRIANGLES, numQuads * 2 * 3, GL_UNSIGNED_SHORT, 0);
+        return;
+    }
+    byteOffset = floatOffset + STREAM_VBO_ALIGN(floatSize);
+
+    ctxInfo->glBufferSubData(GL_ARRAY_BUFFER, floatOffset, floatSize, pFloat);
+    ctxInfo->glBufferSubData(GL_ARRAY_BUFFER, byteOffset, byteSize, pByte);
+
+    ctxInfo->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, coordStride,
+            (const GLvoid *) floatOffset);
+    ctxInfo->glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, coordStride,
+            (const GLvoid *) (floatOffset + sizeof(float) * FLOATS_PER_VC));
+    ctxInfo->glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, coordStride,
+            (const GLvoid *) (floatOffset + sizeof(float) * (FLOATS_PER_VC + FLOATS_PER_TC)));
+    ctxInfo->glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, colorStride,
+            (const GLvoid *) byteOffset);
+
+    glDrawElements(GL_TRIANGLES, numQuads * 2 * 3, GL_UNSIGNED_SHORT, 0);
+
+    // The attribute pointers now refer to the streaming buffer; unbind it so
+    // client side arrays work again and invalidate the cached pointers.
+    ctxInfo->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    ctxInfo->vbFloatData = NULL;
+    ctxInfo->vbByteData = NULL;
+}
+
 /*
  * Class:     com_sun_prism_es2_GLContext
  * Method:    nCreateIndexBuffer16
@@ -1701,6 +2353,7 @@ JNIEXPORT jint JNICALL Java_com_sun_prism_es2_GLContext_nCreateIndexBuffer16
     if (pData) {
         ctxInfo->glGenBuffers(1, &id);
         if (id) {
+            ctxInfo->boundMeshInfo = NULL;
             ctxInfo->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
             ctxInfo->glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(short) * n, pData, GL_STATIC_DRAW);
         }
@@ -1722,6 +2375,7 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nSetIndexBuffer
         return;
     }
     ctxInfo->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+    ctxInfo->boundMeshInfo = NULL;
 }
 
 JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nSetDeviceParametersFor2D
@@ -1740,12 +2394,13 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nSetDeviceParametersFor2
     ctxInfo->glDisableVertexAttribArray(VC_3D_INDEX);
     ctxInfo->glDisableVertexAttribArray(NC_3D_INDEX);
     ctxInfo->glDisableVertexAttribArray(TC_3D_INDEX);
+    ctxInfo->boundMeshInfo = NULL;
 
     ctxInfo->vbFloatData = NULL;
     ctxInfo->vbByteData = NULL;
 
     glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    setBlendFunc(ctxInfo, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     if (ctxInfo->state.scissorEnabled) {
         ctxInfo->state.scissorEnabled = JNI_FALSE;
@@ -1776,10 +2431,13 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nSetDeviceParametersFor3
     }
     // Note: projViewTx and camPos are handled above in the Java layer
 
+    // The 2D vertex attributes have just been disabled by the Java layer
+    ctxInfo->boundMeshInfo = NULL;
+
     // This setting matches 2D ((1,1-alpha); premultiplied alpha case.
     // Will need to evaluate when support proper 3D blending (alpha,1-alpha).
     glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    setBlendFunc(ctxInfo, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     if (ctxInfo->state.scissorEnabled) {
         ctxInfo->state.scissorEnabled = JNI_FALSE;
@@ -1849,6 +2507,9 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nReleaseES2Mesh
     // TODO: 3D - Native clean up. Need to determine do we have to free what
     //            is held by ES2MeshInfo.
     ctxInfo->glDeleteBuffers(MESH_MAX_BUFFERS, (GLuint *) (meshInfo->vboIDArray));
+    if (ctxInfo->boundMeshInfo == meshInfo) {
+        ctxInfo->boundMeshInfo = NULL;
+    }
     free(meshInfo);
 }
 
@@ -1909,6 +2570,7 @@ JNIEXPORT jboolean JNICALL Java_com_sun_prism_es2_GLContext_nBuildNativeGeometry
         // Unbind VBOs
         ctxInfo->glBindBuffer(GL_ARRAY_BUFFER, 0);
         ctxInfo->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        ctxInfo->boundMeshInfo = NULL;
     }
 
     if (indexBuffer) {
@@ -1978,6 +2640,7 @@ JNIEXPORT jboolean JNICALL Java_com_sun_prism_es2_GLContext_nBuildNativeGeometry
         // Unbind VBOs
         ctxInfo->glBindBuffer(GL_ARRAY_BUFFER, 0);
         ctxInfo->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        ctxInfo->boundMeshInfo = NULL;
     }
 
     if (indexBuffer) {
@@ -2311,59 +2974,171 @@ JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nSetLight
 }
 
 /*
- * Class:     com_sun_prism_es2_GLContext
- * Method:    nRenderMeshView
- * Signature: (JJ)V
+ * Sets up the cull and fill modes and the vertex state of the mesh view for
+ * drawing. Returns JNI_FALSE if the mesh view cannot be drawn.
  */
-JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nRenderMeshView
-  (JNIEnv *env, jclass class, jlong nativeCtxInfo, jlong nativeMeshViewInfo)
-{
+static jboolean setupMeshView(ContextInfo *ctxInfo, MeshViewInfo *mvInfo) {
     GLuint offset = 0;
     MeshInfo *mInfo;
-    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
-    MeshViewInfo *mvInfo = (MeshViewInfo *) jlong_to_ptr(nativeMeshViewInfo);
     if ((ctxInfo == NULL) || (mvInfo == NULL) ||
             (ctxInfo->glBindBuffer == NULL) ||
             (ctxInfo->glBufferData == NULL) ||
             (ctxInfo->glDisableVertexAttribArray == NULL) ||
             (ctxInfo->glEnableVertexAttribArray == NULL) ||
             (ctxInfo->glVertexAttribPointer == NULL)) {
-        return;
+        return JNI_FALSE;
     }
 
     if ((mvInfo->phongMaterialInfo == NULL) || (mvInfo->meshInfo == NULL)) {
-        return;
+        return JNI_FALSE;
     }
 
     setCullMode(ctxInfo, mvInfo);
     setPolyonMode(ctxInfo, mvInfo);
 
-    // Draw triangles ...
     mInfo = mvInfo->meshInfo;
-    ctxInfo->glBindBuffer(GL_ARRAY_BUFFER, mInfo->vboIDArray[MESH_VERTEXBUFFER]);
-    ctxInfo->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mInfo->vboIDArray[MESH_INDEXBUFFER]);
-
-    ctxInfo->glEnableVertexAttribArray(VC_3D_INDEX);
-    ctxInfo->glEnableVertexAttribArray(TC_3D_INDEX);
-    ctxInfo->glEnableVertexAttribArray(NC_3D_INDEX);
-
-    ctxInfo->glVertexAttribPointer(VC_3D_INDEX, VC_3D_SIZE, GL_FLOAT, GL_FALSE,
-            VERT_3D_STRIDE, (const GLvoid *) jlong_to_ptr((jlong) offset));
-    offset += VC_3D_SIZE * sizeof(GLfloat);
-    ctxInfo->glVertexAttribPointer(TC_3D_INDEX, TC_3D_SIZE, GL_FLOAT, GL_FALSE,
-            VERT_3D_STRIDE, (const GLvoid *) jlong_to_ptr((jlong) offset));
-    offset += TC_3D_SIZE * sizeof(GLfloat);
-    ctxInfo->glVertexAttribPointer(NC_3D_INDEX, NC_3D_SIZE, GL_FLOAT, GL_FALSE,
-            VERT_3D_STRIDE, (const GLvoid *) jlong_to_ptr((jlong) offset));
 
+    // MeshViews sharing a mesh are commonly rendered back to back, so the
+    // buffers and vertex attributes are left set up after the draw and only
+    // respecified when a different mesh is rendered. Anything else that
+    // touches the array or element buffer bindings resets boundMeshInfo.
+    if (ctxInfo->boundMeshInfo != mInfo) {
+        ctxInfo->glBindBuffer(GL_ARRAY_BUFFER, mInfo->vboIDArray[MESH_VERTEXBUFFER]);
+        ctxInfo->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mInfo->vboIDArray[MESH_INDEXBUFFER]);
+
+        if (ctxInfo->boundMeshInfo == NULL) {
+            ctxInfo->glEnableVertexAttribArray(VC_3D_INDEX);
+            ctxInfo->glEnableVertexAttribArray(TC_3D_INDEX);
+            ctxInfo->glEnableVertexAttribArray(NC_3D_INDEX);
+        }
+
+        ctxInfo->glVertexAttribPointer(VC_3D_INDEX, VC_3D_SIZE, GL_FLOAT, GL_FALSE,
+                VERT_3D_STRIDE, (const GLvoid *) jlong_to_ptr((jlong) offset));
+        offset += VC_3D_SIZE * sizeof(GLfloat);
+        ctxInfo->glVertexAttribPointer(TC_3D_INDEX, TC_3D_SIZE, GL_FLOAT, GL_FALSE,
+                VERT_3D_STRIDE, (const GLvoid *) jlong_to_ptr((jlong) offset));
+        offset += TC_3D_SIZE * sizeof(GLfloat);
+        ctxInfo->glVertexAttribPointer(NC_3D_INDEX, NC_3D_SIZE, GL_FLOAT, GL_FALSE,
+                VERT_3D_STRIDE, (const GLvoid *) jlong_to_ptr((jlong) offset));
+
+        ctxInfo->boundMeshInfo = mInfo;
+    }
+    return JNI_TRUE;
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nRenderMeshView
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nRenderMeshView
+  (JNIEnv *env, jclass class, jlong nativeCtxInfo, jlong nativeMeshViewInfo)
+{
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    MeshViewInfo *mvInfo = (MeshViewInfo *) jlong_to_ptr(nativeMeshViewInfo);
+    if (!setupMeshView(ctxInfo, mvInfo)) {
+        return;
+    }
+
+    // Draw triangles ...
     glDrawElements(GL_TRIANGLES, mvInfo->meshInfo->indexBufferSize,
             mvInfo->meshInfo->indexBufferType, 0);
+}
 
-    // Reset states
-    ctxInfo->glDisableVertexAttribArray(VC_3D_INDEX);
-    ctxInfo->glDisableVertexAttribArray(NC_3D_INDEX);
-    ctxInfo->glDisableVertexAttribArray(TC_3D_INDEX);
-    ctxInfo->glBindBuffer(GL_ARRAY_BUFFER, 0);
-    ctxInfo->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nIsInstancingSupported
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_sun_prism_es2_GLContext_nIsInstancingSupported
+  (JNIEnv *env, jclass class, jlong nativeCtxInfo)
+{
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    if ((ctxInfo == NULL) || (ctxInfo->glDrawElementsInstanced == NULL)
+            || (ctxInfo->glVertexAttribDivisor == NULL)
+            || (ctxInfo->glGenBuffers == NULL) || (ctxInfo->glDeleteBuffers == NULL)) {
+        return JNI_FALSE;
+    }
+    // The entry points may be exported by the GL library even though the
+    // context does not implement them, so check what the context reports
+    if ((ctxInfo->versionNumbers[0] > 3)
+            || ((ctxInfo->versionNumbers[0] == 3) && (ctxInfo->versionNumbers[1] >= 3))) {
+        return JNI_TRUE;
+    }
+    return (isExtensionSupported(ctxInfo->glExtensionStr, "GL_ARB_instanced_arrays")
+            || isExtensionSupported(ctxInfo->glExtensionStr, "GL_EXT_instanced_arrays")
+            || isExtensionSupported(ctxInfo->glExtensionStr, "GL_ANGLE_instanced_arrays"))
+            ? JNI_TRUE : JNI_FALSE;
+}
+
+/*
+ * Class:     com_sun_prism_es2_GLContext
+ * Method:    nRenderMeshViewInstanced
+ * Signature: (JJ[FI)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_prism_es2_GLContext_nRenderMeshViewInstanced
+  (JNIEnv *env, jclass class, jlong nativeCtxInfo, jlong nativeMeshViewInfo,
+   jfloatArray worldMatrices, jint numInstances)
+{
+    int i;
+    GLsizeiptr size;
+    GLfloat *matrices;
+    ContextInfo *ctxInfo = (ContextInfo *) jlong_to_ptr(nativeCtxInfo);
+    MeshViewInfo *mvInfo = (MeshViewInfo *) jlong_to_ptr(nativeMeshViewInfo);
+    if ((worldMatrices == NULL) || (numInstances <= 0)
+            || (ctxInfo == NULL) || (ctxInfo->glDrawElementsInstanced == NULL)
+            || (ctxInfo->glVertexAttribDivisor == NULL)
+            || (ctxInfo->glGenBuffers == NULL)) {
+        return;
+    }
+    if ((*env)->GetArrayLength(env, worldMatrices) < numInstances * 16) {
+        return;
+    }
+    if (!setupMeshView(ctxInfo, mvInfo)) {
+        return;
+    }
+
+    if (ctxInfo->instanceVbo == 0) {
+        ctxInfo->glGenBuffers(1, &ctxInfo->instanceVbo);
+        if (ctxInfo->instanceVbo == 0) {
+            return;
+        }
+    }
+
+    // Orphan the previous contents so that uploading does not wait for the
+    // draws still using them
+    size = (GLsizeiptr) numInstances * WM_3D_STRIDE;
+    matrices = (GLfloat *) (*env)->GetPrimitiveArrayCritical(env, worldMatrices, NULL);
+    if (matrices == NULL) {
+        return;
+    }
+    ctxInfo->glBindBuffer(GL_ARRAY_BUFFER, ctxInfo->instanceVbo);
+    if (size > ctxInfo->instanceVboSize) {
+        ctxInfo->glBufferData(GL_ARRAY_BUFFER, size, matrices, GL_STREAM_DRAW);
+        ctxInfo->instanceVboSize = size;
+    } else {
+        ctxInfo->glBufferData(GL_ARRAY_BUFFER, ctxInfo->instanceVboSize, NULL, GL_STREAM_DRAW);
+        ctxInfo->glBufferSubData(GL_ARRAY_BUFFER, 0, size, matrices);
+    }
+    (*env)->ReleasePrimitiveArrayCritical(env, worldMatrices, matrices, JNI_ABORT);
+
+    for (i = 0; i < WM_3D_COLUMNS; i++) {
+        ctxInfo->glEnableVertexAttribArray(WM_3D_INDEX + i);
+        ctxInfo->glVertexAttribPointer(WM_3D_INDEX + i, 4, GL_FLOAT, GL_FALSE,
+                WM_3D_STRIDE, (const GLvoid *) jlong_to_ptr((jlong) (i * 4 * sizeof(GLfloat))));
+        ctxInfo->glVertexAttribDivisor(WM_3D_INDEX + i, 1);
+    }
+
+    ctxInfo->glDrawElementsInstanced(GL_TRIANGLES, mvInfo->meshInfo->indexBufferSize,
+            mvInfo->meshInfo->indexBufferType, 0, numInstances);
+
+    // Leave the instance attributes as the other draw paths expect them,
+    // and the mesh vertex buffer bound as recorded in boundMeshInfo
+    for (i = 0; i < WM_3D_COLUMNS; i++) {
+        ctxInfo->glVertexAttribDivisor(WM_3D_INDEX + i, 0);
+        ctxInfo->glDisableVertexAttribArray(WM_3D_INDEX + i);
+    }
+    ctxInfo->glBindBuffer(GL_ARRAY_BUFFER,
+            mvInfo->meshInfo->vboIDArray[MESH_VERTEXBUFFER]);
 }
 
@@ -194,6 +194,28 @@ struct DrawableInfoRec {
 #endif /* __APPLE__ */
 };
 
+/* Sizes of the shadow state tables */
+#define STATE_CACHE_MAX_TEXTURE_UNITS 16
+#define STATE_CACHE_UNIFORM_SLOTS 256
+
+/* Number of elided call counters, one per STATECACHE_* category */
+#define STATE_CACHE_NUM_COUNTERS com_sun_prism_es2_GLContext_STATECACHE_NUM_COUNTERS
+
+/* Typedef for cached uniform value struct */
+typedef struct UniformCacheEntryRec UniformCacheEntry;
+
+/* define the structure to hold the last value uploaded to a uniform */
+struct UniformCacheEntryRec {
+    GLuint program;
+    GLint location;
+    GLenum type;     /* GL_FLOAT or GL_INT, 0 for an unused entry */
+    GLint size;      /* number of components (1 - 4) */
+    union {
+        GLfloat f[4];
+        GLint i[4];
+    } value;
+};
+
 /* Typedef for state properties struct */
 typedef struct StateInfoRec StateInfo;
 
@@ -212,6 +234,22 @@ struct StateInfoRec {
 
     /* Currently bound fbo */
     GLuint fbo;
+
+    /*
+     * Shadow copies of GL state used to elide redundant calls coming
+     * from Java. Only consulted when stateCacheEnabled is set.
+     */
+    jboolean stateCacheEnabled;
+    GLuint activeTexUnit;
+    GLuint boundTextures[STATE_CACHE_MAX_TEXTURE_UNITS];
+    GLuint program;
+    GLenum blendSrc;
+    GLenum blendDst;
+    GLint scissorBox[4];
+    /* Uniform values belong to the share group, see GLContext.c */
+
+    /* Number of calls elided by the cache, indexed by STATECACHE_* */
+    jint elidedCalls[STATE_CACHE_NUM_COUNTERS];
 };
 
 /* Typedef for context properties struct */
@@ -318,6 +356,17 @@ struct ContextInfoRec {
     PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC glRenderbufferStorageMultisample;
     PFNGLBLITFRAMEBUFFERPROC glBlitFramebuffer;
 
+    /* Optional, used for asynchronous pixel readback when available */
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+
+    /* Optional, used for instanced MeshView rendering when available */
+    PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced;
+    PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
+
     /* For state caching */
     StateInfo state;
 
@@ -328,6 +377,21 @@ struct ContextInfoRec {
     char  *vbByteData;
     jboolean gl2;
 
+    /*
+     * Mesh whose buffers and vertex attributes are currently set up for
+     * nRenderMeshView, NULL if the 3D vertex state must be set up again
+     */
+    struct MeshInfoRec *boundMeshInfo;
+
+    /* Streaming vertex buffer used by nDrawIndexedQuadsBuffered */
+    GLuint streamVbo;
+    GLsizeiptr streamVboSize;
+    GLintptr streamVboOffset;
+
+    /* Per instance world matrices used by nRenderMeshViewInstanced */
+    GLuint instanceVbo;
+    GLsizeiptr instanceVboSize;
+
     /* Caching properties passed down from Java */
     jboolean vSyncRequested;
 };
@@ -346,11 +410,14 @@ extern void deletePixelFormatInfo(PixelFormatInfo *pfInfo);
 #define VC_3D_INDEX 0
 #define TC_3D_INDEX 1
 #define NC_3D_INDEX 2
+#define WM_3D_INDEX 3 /* instance world matrix, one column per location */
 #define VC_3D_SIZE 3  /* x, y, z */
 #define TC_3D_SIZE 2  /* tu, tv */
 #define NC_3D_SIZE 4  /* nx, ny, nz, nw */
 #define VERT_3D_SIZE (VC_3D_SIZE + TC_3D_SIZE + NC_3D_SIZE)
 #define VERT_3D_STRIDE (sizeof(GLfloat) * VERT_3D_SIZE)
+#define WM_3D_COLUMNS 4
+#define WM_3D_STRIDE (sizeof(GLfloat) * 16)
 
 #define MESH_VERTEXBUFFER 0
 #define MESH_INDEXBUFFER 1
@@ -391,6 +458,18 @@ struct MeshViewInfoRec {
     GLenum fillMode;
 };
 
+/* Typedef for asynchronous pixel readback struct */
+typedef struct ReadbackInfoRec ReadbackInfo;
+
+/* define the structure to hold a pending glReadPixels into a pixel buffer object */
+struct ReadbackInfoRec {
+    GLuint pbo;
+    GLsync fence;
+    GLsizei width;
+    GLsizei height;
+    GLenum format;   /* GL_BGRA, or GL_RGBA if red and blue must be swapped */
+};
+
 /*
  * General purpose assertion macro
  */
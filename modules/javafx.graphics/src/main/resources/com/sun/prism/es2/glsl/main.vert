@@ -24,7 +24,13 @@
  */
 
 uniform mat4 viewProjectionMatrix;
+#ifdef INSTANCED
+// One world matrix per instance, see GLContext.renderMeshViewInstanced
+attribute mat4 instanceWorldMatrix;
+#define worldMatrix instanceWorldMatrix
+#else
 uniform mat4 worldMatrix;
+#endif
 uniform vec3 camPos;
 uniform vec3 ambientColor;
 
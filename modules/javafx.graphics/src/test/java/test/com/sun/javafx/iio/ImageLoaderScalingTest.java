@@ -26,12 +26,16 @@
 package test.com.sun.javafx.iio;
 
 import com.sun.javafx.iio.ImageFrame;
+import com.sun.javafx.iio.ImageLoadListener;
+import com.sun.javafx.iio.ImageLoader;
+import com.sun.javafx.iio.ImageMetadata;
 import com.sun.javafx.iio.ImageStorage;
 import com.sun.prism.Image;
 import java.awt.image.BufferedImage;
 import java.io.ByteArrayInputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.lang.reflect.Field;
 import static org.junit.Assert.*;
 import org.junit.Test;
 
@@ -188,4 +192,109 @@ public class ImageLoaderScalingTest {
     public void testRT20295_GIF() throws Exception {
         testScale("gif", 100, 62, 100, 78);
     }
+
+    // Returns the size of the image as returned by the JPEG decompressor,
+    // before the final downscale done by JPEGImageLoader.
+    private int[] getDecodedSize(InputStream stream, int width, int height,
+            boolean preserveAspectRatio) throws Exception
+    {
+        ImageLoader[] loaderRef = new ImageLoader[1];
+        ImageLoadListener listener = new ImageLoadListener() {
+            @Override
+            public void imageLoadProgress(ImageLoader loader, float percentageComplete) {
+                loaderRef[0] = loader;
+            }
+
+            @Override
+            public void imageLoadWarning(ImageLoader loader, String message) {
+            }
+
+            @Override
+            public void imageLoadMetaData(ImageLoader loader, ImageMetadata metadata) {
+            }
+        };
+        ImageFrame[] imgFrames = ImageStorage.loadAll(stream, listener,
+                width, height, preserveAspectRatio, 1.0f, true);
+        assertNotNull(imgFrames);
+        assertEquals(1, imgFrames.length);
+        if (width > 0 && height > 0 && !preserveAspectRatio) {
+            assertEquals(width, imgFrames[0].getWidth());
+            assertEquals(height, imgFrames[0].getHeight());
+        }
+        assertNotNull(loaderRef[0]);
+        return new int[] {
+            getIntField(loaderRef[0], "outWidth"),
+            getIntField(loaderRef[0], "outHeight")
+        };
+    }
+
+    private static int getIntField(Object obj, String name) throws Exception {
+        Field field = obj.getClass().getDeclaredField(name);
+        field.setAccessible(true);
+        return field.getInt(obj);
+    }
+
+    private void testDecodedSizeJPG(int dstW, int dstH, boolean preserveAspectRatio,
+            int decodedW, int decodedH) throws Exception
+    {
+        BufferedImage bImg = new BufferedImage(800, 600, BufferedImage.TYPE_INT_RGB);
+        ImageTestHelper.drawImageGradient(bImg);
+        ByteArrayInputStream in = ImageTestHelper.writeImageToStream(bImg, "jpg", null);
+        int[] decoded = getDecodedSize(in, dstW, dstH, preserveAspectRatio);
+        assertEquals("decoded width for " + dstW + "x" + dstH, decodedW, decoded[0]);
+        assertEquals("decoded height for " + dstW + "x" + dstH, decodedH, decoded[1]);
+    }
+
+    @Test
+    public void testDecodedSizeJPG() throws Exception {
+        // No downscale, or an upscale, decodes the full image
+        testDecodedSizeJPG(0, 0, false, 800, 600);
+        testDecodedSizeJPG(800, 600, false, 800, 600);
+        testDecodedSizeJPG(1600, 1200, false, 800, 600);
+
+        // The target size is an exact M/8 scale
+        testDecodedSizeJPG(100, 75, false, 100, 75);
+        testDecodedSizeJPG(300, 225, false, 300, 225);
+        testDecodedSizeJPG(700, 525, false, 700, 525);
+
+        // The smallest M/8 scale that still covers the target size
+        testDecodedSizeJPG(240, 180, false, 300, 225);
+        testDecodedSizeJPG(101, 75, false, 200, 150);
+        testDecodedSizeJPG(60, 45, false, 100, 75);
+        testDecodedSizeJPG(701, 526, false, 800, 600);
+
+        // The larger of the two scales wins
+        testDecodedSizeJPG(100, 300, false, 400, 300);
+        testDecodedSizeJPG(500, 30, false, 500, 375);
+
+        // Scales are computed on the dimensions after preserving the ratio
+        testDecodedSizeJPG(240, 1000, true, 300, 225);
+    }
+
+    @Test
+    public void testMN8ScaleJPG() throws Exception {
+        // A JPEG decoded at an M/8 scale other than a power of two and then
+        // downscaled still matches the full decode, within the JPEG error.
+        BufferedImage bImg = new BufferedImage(800, 600, BufferedImage.TYPE_INT_RGB);
+        ImageTestHelper.drawImageGradient(bImg);
+        ByteArrayInputStream in = ImageTestHelper.writeImageToStream(bImg, "jpg", null);
+        Image expectedImg = loadImage(in, 0, 0);
+        in.reset();
+        Image img = loadImage(in, 240, 180);
+        assertEquals(240, img.getWidth());
+        assertEquals(180, img.getHeight());
+        for (int y = 0; y < 180; y += 10) {
+            for (int x = 0; x < 240; x += 10) {
+                int expected = expectedImg.getArgb((int) ((x + 0.5) * 800 / 240),
+                                                   (int) ((y + 0.5) * 600 / 180));
+                int actual = img.getArgb(x, y);
+                for (int shift = 0; shift < 24; shift += 8) {
+                    int diff = ((expected >> shift) & 0xff) - ((actual >> shift) & 0xff);
+                    assertTrue("pixel " + x + ", " + y + ": " +
+                               String.format("0x%08X != 0x%08X", expected, actual),
+                               Math.abs(diff) <= 8);
+                }
+            }
+        }
+    }
 }
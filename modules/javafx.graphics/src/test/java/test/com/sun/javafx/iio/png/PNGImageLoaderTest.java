@@ -25,13 +25,23 @@
 
 package test.com.sun.javafx.iio.png;
 
+import com.sun.javafx.iio.ImageFrame;
 import com.sun.javafx.iio.png.PNGImageLoader2;
 import test.com.sun.javafx.iio.ImageTestHelper;
 import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.zip.CRC32;
+import java.util.zip.DeflaterOutputStream;
 import org.junit.Test;
 
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+
 public class PNGImageLoaderTest {
 
     private void testImage(InputStream stream) throws IOException {
@@ -76,4 +86,325 @@ public class PNGImageLoaderTest {
         ByteArrayInputStream stream = ImageTestHelper.constructStreamFromInts(corruptedIDATLength);
         testImage(stream);
     }
+
+    private static final int COLOR_GRAY = 0;
+    private static final int COLOR_RGB = 2;
+    private static final int COLOR_PALETTE = 3;
+    private static final int COLOR_RGB_ALPHA = 6;
+
+    private static final int[] STARTING_Y = {0, 0, 4, 0, 2, 0, 1};
+    private static final int[] STARTING_X = {0, 4, 0, 2, 0, 1, 0};
+    private static final int[] INCREMENT_Y = {8, 8, 8, 4, 4, 2, 2};
+    private static final int[] INCREMENT_X = {8, 8, 4, 4, 2, 2, 1};
+
+    private static void writeChunk(DataOutputStream out, String type, byte[] data) throws IOException {
+        byte[] typeBytes = type.getBytes(StandardCharsets.US_ASCII);
+        CRC32 crc = new CRC32();
+        crc.update(typeBytes);
+        crc.update(data);
+        out.writeInt(data.length);
+        out.write(typeBytes);
+        out.write(data);
+        out.writeInt((int) crc.getValue());
+    }
+
+    private static int paethPredictor(int a, int b, int c) {
+        int pa = Math.abs(b - c);
+        int pb = Math.abs(a - c);
+        int pc = Math.abs(b - c + a - c);
+        return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+    }
+
+    // Filters a row with the given filter type, bpp is the number of bytes
+    // per complete pixel, or 1 for bit depths below 8
+    private static byte[] filterRow(byte[] row, byte[] prev, int filter, int bpp) {
+        byte[] out = new byte[row.length];
+        for (int i = 0; i < row.length; i++) {
+            int x = row[i] & 0xFF;
+            int a = i >= bpp ? row[i - bpp] & 0xFF : 0;
+            int b = prev[i] & 0xFF;
+            int c = i >= bpp ? prev[i - bpp] & 0xFF : 0;
+            switch (filter) {
+                case 1: x -= a; break;
+                case 2: x -= b; break;
+                case 3: x -= (a + b) / 2; break;
+                case 4: x -= paethPredictor(a, b, c); break;
+            }
+            out[i] = (byte) x;
+        }
+        return out;
+    }
+
+    // Appends the rows of the given pixels, packing samples of less than
+    // 8 bits into bytes most significant bits first
+    private static void writeRows(ByteArrayOutputStream out, int[][] pixels, int width,
+                                  int bitDepth, int filter, int x0, int y0, int dx, int dy, int height)
+    {
+        byte[] prev = null;
+        for (int y = y0; y < height; y += dy) {
+            ByteArrayOutputStream row = new ByteArrayOutputStream();
+            int acc = 0, bits = 0, samples = 0;
+            for (int x = x0; x < width; x += dx) {
+                samples = pixels[y * width + x].length;
+                for (int sample : pixels[y * width + x]) {
+                    if (bitDepth == 16) {
+                        row.write(sample >> 8);
+                        row.write(sample);
+                        continue;
+                    }
+                    acc = (acc << bitDepth) | sample;
+                    bits += bitDepth;
+                    if (bits == 8) {
+                        row.write(acc);
+                        acc = 0;
+                        bits = 0;
+                    }
+                }
+            }
+            if (bits != 0) {
+                row.write(acc << (8 - bits));
+            }
+            byte[] bytes = row.toByteArray();
+            if (prev == null) {
+                prev = new byte[bytes.length];
+            }
+            out.write(filter);
+            out.writeBytes(filterRow(bytes, prev, filter, Math.max(1, samples * bitDepth / 8)));
+            prev = bytes;
+        }
+    }
+
+    private static InputStream createPNG(int width, int height, int bitDepth, int colorType,
+                                         boolean interlaced, byte[] plte, byte[] trns,
+                                         int[][] pixels) throws IOException
+    {
+        return createPNG(width, height, bitDepth, colorType, interlaced, plte, trns, pixels, 0);
+    }
+
+    private static InputStream createPNG(int width, int height, int bitDepth, int colorType,
+                                         boolean interlaced, byte[] plte, byte[] trns,
+                                         int[][] pixels, int filter) throws IOException
+    {
+        ByteArrayOutputStream raw = new ByteArrayOutputStream();
+        if (interlaced) {
+            for (int pass = 0; pass < 7; pass++) {
+                if (width > STARTING_X[pass] && height > STARTING_Y[pass]) {
+                    writeRows(raw, pixels, width, bitDepth, filter, STARTING_X[pass], STARTING_Y[pass],
+                              INCREMENT_X[pass], INCREMENT_Y[pass], height);
+                }
+            }
+        } else {
+            writeRows(raw, pixels, width, bitDepth, filter, 0, 0, 1, 1, height);
+        }
+        ByteArrayOutputStream idat = new ByteArrayOutputStream();
+        try (DeflaterOutputStream deflater = new DeflaterOutputStream(idat)) {
+            deflater.write(raw.toByteArray());
+        }
+
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        DataOutputStream out = new DataOutputStream(bytes);
+        out.write(new byte[] {(byte) 137, 80, 78, 71, 13, 10, 26, 10});
+        ByteBuffer ihdr = ByteBuffer.allocate(13);
+        ihdr.putInt(width).putInt(height).put((byte) bitDepth).put((byte) colorType)
+            .put((byte) 0).put((byte) 0).put((byte) (interlaced ? 1 : 0));
+        writeChunk(out, "IHDR", ihdr.array());
+        if (plte != null) {
+            writeChunk(out, "PLTE", plte);
+        }
+        if (trns != null) {
+            writeChunk(out, "tRNS", trns);
+        }
+        writeChunk(out, "IDAT", idat.toByteArray());
+        writeChunk(out, "IEND", new byte[0]);
+        return new ByteArrayInputStream(bytes.toByteArray());
+    }
+
+    private static byte[] decode(InputStream stream, int bpp) throws IOException {
+        ImageFrame frame = new PNGImageLoader2(stream).load(0, 0, 0, true, true);
+        assertEquals(bpp * frame.getWidth(), frame.getStride());
+        return ((ByteBuffer) frame.getImageData()).array();
+    }
+
+    // A palette of distinct colors, entry i is (i * 16, 255 - i * 16, i)
+    private static byte[] createPalette(int size) {
+        byte[] plte = new byte[size * 3];
+        for (int i = 0; i < size; i++) {
+            plte[i * 3] = (byte) (i * 16);
+            plte[i * 3 + 1] = (byte) (255 - i * 16);
+            plte[i * 3 + 2] = (byte) i;
+        }
+        return plte;
+    }
+
+    private static int[][] createIndices(int width, int height, int paletteSize) {
+        int[][] pixels = new int[width * height][];
+        for (int i = 0; i < pixels.length; i++) {
+            pixels[i] = new int[] {(i * 7 + i / width) % paletteSize};
+        }
+        return pixels;
+    }
+
+    private static byte[] expandPalette(int[][] pixels, byte[] plte, byte[] trns) {
+        int bpp = trns == null ? 3 : 4;
+        byte[] expected = new byte[pixels.length * bpp];
+        for (int i = 0; i < pixels.length; i++) {
+            int index = pixels[i][0];
+            expected[i * bpp] = plte[index * 3];
+            expected[i * bpp + 1] = plte[index * 3 + 1];
+            expected[i * bpp + 2] = plte[index * 3 + 2];
+            if (trns != null) {
+                // Entries past the end of tRNS are opaque
+                expected[i * bpp + 3] = index < trns.length ? trns[index] : (byte) 255;
+            }
+        }
+        return expected;
+    }
+
+    @Test
+    public void testPalette() throws IOException {
+        // Widths that do not fill the last byte of a row
+        for (int bitDepth : new int[] {1, 2, 4, 8}) {
+            int paletteSize = Math.min(1 << bitDepth, 16);
+            byte[] plte = createPalette(paletteSize);
+            int[][] pixels = createIndices(13, 5, paletteSize);
+            byte[] data = decode(createPNG(13, 5, bitDepth, COLOR_PALETTE, false, plte, null, pixels), 3);
+            assertArrayEquals("bit depth " + bitDepth, expandPalette(pixels, plte, null), data);
+        }
+    }
+
+    @Test
+    public void testPaletteTRNS() throws IOException {
+        byte[] plte = createPalette(16);
+        // Shorter than the palette
+        byte[] trns = {0, (byte) 128, 64};
+        int[][] pixels = createIndices(11, 6, 16);
+        byte[] data = decode(createPNG(11, 6, 4, COLOR_PALETTE, false, plte, trns, pixels), 4);
+        assertArrayEquals(expandPalette(pixels, plte, trns), data);
+    }
+
+    @Test
+    public void testGrayTRNS() throws IOException {
+        int width = 9, height = 4;
+        for (int bitDepth : new int[] {2, 8}) {
+            int maxV = (1 << bitDepth) - 1;
+            int transparent = maxV / 2;
+            int[][] pixels = new int[width * height][];
+            byte[] expected = new byte[width * height * 2];
+            for (int i = 0; i < pixels.length; i++) {
+                int v = (i * 5) % (maxV + 1);
+                pixels[i] = new int[] {v};
+                expected[i * 2] = (byte) ((v * 255 + maxV / 2) / maxV);
+                expected[i * 2 + 1] = v == transparent ? 0 : (byte) 255;
+            }
+            byte[] trns = {0, (byte) transparent};
+            byte[] data = decode(createPNG(width, height, bitDepth, COLOR_GRAY, false, null, trns, pixels), 2);
+            assertArrayEquals("bit depth " + bitDepth, expected, data);
+        }
+    }
+
+    @Test
+    public void testRGBTRNS() throws IOException {
+        int width = 7, height = 3;
+        int[][] pixels = new int[width * height][];
+        byte[] expected = new byte[width * height * 4];
+        for (int i = 0; i < pixels.length; i++) {
+            pixels[i] = (i % 3 == 0) ? new int[] {10, 20, 30} : new int[] {i, 2 * i + 1, 3 * i};
+            expected[i * 4] = (byte) pixels[i][0];
+            expected[i * 4 + 1] = (byte) pixels[i][1];
+            expected[i * 4 + 2] = (byte) pixels[i][2];
+            expected[i * 4 + 3] = (i % 3 == 0) ? 0 : (byte) 255;
+        }
+        byte[] trns = {0, 10, 0, 20, 0, 30};
+        byte[] data = decode(createPNG(width, height, 8, COLOR_RGB, false, null, trns, pixels), 4);
+        assertArrayEquals(expected, data);
+    }
+
+    @Test
+    public void testInterlacedPalette() throws IOException {
+        // Small enough that some passes are empty
+        for (int[] size : new int[][] {{1, 1}, {3, 2}, {11, 9}, {17, 13}}) {
+            byte[] plte = createPalette(4);
+            byte[] trns = {(byte) 200};
+            int[][] pixels = createIndices(size[0], size[1], 4);
+            byte[] data = decode(createPNG(size[0], size[1], 2, COLOR_PALETTE, true, plte, trns, pixels), 4);
+            assertArrayEquals(size[0] + "x" + size[1], expandPalette(pixels, plte, trns), data);
+        }
+    }
+
+    @Test
+    public void testInterlacedRGB() throws IOException {
+        int width = 10, height = 11;
+        int[][] pixels = new int[width * height][];
+        for (int i = 0; i < pixels.length; i++) {
+            pixels[i] = new int[] {i % 256, (i * 3) % 256, (i * 7) % 256};
+        }
+        byte[] interlaced = decode(createPNG(width, height, 8, COLOR_RGB, true, null, null, pixels), 3);
+        byte[] progressive = decode(createPNG(width, height, 8, COLOR_RGB, false, null, null, pixels), 3);
+        assertArrayEquals(progressive, interlaced);
+        assertEquals((byte) 13, interlaced[13 * 3]);
+    }
+
+    private static int[][] createSamples(int width, int height, int bands, int bitDepth) {
+        int maxV = (1 << bitDepth) - 1;
+        int[][] pixels = new int[width * height][];
+        for (int i = 0; i < pixels.length; i++) {
+            pixels[i] = new int[bands];
+            for (int b = 0; b < bands; b++) {
+                // Smooth and noisy areas, so that every predictor is used
+                int v = (i % 5 == 0) ? i * 31 + b * 97 + (i * i) % 251 : i * 3 + b * 40;
+                pixels[i][b] = (v * 257) & maxV;
+            }
+        }
+        return pixels;
+    }
+
+    @Test
+    public void testFilters() throws IOException {
+        // 1, 2, 3, 4, 6 and 8 bytes per pixel, and widths around the
+        // 16 byte blocks of the native Up filter
+        int[][] formats = {
+            {COLOR_GRAY, 1, 8, 1}, {COLOR_GRAY, 1, 16, 1}, {COLOR_RGB, 3, 8, 3},
+            {COLOR_RGB_ALPHA, 4, 8, 4}, {COLOR_RGB, 3, 16, 3}, {COLOR_RGB_ALPHA, 4, 16, 4}
+        };
+        for (int[] format : formats) {
+            int colorType = format[0], bands = format[1], bitDepth = format[2], bpp = format[3];
+            for (int width : new int[] {1, 5, 16, 17, 33}) {
+                int height = 6;
+                int[][] pixels = createSamples(width, height, bands, bitDepth);
+                byte[] expected = decode(createPNG(width, height, bitDepth, colorType, false,
+                                                   null, null, pixels), bpp);
+                for (int filter = 1; filter <= 4; filter++) {
+                    byte[] data = decode(createPNG(width, height, bitDepth, colorType, false,
+                                                   null, null, pixels, filter), bpp);
+                    assertArrayEquals("color type " + colorType + ", bit depth " + bitDepth
+                            + ", width " + width + ", filter " + filter, expected, data);
+                }
+            }
+        }
+    }
+
+    @Test
+    public void testFiltersInterlaced() throws IOException {
+        int width = 19, height = 13;
+        int[][] pixels = createSamples(width, height, 4, 8);
+        byte[] expected = decode(createPNG(width, height, 8, COLOR_RGB_ALPHA, true,
+                                           null, null, pixels), 4);
+        for (int filter = 1; filter <= 4; filter++) {
+            byte[] data = decode(createPNG(width, height, 8, COLOR_RGB_ALPHA, true,
+                                           null, null, pixels, filter), 4);
+            assertArrayEquals("filter " + filter, expected, data);
+        }
+    }
+
+    @Test
+    public void testFiltersPalette() throws IOException {
+        // Rows of packed indices are filtered with one byte per pixel
+        byte[] plte = createPalette(4);
+        int[][] pixels = createIndices(23, 7, 4);
+        byte[] expected = expandPalette(pixels, plte, null);
+        for (int filter = 1; filter <= 4; filter++) {
+            byte[] data = decode(createPNG(23, 7, 2, COLOR_PALETTE, false, plte, null, pixels, filter), 3);
+            assertArrayEquals("filter " + filter, expected, data);
+        }
+    }
 }
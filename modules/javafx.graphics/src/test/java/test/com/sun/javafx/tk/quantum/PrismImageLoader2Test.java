@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.javafx.tk.quantum;
+
+import com.sun.javafx.tk.quantum.PrismImageLoader2Shim;
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+public class PrismImageLoader2Test {
+
+    // 12x12 and 24x24 images, requested at equal sizes below so that their
+    // decoded pixels take the same number of bytes
+    private static final String CHECKER = url("checker.png");
+    private static final String CHECKER_2X = url("checker@2x.png");
+
+    private static String url(String name) {
+        return PrismImageLoader2Test.class
+                .getResource("/test/com/sun/javafx/iio/" + name).toExternalForm();
+    }
+
+    private static long imageBytes(String url, double width, double height) {
+        Object cache = PrismImageLoader2Shim.createCache(Long.MAX_VALUE);
+        PrismImageLoader2Shim.load(cache, url, width, height);
+        return PrismImageLoader2Shim.getCacheSize(cache);
+    }
+
+    @Test
+    public void testCacheOffByDefault() {
+        assertFalse(PrismImageLoader2Shim.isDefaultCacheEnabled());
+        Object first = PrismImageLoader2Shim.load(CHECKER, 0, 0);
+        Object second = PrismImageLoader2Shim.load(CHECKER, 0, 0);
+        assertNotSame(first, second);
+    }
+
+    @Test
+    public void testCacheHit() {
+        Object cache = PrismImageLoader2Shim.createCache(Long.MAX_VALUE);
+        Object first = PrismImageLoader2Shim.load(cache, CHECKER, 0, 0);
+        Object second = PrismImageLoader2Shim.load(cache, CHECKER, 0, 0);
+        assertSame(first, second);
+        assertTrue(PrismImageLoader2Shim.getCacheSize(cache) > 0);
+
+        // A different requested size is a different entry
+        Object scaled = PrismImageLoader2Shim.load(cache, CHECKER, 8, 8);
+        assertNotSame(first, scaled);
+    }
+
+    @Test
+    public void testLeastRecentlyUsedIsEvicted() {
+        long small = imageBytes(CHECKER, 8, 8);
+        Object cache = PrismImageLoader2Shim.createCache(2 * small);
+
+        Object a = PrismImageLoader2Shim.load(cache, CHECKER, 8, 8);
+        Object b = PrismImageLoader2Shim.load(cache, CHECKER_2X, 8, 8);
+        // Use a, so that b is the least recently used entry
+        assertSame(a, PrismImageLoader2Shim.load(cache, CHECKER, 8, 8));
+
+        // No room for a third image, b has to go
+        PrismImageLoader2Shim.load(cache, CHECKER, 4, 4);
+        assertTrue(PrismImageLoader2Shim.getCacheSize(cache) <= 2 * small);
+        assertSame(a, PrismImageLoader2Shim.load(cache, CHECKER, 8, 8));
+        assertNotSame(b, PrismImageLoader2Shim.load(cache, CHECKER_2X, 8, 8));
+    }
+
+    @Test
+    public void testImageLargerThanCacheIsNotCached() {
+        long bytes = imageBytes(CHECKER, 0, 0);
+        Object cache = PrismImageLoader2Shim.createCache(bytes - 1);
+        Object first = PrismImageLoader2Shim.load(cache, CHECKER, 0, 0);
+        assertEquals(0, PrismImageLoader2Shim.getCacheSize(cache));
+        assertNotSame(first, PrismImageLoader2Shim.load(cache, CHECKER, 0, 0));
+    }
+
+    @Test
+    public void testNetworkLoadsUseTheirOwnPool() {
+        assertTrue(PrismImageLoader2Shim.isLocal(CHECKER));
+        assertTrue(PrismImageLoader2Shim.isLocal("jar:file:/app.jar!/image.png"));
+        assertFalse(PrismImageLoader2Shim.isLocal("http://example.com/image.png"));
+        assertFalse(PrismImageLoader2Shim.isLocal("jar:http://example.com/app.jar!/image.png"));
+    }
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.prism.impl;
+
+import com.sun.glass.ui.Pixels;
+import com.sun.prism.impl.QueuedPixelSource;
+import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+public class QueuedPixelSourceTest {
+
+    private static final int WIDTH = 100;
+    private static final int HEIGHT = 80;
+
+    private QueuedPixelSource source;
+
+    @Before
+    public void setUp() {
+        source = new QueuedPixelSource(false);
+    }
+
+    @Test
+    public void newPixelsAreFullyDamaged() {
+        assertTrue(newPixels().isFullyDamaged());
+    }
+
+    @Test
+    public void setDamageClipsToBounds() {
+        Pixels p = newPixels();
+        p.setDamage(-10, 70, 30, 30);
+        assertDamage(p, 0, 70, 20, 10);
+
+        p.setDamage(90, -5, 30, 10);
+        assertDamage(p, 90, 0, 10, 5);
+    }
+
+    @Test
+    public void addDamageUnitesRectangles() {
+        Pixels p = damaged(10, 10, 10, 10);
+        p.addDamage(damaged(50, 40, 5, 5));
+        assertDamage(p, 10, 10, 45, 35);
+    }
+
+    @Test
+    public void addDamageIgnoresEmptyDamage() {
+        Pixels p = damaged(10, 10, 10, 10);
+        p.addDamage(damaged(50, 40, 0, 0));
+        assertDamage(p, 10, 10, 10, 10);
+
+        Pixels empty = damaged(0, 0, 0, 0);
+        empty.addDamage(damaged(5, 6, 7, 8));
+        assertDamage(empty, 5, 6, 7, 8);
+    }
+
+    @Test
+    public void addDamageOfFullyDamagedPixelsDamagesAll() {
+        Pixels p = damaged(10, 10, 10, 10);
+        p.addDamage(newPixels());
+        assertTrue(p.isFullyDamaged());
+
+        p = newPixels();
+        p.addDamage(damaged(10, 10, 10, 10));
+        assertTrue(p.isFullyDamaged());
+    }
+
+    @Test
+    public void addDamageOfDifferentSizeDamagesAll() {
+        Pixels p = damaged(10, 10, 10, 10);
+        Pixels other = new TestPixels(WIDTH / 2, HEIGHT);
+        other.setDamage(0, 0, 5, 5);
+        p.addDamage(other);
+        assertTrue(p.isFullyDamaged());
+    }
+
+    @Test
+    public void replacedPixelsDamageIsMerged() {
+        source.enqueuePixels(damaged(0, 0, 10, 10));
+        Pixels latest = damaged(90, 70, 10, 10);
+        source.enqueuePixels(latest);
+
+        assertSame(latest, source.getLatestPixels());
+        assertDamage(latest, 0, 0, 100, 80);
+        source.doneWithPixels(latest);
+    }
+
+    @Test
+    public void consumedPixelsDamageIsNotMerged() {
+        Pixels first = damaged(0, 0, 10, 10);
+        source.enqueuePixels(first);
+        assertSame(first, source.getLatestPixels());
+        source.doneWithPixels(first);
+
+        Pixels second = damaged(50, 50, 10, 10);
+        source.enqueuePixels(second);
+        assertSame(second, source.getLatestPixels());
+        assertDamage(second, 50, 50, 10, 10);
+        source.doneWithPixels(second);
+    }
+
+    @Test
+    public void pixelsAfterSkippedDeliveryAreFullyDamaged() {
+        source.enqueuePixels(damaged(0, 0, 10, 10));
+        source.skipLatestPixels();
+        assertNull(source.getLatestPixels());
+
+        Pixels next = damaged(50, 50, 10, 10);
+        source.enqueuePixels(next);
+        assertTrue(next.isFullyDamaged());
+
+        // Only the delivery right after the skipped one is affected
+        assertSame(next, source.getLatestPixels());
+        source.doneWithPixels(next);
+        Pixels last = damaged(50, 50, 10, 10);
+        source.enqueuePixels(last);
+        assertDamage(last, 50, 50, 10, 10);
+    }
+
+    @Test
+    public void skipWithNothingEnqueuedKeepsDamage() {
+        source.skipLatestPixels();
+
+        Pixels next = damaged(50, 50, 10, 10);
+        source.enqueuePixels(next);
+        assertDamage(next, 50, 50, 10, 10);
+    }
+
+    private static Pixels newPixels() {
+        return new TestPixels(WIDTH, HEIGHT);
+    }
+
+    private static Pixels damaged(int x, int y, int w, int h) {
+        Pixels p = newPixels();
+        p.setDamage(x, y, w, h);
+        return p;
+    }
+
+    private static void assertDamage(Pixels p, int x, int y, int w, int h) {
+        assertFalse("fully damaged", p.isFullyDamaged());
+        assertEquals("damage x", x, p.getDamageX());
+        assertEquals("damage y", y, p.getDamageY());
+        assertEquals("damage width", w, p.getDamageWidth());
+        assertEquals("damage height", h, p.getDamageHeight());
+    }
+
+    private static final class TestPixels extends Pixels {
+        TestPixels(int width, int height) {
+            super(width, height, IntBuffer.allocate(width * height));
+        }
+
+        @Override protected void _fillDirectByteBuffer(ByteBuffer bb) { }
+        @Override protected void _attachInt(long ptr, int w, int h, IntBuffer ints, int[] array, int offset) { }
+        @Override protected void _attachByte(long ptr, int w, int h, ByteBuffer bytes, byte[] array, int offset) { }
+    }
+}
@@ -87,6 +87,25 @@ public abstract class ConnectionHolder {
         return channel.read(buffer);
     }
 
+    /**
+     * Reads a block of data from the current position of the opened stream
+     * directly into {@code target}, which is usually native memory owned by
+     * the media pipeline. At most {@code target.remaining()} bytes are read.
+     *
+     * @return The number of bytes read, possibly zero, or -1 if the channel
+     * has reached end-of-stream.
+     *
+     * @throws ClosedChannelException if an attempt is made to read after
+     * closeConnection has been called
+     */
+    public int readNextBlock(ByteBuffer target) throws IOException {
+        // avoid NPE if channel does not exist or has been closed
+        if (null == channel) {
+            throw new ClosedChannelException();
+        }
+        return channel.read(target);
+    }
+
     public ByteBuffer getBuffer() {
         return buffer;
     }
@@ -102,6 +121,27 @@ public abstract class ConnectionHolder {
      */
     abstract int readBlock(long position, int size) throws IOException;
 
+    /**
+     * Reads a block of data from the arbitrary position of the opened stream
+     * directly into {@code target}. At most {@code target.remaining()} bytes
+     * are read.
+     *
+     * @return The number of bytes read, possibly zero, or -1 if the given position
+     * is greater than or equal to the file's current size.
+     *
+     * @throws ClosedChannelException if an attempt is made to read after
+     * closeConnection has been called
+     */
+    int readBlock(long position, ByteBuffer target) throws IOException {
+        int read = readBlock(position, target.remaining());
+        if (read > 0) {
+            ByteBuffer data = buffer.duplicate();
+            data.rewind().limit(read);
+            target.put(data);
+        }
+        return read;
+    }
+
     /**
      * Detects whether this source needs buffering at the pipeline level.
      * When true the pipeline contains progressbuffer after the source.
@@ -208,6 +248,14 @@ public abstract class ConnectionHolder {
             return ((FileChannel)channel).read(buffer, position);
         }
 
+        @Override
+        int readBlock(long position, ByteBuffer target) throws IOException {
+            if (null == channel) {
+                throw new ClosedChannelException();
+            }
+            return ((FileChannel)channel).read(target, position);
+        }
+
         private ReadableByteChannel openFile(final URI uri) throws IOException {
             if (file != null) {
                 file.close();
@@ -431,6 +479,27 @@ public abstract class ConnectionHolder {
             return actual;
         }
 
+        @Override
+        int readBlock(long position, ByteBuffer target) throws IOException {
+            // mimic stream behavior
+            if (null == channel) {
+                throw new ClosedChannelException();
+            }
+
+            if ((int)position > backingBuffer.capacity()) {
+                return -1; //EOS
+            }
+            backingBuffer.position((int)position);
+
+            int actual = Math.min(backingBuffer.remaining(), target.remaining());
+            ByteBuffer data = backingBuffer.slice();
+            data.limit(actual);
+            target.put(data);
+            backingBuffer.position(backingBuffer.position() + actual);
+
+            return actual;
+        }
+
         @Override
         boolean needBuffer() {
             return false;
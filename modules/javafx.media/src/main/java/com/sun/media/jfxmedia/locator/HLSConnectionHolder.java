@@ -30,6 +30,7 @@ import java.io.BufferedReader;
 import java.io.IOException;
 import java.io.InputStreamReader;
 import java.net.*;
+import java.nio.ByteBuffer;
 import java.nio.channels.Channels;
 import java.nio.channels.ReadableByteChannel;
 import java.nio.charset.Charset;
@@ -73,11 +74,23 @@ final class HLSConnectionHolder extends ConnectionHolder {
 
     @Override
     public int readNextBlock() throws IOException {
+        startReadTimer();
+        return stopReadTimer(super.readNextBlock());
+    }
+
+    @Override
+    public int readNextBlock(ByteBuffer target) throws IOException {
+        startReadTimer();
+        return stopReadTimer(super.readNextBlock(target));
+    }
+
+    private void startReadTimer() {
         if (isBitrateAdjustable && startTime == -1) {
             startTime = System.currentTimeMillis();
         }
+    }
 
-        int read = super.readNextBlock();
+    private int stopReadTimer(int read) {
         if (isBitrateAdjustable && read == -1) {
             long readTime = System.currentTimeMillis() - startTime;
             startTime = -1;
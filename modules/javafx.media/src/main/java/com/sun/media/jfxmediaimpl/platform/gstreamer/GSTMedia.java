@@ -31,6 +31,8 @@ import com.sun.media.jfxmedia.locator.Locator;
 import com.sun.media.jfxmediaimpl.MediaUtils;
 import com.sun.media.jfxmediaimpl.NativeMedia;
 import com.sun.media.jfxmediaimpl.platform.Platform;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
 
 /**
  * GStreamer implementation of Media
@@ -46,6 +48,31 @@ final class GSTMedia extends NativeMedia {
      */
     protected long refNativeMedia;
 
+    /**
+     * Number of video decoding threads, from the jfxmedia.decoderThreads
+     * property. 0, the default, uses one thread per CPU core.
+     */
+    private static final int decoderThreads;
+
+    /**
+     * Bytes of downloaded media kept by the progress buffer, from the
+     * jfxmedia.cacheBudget property in megabytes. 0, the default, keeps
+     * everything that has been downloaded.
+     */
+    private static final long cacheBudget;
+
+    static {
+        @SuppressWarnings("removal")
+        Integer threads = AccessController.doPrivileged(
+                (PrivilegedAction<Integer>) () -> Integer.getInteger("jfxmedia.decoderThreads", 0));
+        decoderThreads = Math.max(0, threads);
+
+        @SuppressWarnings("removal")
+        Long budget = AccessController.doPrivileged(
+                (PrivilegedAction<Long>) () -> Long.getLong("jfxmedia.cacheBudget", 0L));
+        cacheBudget = Math.max(0L, budget) * 1024 * 1024;
+    }
+
     GSTMedia(Locator locator) {
         super(locator);
 
@@ -64,7 +91,7 @@ final class GSTMedia extends NativeMedia {
         Locator loc = getLocator();
         ret = MediaError.getFromCode(gstInitNativeMedia(loc,
                 loc.getContentType(), loc.getContentLength(),
-                nativeMediaHandle));
+                decoderThreads, cacheBudget, nativeMediaHandle));
         if (ret != MediaError.ERROR_NONE && ret != MediaError.ERROR_PLATFORM_UNSUPPORTED) {
             MediaUtils.nativeError(this, ret);
         }
@@ -92,6 +119,8 @@ final class GSTMedia extends NativeMedia {
     private native int gstInitNativeMedia(Locator locator,
                                                String contentType,
                                                long sizeHint,
+                                               int decoderThreads,
+                                               long cacheBudget,
                                                long[] nativeMediaHandle);
     private native void gstDispose(long refNativeMedia);
 }
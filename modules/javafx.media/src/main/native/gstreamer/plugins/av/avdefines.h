@@ -50,5 +50,13 @@
 // Do not call avcodec_register_all() and av_register_all()
 // Not required since 58 and removed in 59
 #define NO_REGISTER_ALL        (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59,0,0))
+
+// Decode into our own buffers through "get_buffer2" and refcounted AVBuffers,
+// both available since 55.28.0
+#define DIRECT_RENDERING       (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(55,28,0))
+
+// "thread_safe_callbacks" must be set for a custom "get_buffer2" to be called
+// from frame threads. Deprecated in 58 and removed in 59.
+#define THREAD_SAFE_CALLBACKS  (LIBAVCODEC_VERSION_INT < AV_VERSION_INT(59,0,0))
 #endif  /* AVDEFINES_H */
 
@@ -73,6 +73,7 @@ GType basedecoder_get_type (void)
 
 static void basedecoder_init(BaseDecoder *self)
 {
+    self->thread_count = 1;
 }
 
 static void basedecoder_class_init(BaseDecoderClass *g_class)
@@ -122,6 +123,12 @@ gboolean basedecoder_open_decoder(BaseDecoder *decoder, CodecIDType id)
 
         if (result)
         {
+            // Let libavcodec pick frame and/or slice threading, whatever
+            // the codec supports. Frame threading delays the output by
+            // one frame per thread, see the EOS handling of the decoders.
+            decoder->context->thread_count = decoder->thread_count;
+            decoder->context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
             basedecoder_init_context(decoder);
 
             int ret = avcodec_open2(decoder->context, decoder->codec, NULL);
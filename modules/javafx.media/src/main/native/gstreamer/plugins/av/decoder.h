@@ -56,6 +56,8 @@ struct _BaseDecoder
 
     gboolean      is_hls;
 
+    gint          thread_count;      // libavcodec decoding threads, 0 for one per core
+
     guint8        *codec_data;       // codec-specific data
     gint          codec_data_size;   // number of bytes of codec-specific data
 
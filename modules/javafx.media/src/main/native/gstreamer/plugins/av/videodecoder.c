@@ -66,6 +66,17 @@ static GstStaticPadTemplate source_template =
 //#define DEBUG_OUTPUT
 //#define VERBOSE_DEBUG
 
+enum
+{
+    PROP_0,
+    PROP_THREAD_COUNT
+};
+
+#define MAX_THREAD_COUNT 64
+
+// Alignment of the planes of directly rendered frames, enough for AVX-512
+#define PLANE_ALIGN 64
+
 /***********************************************************************************
  * Substitution for
  * G_DEFINE_TYPE(VideoDecoder, videodecoder, BaseDecoder, TYPE_BASEDECODER);
@@ -105,6 +116,12 @@ GType videodecoder_get_type (void)
 static GstStateChangeReturn videodecoder_change_state(GstElement* element, GstStateChange transition);
 static gboolean             videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent *event);
 static GstFlowReturn        videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffer *buf);
+static void                 videodecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+static void                 videodecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void                 videodecoder_drain(VideoDecoder *decoder);
+static void                 videodecoder_finalize(GObject *object);
+static void                 videodecoder_init_context(BaseDecoder *base);
+static void                 videodecoder_free_pool(VideoDecoder *decoder);
 
 static void                 videodecoder_init_state(VideoDecoder *decoder);
 static void                 videodecoder_state_reset(VideoDecoder *decoder);
@@ -113,6 +130,7 @@ static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps
 
 static void videodecoder_class_init(VideoDecoderClass *klass)
 {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
     GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
 
     gst_element_class_set_metadata(element_class,
@@ -127,6 +145,21 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
             gst_static_pad_template_get(&sink_template));
 
     element_class->change_state = videodecoder_change_state;
+
+    gobject_class->set_property = videodecoder_set_property;
+    gobject_class->get_property = videodecoder_get_property;
+    gobject_class->finalize = videodecoder_finalize;
+
+    BASEDECODER_CLASS(klass)->init_context = videodecoder_init_context;
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_COUNT,
+                                     g_param_spec_int ("thread-count",
+                                                       "Thread count",
+                                                       "Number of decoding threads, 0 for one per CPU core. Takes effect when the decoder is opened.",
+                                                       0  /* minimum value */,
+                                                       MAX_THREAD_COUNT /* maximum value */,
+                                                       0  /* default value */,
+                                                       G_PARAM_READWRITE));
 }
 
 static void videodecoder_init(VideoDecoder *decoder)
@@ -143,6 +176,53 @@ static void videodecoder_init(VideoDecoder *decoder)
     base->srcpad = gst_pad_new_from_static_template(&source_template, "src");
     gst_pad_use_fixed_caps(base->srcpad);
     gst_element_add_pad(GST_ELEMENT(decoder), base->srcpad);
+
+    base->thread_count = 0;
+
+    decoder->direct_rendering = FALSE;
+    decoder->direct_pool.pool = NULL;
+    decoder->direct_pool.buffer_size = 0;
+    decoder->copy_pool.pool = NULL;
+    decoder->copy_pool.buffer_size = 0;
+    g_mutex_init(&decoder->pool_lock);
+}
+
+static void videodecoder_finalize(GObject *object)
+{
+    VideoDecoder *decoder = VIDEODECODER(object);
+
+    videodecoder_free_pool(decoder);
+    g_mutex_clear(&decoder->pool_lock);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void videodecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    BaseDecoder *base = BASEDECODER(object);
+    switch (property_id)
+    {
+        case PROP_THREAD_COUNT:
+            base->thread_count = g_value_get_int(value);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void videodecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    BaseDecoder *base = BASEDECODER(object);
+    switch (property_id)
+    {
+        case PROP_THREAD_COUNT:
+            g_value_set_int(value, base->thread_count);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
 }
 
 
@@ -176,6 +256,7 @@ videodecoder_change_state(GstElement* element, GstStateChange transition)
     {
         case GST_STATE_CHANGE_PAUSED_TO_READY:
             basedecoder_close_decoder(BASEDECODER(decoder));
+            videodecoder_free_pool(decoder);
             break;
         default:
             break;
@@ -208,6 +289,11 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
             BASEDECODER(decoder)->is_flushing = FALSE;
             break;
 
+        case GST_EVENT_EOS:
+            // Output the frames held back by frame threading and reordering.
+            videodecoder_drain(decoder);
+            break;
+
         case GST_EVENT_CAPS:
         {
             GstCaps *caps;
@@ -257,11 +343,13 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
 static void videodecoder_init_state(VideoDecoder *decoder)
 {
     decoder->width = decoder->height = 0;
+    decoder->y_offset = 0;
     decoder->u_offset = 0;
     decoder->v_offset = 0;
     decoder->uv_blocksize = 0;
     decoder->frame_size = 0;
     decoder->discont = FALSE;
+    decoder->direct_rendering = FALSE;
 
     basedecoder_init_state(BASEDECODER(decoder));
 }
@@ -295,6 +383,192 @@ static void videodecoder_state_reset(VideoDecoder *decoder)
     basedecoder_flush(BASEDECODER(decoder));
 }
 
+/***********************************************************************************
+ * Output buffer pool and direct rendering
+ ***********************************************************************************/
+static void videodecoder_release_pool(VideoDecoderPool *pool)
+{
+    if (pool->pool)
+    {
+        // Buffers still in use downstream are freed when they are released.
+        gst_buffer_pool_set_active(pool->pool, FALSE);
+        gst_object_unref(pool->pool);
+        pool->pool = NULL;
+    }
+    pool->buffer_size = 0;
+}
+
+static void videodecoder_free_pool(VideoDecoder *decoder)
+{
+    g_mutex_lock(&decoder->pool_lock);
+    videodecoder_release_pool(&decoder->direct_pool);
+    videodecoder_release_pool(&decoder->copy_pool);
+    g_mutex_unlock(&decoder->pool_lock);
+}
+
+/*
+ * Direct and copied frames come from separate pools, since their sizes
+ * differ and alternating between them would recreate a shared pool.
+ */
+static GstBuffer* videodecoder_acquire_buffer(VideoDecoder *decoder, VideoDecoderPool *pool, gsize size)
+{
+    GstBuffer *buffer = NULL;
+
+    g_mutex_lock(&decoder->pool_lock);
+    if (pool->pool == NULL || pool->buffer_size != size)
+    {
+        videodecoder_release_pool(pool);
+
+        pool->pool = gst_buffer_pool_new();
+        if (pool->pool)
+        {
+            GstStructure *config = gst_buffer_pool_get_config(pool->pool);
+            GstAllocationParams params;
+
+            gst_allocation_params_init(&params);
+            params.align = PLANE_ALIGN - 1;
+            gst_buffer_pool_config_set_params(config, NULL, (guint)size, 0, 0);
+            gst_buffer_pool_config_set_allocator(config, NULL, &params);
+
+            if (gst_buffer_pool_set_config(pool->pool, config) &&
+                gst_buffer_pool_set_active(pool->pool, TRUE))
+            {
+                pool->buffer_size = size;
+            }
+            else
+            {
+                gst_object_unref(pool->pool);
+                pool->pool = NULL;
+            }
+        }
+    }
+
+    if (pool->pool && gst_buffer_pool_acquire_buffer(pool->pool, &buffer, NULL) != GST_FLOW_OK)
+        buffer = NULL;
+    g_mutex_unlock(&decoder->pool_lock);
+
+    return buffer;
+}
+
+static gboolean videodecoder_is_direct_frame(VideoDecoder *decoder)
+{
+#if DIRECT_RENDERING
+    return decoder->direct_rendering && BASEDECODER(decoder)->frame->format == AV_PIX_FMT_YUV420P;
+#else
+    return FALSE;
+#endif // DIRECT_RENDERING
+}
+
+#if DIRECT_RENDERING
+/*
+ * A pool buffer handed to libavcodec. It stays mapped for as long as
+ * libavcodec references it, so that the decoder never writes to unmapped
+ * memory.
+ */
+typedef struct
+{
+    GstBuffer  *buffer;
+    GstMapInfo  info;
+} DirectBuffer;
+
+static void videodecoder_release_buffer(void *opaque, uint8_t *data)
+{
+    DirectBuffer *direct = (DirectBuffer*)opaque;
+
+    gst_buffer_unmap(direct->buffer, &direct->info);
+    // INLINE - gst_buffer_unref()
+    gst_buffer_unref(direct->buffer);
+    g_free(direct);
+}
+
+/*
+ * Lays out YUV420P frames in a single pool buffer, in the same plane order
+ * as the caps we announce, so that decoded frames can be pushed without a
+ * copy. Called from the decoding threads when frame threading is enabled.
+ */
+static int videodecoder_get_buffer2(AVCodecContext *context, AVFrame *frame, int flags)
+{
+    VideoDecoder *decoder = (VideoDecoder*)context->opaque;
+    int width = frame->width;
+    int height = frame->height;
+    int linesize_align[AV_NUM_DATA_POINTERS];
+    DirectBuffer *direct;
+    guint8 *data;
+
+    if (frame->format != AV_PIX_FMT_YUV420P)
+        return avcodec_default_get_buffer2(context, frame, flags);
+
+    avcodec_align_dimensions2(context, &width, &height, linesize_align);
+
+    // Chroma planes are half as wide, keep their stride aligned as well.
+    int stride_y = FFALIGN(width, PLANE_ALIGN * 2);
+    int stride_uv = stride_y / 2;
+    gsize size_y = (gsize)stride_y * height;
+    gsize size_uv = (gsize)stride_uv * ((height + 1) / 2);
+
+    direct = g_try_new0(DirectBuffer, 1);
+    if (direct == NULL)
+        return AVERROR(ENOMEM);
+
+    direct->buffer = videodecoder_acquire_buffer(decoder, &decoder->direct_pool, size_y + 2 * size_uv + PLANE_ALIGN);
+    if (direct->buffer == NULL)
+    {
+        g_free(direct);
+        return AVERROR(ENOMEM);
+    }
+
+    // Mapped for reading as well, so that downstream can map the buffer for
+    // reading while libavcodec still holds it as a reference frame.
+    if (!gst_buffer_map(direct->buffer, &direct->info, GST_MAP_READWRITE))
+    {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(direct->buffer);
+        g_free(direct);
+        return AVERROR(ENOMEM);
+    }
+    data = direct->info.data;
+
+    frame->buf[0] = av_buffer_create(data, direct->info.size, videodecoder_release_buffer, direct, 0);
+    if (frame->buf[0] == NULL)
+    {
+        videodecoder_release_buffer(direct, data);
+        return AVERROR(ENOMEM);
+    }
+
+    frame->data[0] = data;
+    frame->data[1] = data + size_y;
+    frame->data[2] = data + size_y + size_uv;
+    frame->linesize[0] = stride_y;
+    frame->linesize[1] = stride_uv;
+    frame->linesize[2] = stride_uv;
+    frame->extended_data = frame->data;
+
+    return 0;
+}
+#endif // DIRECT_RENDERING
+
+static void videodecoder_init_context(BaseDecoder *base)
+{
+    BASEDECODER_CLASS(parent_class)->init_context(base);
+
+#if DIRECT_RENDERING
+    VideoDecoder *decoder = VIDEODECODER(base);
+#ifdef AV_CODEC_CAP_DR1
+    decoder->direct_rendering = (base->codec->capabilities & AV_CODEC_CAP_DR1) != 0;
+#else
+    decoder->direct_rendering = (base->codec->capabilities & CODEC_CAP_DR1) != 0;
+#endif
+    if (decoder->direct_rendering)
+    {
+        base->context->opaque = decoder;
+        base->context->get_buffer2 = videodecoder_get_buffer2;
+#if THREAD_SAFE_CALLBACKS
+        base->context->thread_safe_callbacks = 1;
+#endif
+    }
+#endif // DIRECT_RENDERING
+}
+
 static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 {
     BaseDecoder *base = BASEDECODER(decoder);
@@ -309,18 +583,41 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
     int height = base->context->height;
 #endif // NEW_CODEC_ID
 
+    unsigned int y_offset, u_offset, v_offset;
+#if DIRECT_RENDERING
+    if (videodecoder_is_direct_frame(decoder))
+    {
+        // The planes already are in the buffer that is pushed, see
+        // videodecoder_get_buffer2(). libavcodec may have moved the plane
+        // pointers into it, e.g. when cropping, so the offsets are taken
+        // from the start of the buffer.
+        guint8 *data = ((DirectBuffer*)av_buffer_get_opaque(base->frame->buf[0]))->info.data;
+        y_offset = (unsigned int)(base->frame->data[0] - data);
+        u_offset = (unsigned int)(base->frame->data[1] - data);
+        v_offset = (unsigned int)(base->frame->data[2] - data);
+    }
+    else
+#endif // DIRECT_RENDERING
+    {
+        y_offset = 0;
+        u_offset = base->frame->linesize[0] * height;
+        v_offset = u_offset + base->frame->linesize[1] * height / 2;
+    }
+
     if (caps == NULL ||
-        decoder->width != width || decoder->height != height)
+        decoder->width != width || decoder->height != height ||
+        decoder->y_offset != y_offset || decoder->u_offset != u_offset || decoder->v_offset != v_offset)
     {
         decoder->width = width;
         decoder->height = height;
 
         decoder->discont = (caps != NULL);
 
-        decoder->u_offset = base->frame->linesize[0] * decoder->height;
+        decoder->y_offset = y_offset;
+        decoder->u_offset = u_offset;
         decoder->uv_blocksize = base->frame->linesize[1] * decoder->height / 2;
 
-        decoder->v_offset = decoder->u_offset + decoder->uv_blocksize;
+        decoder->v_offset = v_offset;
         decoder->frame_size = (base->frame->linesize[0] + base->frame->linesize[1]) * decoder->height;
 
         GstCaps *src_caps = gst_caps_new_simple("video/x-raw-yuv",
@@ -330,7 +627,7 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
                                                 "stride-y", G_TYPE_INT, base->frame->linesize[0],
                                                 "stride-u", G_TYPE_INT, base->frame->linesize[1],
                                                 "stride-v", G_TYPE_INT, base->frame->linesize[2],
-                                                "offset-y", G_TYPE_INT, 0,
+                                                "offset-y", G_TYPE_INT, decoder->y_offset,
                                                 "offset-u", G_TYPE_INT, decoder->u_offset,
                                                 "offset-v", G_TYPE_INT, decoder->v_offset,
                                                 "framerate", GST_TYPE_FRACTION, 2997, 100,
@@ -357,6 +654,189 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 
     return TRUE;
 }
+
+/***********************************************************************************
+ * Copies the planes of a frame that was not decoded directly into a GstBuffer.
+ * Returns NULL after posting an error message if the copy failed.
+ ***********************************************************************************/
+static GstBuffer* videodecoder_copy_frame(VideoDecoder *decoder)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstMapInfo     info2;
+    unsigned int   out_buf_size = 0;
+    gboolean       copy_error = FALSE;
+
+    GstBuffer *outbuf = videodecoder_acquire_buffer(decoder, &decoder->copy_pool, decoder->frame_size);
+    if (outbuf == NULL)
+    {
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                 GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                 ("Decoded video buffer allocation failed"), NULL,
+                                 ("videodecoder.c"), ("videodecoder_chain"), 0);
+        return NULL;
+    }
+
+    if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
+    {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(outbuf);
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                         g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
+        return NULL;
+    }
+
+    // Copy image by parts from different arrays.
+    if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
+    {
+        gst_buffer_unmap(outbuf, &info2);
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(outbuf);
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                         g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
+        return NULL;
+    }
+
+    out_buf_size = decoder->frame_size;
+    if (out_buf_size >= decoder->u_offset)
+    {
+        memcpy(info2.data, base->frame->data[0], decoder->u_offset);
+        out_buf_size -= decoder->u_offset;
+        if (out_buf_size >= decoder->uv_blocksize &&
+            decoder->uv_blocksize <= decoder->frame_size &&
+            decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
+        {
+            memcpy(info2.data + decoder->u_offset, base->frame->data[1], decoder->uv_blocksize);
+            out_buf_size -= decoder->uv_blocksize;
+            if (out_buf_size >= decoder->uv_blocksize &&
+                decoder->uv_blocksize <= decoder->frame_size &&
+                decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
+            {
+                memcpy(info2.data + decoder->v_offset, base->frame->data[2], decoder->uv_blocksize);
+            }
+            else
+            {
+                copy_error = TRUE;
+            }
+        }
+        else
+        {
+            copy_error = TRUE;
+        }
+    }
+    else
+    {
+        copy_error = TRUE;
+    }
+
+    gst_buffer_unmap(outbuf, &info2);
+
+    if (copy_error)
+    {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(outbuf);
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                         g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
+        return NULL;
+    }
+
+    return outbuf;
+}
+
+/***********************************************************************************
+ * Pushes the decoded frame downstream.
+ * buf is the input buffer that completed the frame, or NULL when draining.
+ ***********************************************************************************/
+static GstFlowReturn videodecoder_push_frame(VideoDecoder *decoder, GstBuffer *buf)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+    GstBuffer     *outbuf = NULL;
+
+    if (!videodecoder_configure_sourcepad(decoder))
+        return GST_FLOW_ERROR;
+
+#if DIRECT_RENDERING
+    if (videodecoder_is_direct_frame(decoder))
+    {
+        // libavcodec decoded right into this buffer and does not write to
+        // it anymore, so it can be passed on without copying the planes.
+        outbuf = gst_buffer_ref(((DirectBuffer*)av_buffer_get_opaque(base->frame->buf[0]))->buffer);
+    }
+    else
+#endif // DIRECT_RENDERING
+    {
+        outbuf = videodecoder_copy_frame(decoder);
+        if (outbuf == NULL)
+            return result;
+    }
+
+    GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
+    if (base->frame->reordered_opaque != AV_NOPTS_VALUE)
+    {
+        GST_BUFFER_TIMESTAMP(outbuf) = base->frame->reordered_opaque;
+        if (buf)
+            GST_BUFFER_DURATION(outbuf) = GST_BUFFER_DURATION(buf); // Duration for video usually same
+    }
+
+    GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
+
+    if (decoder->discont || (buf && GST_BUFFER_IS_DISCONT(buf)))
+    {
+#ifdef DEBUG_OUTPUT
+        g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
+#endif
+        GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
+        decoder->discont = FALSE;
+    }
+
+
+#ifdef VERBOSE_DEBUG
+    g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
+#endif
+    result = gst_pad_push(base->srcpad, outbuf);
+#ifdef VERBOSE_DEBUG
+    g_print(" done, res=%s\n", gst_flow_get_name(result));
+#endif
+
+    return result;
+}
+
+/***********************************************************************************
+ * Pushes the frames that are still buffered inside the decoder.
+ ***********************************************************************************/
+static void videodecoder_drain(VideoDecoder *decoder)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+
+    if (!base->is_initialized || base->is_flushing || base->context == NULL)
+        return;
+
+#if USE_SEND_RECEIVE
+    if (avcodec_send_packet(base->context, NULL) == 0)
+    {
+        while (result == GST_FLOW_OK && !base->is_flushing &&
+               avcodec_receive_frame(base->context, base->frame) == 0)
+        {
+            result = videodecoder_push_frame(decoder, NULL);
+        }
+    }
+#else
+    av_init_packet(&decoder->packet);
+    decoder->packet.data = NULL;
+    decoder->packet.size = 0;
+    while (result == GST_FLOW_OK && !base->is_flushing &&
+           avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet) >= 0 &&
+           decoder->frame_finished > 0)
+    {
+        result = videodecoder_push_frame(decoder, NULL);
+    }
+#endif
+
+    // A drained decoder only accepts new packets after it has been flushed.
+    basedecoder_flush(base);
+}
+
 /***********************************************************************************
  * chain
  ***********************************************************************************/
@@ -367,10 +847,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     GstFlowReturn  result = GST_FLOW_OK;
     int            num_dec = NO_DATA_USED;
     GstMapInfo     info;
-    GstMapInfo     info2;
     gboolean       unmap_buf = FALSE;
-    unsigned int   out_buf_size = 0;
-    gboolean       copy_error = FALSE;
 
     if (base->is_flushing)  // Reject buffers in flushing state.
     {
@@ -462,116 +939,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     }
 
     if (decoder->frame_finished > 0)
-    {
-        if (!videodecoder_configure_sourcepad(decoder))
-            result = GST_FLOW_ERROR;
-        else
-        {
-            GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
-            if (outbuf == NULL)
-            {
-                if (result != GST_FLOW_FLUSHING)
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             ("Decoded video buffer allocation failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-                }
-            }
-            else
-            {
-                GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
-                if (base->frame->reordered_opaque != AV_NOPTS_VALUE)
-                {
-                    GST_BUFFER_TIMESTAMP(outbuf) = base->frame->reordered_opaque;
-                    GST_BUFFER_DURATION(outbuf) = GST_BUFFER_DURATION(buf); // Duration for video usually same
-                }
-
-                if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                // Copy image by parts from different arrays.
-                if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
-                {
-                    gst_buffer_unmap(outbuf, &info2);
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                out_buf_size = decoder->frame_size;
-                if (out_buf_size >= decoder->u_offset)
-                {
-                    memcpy(info2.data, base->frame->data[0], decoder->u_offset);
-                    out_buf_size -= decoder->u_offset;
-                    if (out_buf_size >= decoder->uv_blocksize &&
-                        decoder->uv_blocksize <= decoder->frame_size &&
-                        decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                    {
-                        memcpy(info2.data + decoder->u_offset, base->frame->data[1], decoder->uv_blocksize);
-                        out_buf_size -= decoder->uv_blocksize;
-                        if (out_buf_size >= decoder->uv_blocksize &&
-                            decoder->uv_blocksize <= decoder->frame_size &&
-                            decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                        {
-                            memcpy(info2.data + decoder->v_offset, base->frame->data[2], decoder->uv_blocksize);
-                        }
-                        else
-                        {
-                            copy_error = TRUE;
-                        }
-                    }
-                    else
-                    {
-                        copy_error = TRUE;
-                    }
-                }
-                else
-                {
-                    copy_error = TRUE;
-                }
-
-                gst_buffer_unmap(outbuf, &info2);
-
-                if (copy_error)
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
-
-                if (decoder->discont || GST_BUFFER_IS_DISCONT(buf))
-                {
-#ifdef DEBUG_OUTPUT
-                    g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
-#endif
-                    GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
-                    decoder->discont = FALSE;
-                }
-
-
-#ifdef VERBOSE_DEBUG
-                g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
-#endif
-                result = gst_pad_push(base->srcpad, outbuf);
-#ifdef VERBOSE_DEBUG
-                g_print(" done, res=%s\n", gst_flow_get_name(result));
-#endif
-            }
-        }
-    }
+        result = videodecoder_push_frame(decoder, buf);
 
 _exit:
     if (unmap_buf)
@@ -45,6 +45,12 @@ G_BEGIN_DECLS
 
 typedef struct _VideoDecoder      VideoDecoder;
 typedef struct _VideoDecoderClass VideoDecoderClass;
+typedef struct _VideoDecoderPool  VideoDecoderPool;
+
+struct _VideoDecoderPool {
+    GstBufferPool *pool;
+    gsize          buffer_size;
+};
 
 struct _VideoDecoder {
     BaseDecoder parent;
@@ -55,11 +61,17 @@ struct _VideoDecoder {
     gboolean     discont;
 
     unsigned int frame_size;     // in bytes
+    unsigned int y_offset;
     unsigned int u_offset;
     unsigned int v_offset;
     unsigned int uv_blocksize;
 
     AVPacket     packet;
+
+    gboolean         direct_rendering; // YUV420P frames are decoded into pool buffers
+    VideoDecoderPool direct_pool;      // buffers libavcodec decodes into, used from the decoder threads
+    VideoDecoderPool copy_pool;        // buffers other frames are copied into
+    GMutex           pool_lock;
 };
 
 struct _VideoDecoderClass
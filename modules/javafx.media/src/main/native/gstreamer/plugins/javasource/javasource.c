@@ -53,6 +53,8 @@ enum
     SIGNAL_CLOSE_CONNECTION,
     SIGNAL_PROPERTY,
     SIGNAL_GET_STREAM_SIZE,
+    SIGNAL_READ_NEXT_BLOCK_INTO,
+    SIGNAL_READ_BLOCK_INTO,
     LAST_SIGNAL
 };
 
@@ -105,6 +107,11 @@ struct _JavaSource
     gchar*        location; // property controlled
     gchar*        mimetype; // property controlled
     gdouble       rate;
+
+    // Direct reads into the buffer memory, available if "-into" signals are connected
+    gboolean      direct_read;
+    gboolean      direct_read_block;
+    gint          read_size; // adaptive push mode read size
 };
 
 struct _JavaSourceClass
@@ -293,6 +300,28 @@ static void java_source_class_init (JavaSourceClass *klass)
         source_marshal_INT__VOID,
         G_TYPE_INT, /* return_type */
         0    /* n_params */ );
+
+    klass->signals[SIGNAL_READ_NEXT_BLOCK_INTO] = g_signal_new ("read-next-block-into",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_RECURSE | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_INT__POINTER_INT,
+        G_TYPE_INT, /* return_type */
+        2,     /* n_params */
+        G_TYPE_POINTER, G_TYPE_INT);
+
+    klass->signals[SIGNAL_READ_BLOCK_INTO] = g_signal_new ("read-block-into",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_RECURSE | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_INT__UINT64_POINTER_INT,
+        G_TYPE_INT, /* return_type */
+        3,     /* n_params */
+        G_TYPE_UINT64, G_TYPE_POINTER, G_TYPE_INT);
 }
 
 static void java_source_init(JavaSource *element)
@@ -315,6 +344,10 @@ static void java_source_init(JavaSource *element)
     element->rate = 1.0; // Default to 1.0
 
     element->mimetype = NULL;
+
+    element->direct_read = FALSE;
+    element->direct_read_block = FALSE;
+    element->read_size = BUFFER_SIZE;
 }
 
 /***********************************************************************************
@@ -630,23 +663,59 @@ next_event:
             {
                 gint     size;
                 GstMapInfo info;
-                g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
+                GstBuffer *direct_buffer = NULL;
+
+                if (element->direct_read)
+                {
+                    // Let Java read into the buffer memory, instead of copying out of its own buffer
+                    direct_buffer = gst_buffer_new_allocate(NULL, element->read_size, NULL);
+                    if (direct_buffer == NULL || !gst_buffer_map(direct_buffer, &info, GST_MAP_WRITE))
+                    {
+                        if (direct_buffer)
+                            gst_buffer_unref(direct_buffer);
+                        result = GST_FLOW_ERROR;
+                        break;
+                    }
+
+                    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK_INTO], 0, info.data, element->read_size, &size);
+                    gst_buffer_unmap(direct_buffer, &info);
+
+                    // Grow reads while the stream fills them, shrink when it runs dry
+                    if (size == element->read_size && element->read_size < MAX_READ_SIZE)
+                        element->read_size *= 2;
+                    else if (size >= 0 && size < element->read_size / 4 && element->read_size > BUFFER_SIZE)
+                        element->read_size /= 2;
+
+                    if (size > 0)
+                        gst_buffer_set_size(direct_buffer, size);
+                    else
+                    {
+                        gst_buffer_unref(direct_buffer);
+                        direct_buffer = NULL;
+                    }
+                }
+                else
+                    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
+
                 if (size > 0)
                 {
-                    GstBuffer *buffer = gst_buffer_new_allocate(NULL, size, NULL);
+                    GstBuffer *buffer = direct_buffer ? direct_buffer : gst_buffer_new_allocate(NULL, size, NULL);
                     if (buffer)
                     {
                         GST_BUFFER_OFFSET(buffer) = element->position;
 
-                        if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                        if (direct_buffer == NULL)
                         {
-                            result = GST_FLOW_ERROR;
-                            break;
-                        }
+                            if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                            {
+                                result = GST_FLOW_ERROR;
+                                break;
+                            }
 
-                        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
+                            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
 
-                        gst_buffer_unmap(buffer, &info);
+                            gst_buffer_unmap(buffer, &info);
+                        }
 
                         if (element->discont)
                         {
@@ -810,14 +879,13 @@ static GstFlowReturn java_source_getrange(GstPad *pad, GstObject *parent, guint6
     guint    toRead = 0;
     GstMapInfo info;
 
-    // Do not read from Java more then MAX_READ_SIZE, so we do not allocate very large objects in Java
     GstBuffer *buf = gst_buffer_new_allocate(NULL, length, NULL);
     if (buf == NULL)
         return GST_FLOW_ERROR;
 
     GST_BUFFER_OFFSET(buf) = offset;
 
-    if (!gst_buffer_map(buf, &info, GST_MAP_READ))
+    if (!gst_buffer_map(buf, &info, GST_MAP_WRITE))
     {
         gst_buffer_unref(buf);
         return GST_FLOW_ERROR;
@@ -825,15 +893,22 @@ static GstFlowReturn java_source_getrange(GstPad *pad, GstObject *parent, guint6
 
     while (read < length)
     {
-        if ((length - read) >= MAX_READ_SIZE)
+        // Do not read from Java more then MAX_READ_SIZE, so we do not allocate very large objects in Java.
+        // Direct reads go straight into the buffer and need no Java allocation.
+        if ((length - read) >= MAX_READ_SIZE && !element->direct_read_block)
             toRead = MAX_READ_SIZE;
         else
             toRead = (length - read);
 
-        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_BLOCK], 0, offset + read, toRead, &size);
+        if (element->direct_read_block)
+            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_BLOCK_INTO], 0, offset + read, info.data + read, toRead, &size);
+        else
+            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_BLOCK], 0, offset + read, toRead, &size);
+
         if (size > 0 && size <= toRead)
         {
-            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data + read, size);
+            if (!element->direct_read_block)
+                g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data + read, size);
             read += size;
 
             if (size < toRead)
@@ -878,6 +953,11 @@ static GstStateChangeReturn java_source_change_state (GstElement *e,
         {
             GST_PAD_STREAM_LOCK(element->srcpad);
             element->pending_event = GST_EVENT_STREAM_START;
+            element->direct_read = g_signal_has_handler_pending(element,
+                JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK_INTO], 0, FALSE);
+            element->direct_read_block = g_signal_has_handler_pending(element,
+                JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_BLOCK_INTO], 0, FALSE);
+            element->read_size = BUFFER_SIZE;
             element->position = 0;
             element->position_time = 0;
             element->discont = FALSE;
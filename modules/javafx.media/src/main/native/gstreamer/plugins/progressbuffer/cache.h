@@ -35,6 +35,22 @@ void      cache_static_init(void); // Must be called only once from the Progress
 Cache*    create_cache();
 void      destroy_cache(Cache* instance);
 
+/* Drops all cached data and resets both positions to zero.
+ * Positions are stream offsets, data written at a position stays readable at
+ * that position until it is evicted or the cache is cleared.
+ */
+void      cache_clear(Cache* cache);
+
+/* Limits the amount of cached data in bytes, 0 means unlimited.
+ * Only data behind the read position is evicted, so the cache can grow past
+ * the budget while the download is ahead of the reader.
+ * The disk space of evicted data is given back where the file system supports
+ * sparse files: hole punching on Linux and macOS (APFS), sparse files on
+ * Windows (NTFS). Elsewhere evicted data only stops being readable and the
+ * file keeps its size.
+ */
+void      cache_set_budget(Cache* cache, gint64 budget);
+
 // Writes a buffer.
 void           cache_write_buffer(Cache* cache, GstBuffer* buffer);
 
@@ -57,6 +73,11 @@ gboolean       cache_set_write_position(Cache* cache, gint64 position);
 // Sets a new read position
 gboolean       cache_set_read_position(Cache* cache, gint64 position);
 
+/* Returns the end of the cached range containing position,
+ * or position itself if that byte is not cached.
+ */
+gint64         cache_get_range_end(Cache* cache, gint64 position);
+
 // Returns true if the cache has enough data for fluent reading, but we can't expect more than total.
 gboolean       cache_has_enough_data(Cache* cache);
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "cacheindex.h"
+
+void cache_index_init(CacheIndex* index)
+{
+    index->ranges = g_array_new(FALSE, FALSE, sizeof(CacheRange));
+    index->size = 0;
+}
+
+void cache_index_free(CacheIndex* index)
+{
+    if (index->ranges)
+        g_array_free(index->ranges, TRUE);
+    index->ranges = NULL;
+    index->size = 0;
+}
+
+void cache_index_clear(CacheIndex* index)
+{
+    g_array_set_size(index->ranges, 0);
+    index->size = 0;
+}
+
+// Returns the index of the first range which ends at or after position.
+static guint cache_index_find(const CacheIndex* index, gint64 position)
+{
+    guint low = 0, high = index->ranges->len;
+
+    while (low < high)
+    {
+        guint mid = (low + high) / 2;
+        if (g_array_index(index->ranges, CacheRange, mid).stop < position)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+void cache_index_add(CacheIndex* index, gint64 start, gint64 stop)
+{
+    CacheRange range;
+    guint      first, last;
+
+    if (start >= stop)
+        return;
+
+    range.start = start;
+    range.stop = stop;
+
+    // Merge with every range which overlaps or touches [start, stop)
+    first = last = cache_index_find(index, start);
+    while (last < index->ranges->len &&
+           g_array_index(index->ranges, CacheRange, last).start <= stop)
+    {
+        CacheRange *r = &g_array_index(index->ranges, CacheRange, last);
+        range.start = MIN(range.start, r->start);
+        range.stop = MAX(range.stop, r->stop);
+        index->size -= r->stop - r->start;
+        last++;
+    }
+
+    if (last > first)
+        g_array_remove_range(index->ranges, first, last - first);
+    g_array_insert_val(index->ranges, first, range);
+    index->size += range.stop - range.start;
+}
+
+void cache_index_remove(CacheIndex* index, gint64 start, gint64 stop)
+{
+    guint i;
+
+    if (start >= stop)
+        return;
+
+    i = cache_index_find(index, start);
+    while (i < index->ranges->len)
+    {
+        CacheRange *r = &g_array_index(index->ranges, CacheRange, i);
+        if (r->start >= stop)
+            break;
+
+        if (r->stop <= start)
+        {
+            i++;
+        }
+        else if (r->start < start && r->stop > stop) // Split the range in two
+        {
+            CacheRange tail;
+            tail.start = stop;
+            tail.stop = r->stop;
+            r->stop = start;
+            index->size -= stop - start;
+            g_array_insert_val(index->ranges, i + 1, tail);
+            break;
+        }
+        else if (r->start < start) // Trim the tail
+        {
+            index->size -= r->stop - start;
+            r->stop = start;
+            i++;
+        }
+        else if (r->stop > stop) // Trim the head
+        {
+            index->size -= stop - r->start;
+            r->start = stop;
+            break;
+        }
+        else // Fully covered
+        {
+            index->size -= r->stop - r->start;
+            g_array_remove_index(index->ranges, i);
+        }
+    }
+}
+
+gint64 cache_index_get_range_end(const CacheIndex* index, gint64 position)
+{
+    guint i = cache_index_find(index, position);
+
+    if (i < index->ranges->len)
+    {
+        const CacheRange *r = &g_array_index(index->ranges, CacheRange, i);
+        if (r->start <= position && position < r->stop)
+            return r->stop;
+    }
+    return position;
+}
+
+gboolean cache_index_get_eviction(const CacheIndex* index, gint64 read_position, gint64 excess, CacheRange* evicted)
+{
+    const CacheRange *r;
+
+    if (index->ranges->len == 0)
+        return FALSE;
+
+    // Data at or after the read position has not been read yet, dropping it would leave
+    // the reader waiting at a hole that the download may never fill again.
+    r = &g_array_index(index->ranges, CacheRange, 0);
+    if (r->start >= read_position)
+        return FALSE;
+
+    // Ranges are sorted, the first one holds the oldest byte behind the reader.
+    evicted->start = r->start;
+    evicted->stop = MIN(r->stop, read_position);
+    if (evicted->stop - evicted->start > excess)
+        evicted->stop = evicted->start + excess;
+    return TRUE;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef __CACHE_INDEX_H__
+#define __CACHE_INDEX_H__
+
+#include <glib.h>
+
+/*
+ * Keeps track of the byte ranges stored in a cache file. Ranges are sorted,
+ * never overlap and adjacent ranges are merged.
+ */
+typedef struct _CacheRange
+{
+    gint64  start;
+    gint64  stop;
+} CacheRange;
+
+typedef struct _CacheIndex
+{
+    GArray  *ranges;
+    gint64  size;   // total number of cached bytes
+} CacheIndex;
+
+void      cache_index_init(CacheIndex* index);
+void      cache_index_free(CacheIndex* index);
+void      cache_index_clear(CacheIndex* index);
+
+// Marks [start, stop) as cached.
+void      cache_index_add(CacheIndex* index, gint64 start, gint64 stop);
+
+// Marks [start, stop) as not cached.
+void      cache_index_remove(CacheIndex* index, gint64 start, gint64 stop);
+
+// Returns the end of the cached data starting at position, or position if it is not cached.
+gint64    cache_index_get_range_end(const CacheIndex* index, gint64 position);
+
+/* Picks up to excess bytes to drop, starting with the lowest cached offset. Only data
+ * before read_position is picked, data that has not been read yet is always kept.
+ * Returns FALSE if nothing can be dropped. The picked range is not removed from the index.
+ */
+gboolean  cache_index_get_eviction(const CacheIndex* index, gint64 read_position,
+                                   gint64 excess, CacheRange* evicted);
+
+#endif // __CACHE_INDEX_H__
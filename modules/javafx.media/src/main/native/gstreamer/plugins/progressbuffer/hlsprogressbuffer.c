@@ -289,8 +289,7 @@ static void hls_progress_buffer_flush_data(HLSProgressBuffer *element)
     {
         if (element->cache[i])
         {
-            cache_set_write_position(element->cache[i], 0);
-            cache_set_read_position(element->cache[i], 0);
+            cache_clear(element->cache[i]);
             element->cache_size[i] = 0;
             element->cache_write_ready[i] = TRUE;
         }
@@ -535,8 +534,7 @@ static gboolean hls_progress_buffer_sink_event(GstPad *pad, GstObject *parent, G
             }
             element->cache_size[element->cache_write_index] = segment.stop;
             element->cache_write_ready[element->cache_write_index] = FALSE;
-            cache_set_write_position(element->cache[element->cache_write_index], 0);
-            cache_set_read_position(element->cache[element->cache_write_index], 0);
+            cache_clear(element->cache[element->cache_write_index]);
 
             g_mutex_unlock(&element->lock);
 
@@ -23,7 +23,12 @@
  * questions.
  */
 
+#if defined(LINUX)
+#define _GNU_SOURCE // fallocate()
+#endif
+
 #include <cache.h>
+#include <cacheindex.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -32,6 +37,10 @@
 #define DEFAULT_BUFFER_SIZE 4096
 static const char *tempDir = NULL;
 
+/*
+ * Data is stored at its stream offset, so the backing file is sparse and
+ * ranges downloaded before a seek stay available.
+ */
 struct _Cache
 {
     char*   filename;
@@ -40,6 +49,10 @@ struct _Cache
 
     gint64  read_position;
     gint64  write_position;
+
+    CacheIndex index;
+    gint64  budget;
+    gint64  block_size; // file system block size, holes are punched in whole blocks
 };
 
 void cache_static_init(void)
@@ -50,6 +63,7 @@ void cache_static_init(void)
 Cache* create_cache()
 {
     Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
+    struct stat st;
     if (result)
     {
         result->filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
@@ -71,6 +85,10 @@ Cache* create_cache()
         }
 
             result->read_position = result->write_position = 0;
+            result->budget = 0;
+            result->block_size = fstat(result->writeHandle, &st) == 0 && st.st_blksize > 0
+                                 ? st.st_blksize : DEFAULT_BUFFER_SIZE;
+            cache_index_init(&result->index);
         }
     }
     return result;
@@ -85,18 +103,71 @@ void destroy_cache(Cache* instance)
     close(instance->writeHandle);
     close(instance->readHandle);
     g_free(instance->filename);
+    cache_index_free(&instance->index);
 
     g_free(instance);
 }
 
+void cache_clear(Cache* cache)
+{
+    cache_index_clear(&cache->index);
+    cache->read_position = cache->write_position = 0;
+}
+
+void cache_set_budget(Cache* cache, gint64 budget)
+{
+    cache->budget = budget;
+}
+
+/* Gives the disk space of [start, stop) back to the file system.
+ * Failing is harmless, the data is just kept.
+ */
+static void cache_punch_hole(Cache* cache, gint64 start, gint64 stop)
+{
+    // Only whole blocks can be freed, partial ones at either end are kept.
+    start = (start + cache->block_size - 1) / cache->block_size * cache->block_size;
+    stop = stop / cache->block_size * cache->block_size;
+    if (start >= stop)
+        return;
+
+#if defined(FALLOC_FL_PUNCH_HOLE)
+    fallocate(cache->writeHandle, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, start, stop - start);
+#elif defined(F_PUNCHHOLE)
+    {
+        fpunchhole_t hole = { 0 };
+        hole.fp_offset = start;
+        hole.fp_length = stop - start;
+        fcntl(cache->writeHandle, F_PUNCHHOLE, &hole);
+    }
+#endif
+}
+
+// Drops data the reader has passed, oldest first, until the cache fits the budget.
+static void cache_apply_budget(Cache* cache)
+{
+    CacheRange evicted;
+
+    while (cache->budget > 0 && cache->index.size > cache->budget &&
+           cache_index_get_eviction(&cache->index, cache->read_position,
+                                    cache->index.size - cache->budget, &evicted))
+    {
+        cache_index_remove(&cache->index, evicted.start, evicted.stop);
+        cache_punch_hole(cache, evicted.start, evicted.stop);
+    }
+}
+
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
     GstMapInfo info;
     if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        ssize_t written = write(cache->writeHandle, info.data, info.size);
+        ssize_t written = pwrite(cache->writeHandle, info.data, info.size, cache->write_position);
         if (written > 0)
+        {
+            cache_index_add(&cache->index, cache->write_position, cache->write_position + written);
             cache->write_position += written;
+            cache_apply_budget(cache);
+        }
         gst_buffer_unmap(buffer, &info);
     }
 }
@@ -108,14 +179,14 @@ gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 
     if (data)
     {
+        gint64 available = cache_get_range_end(cache, cache->read_position) - cache->read_position;
         ssize_t size = 0;
-        if ((cache->write_position - cache->read_position) > 0 &&
-            (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
-            size = cache->write_position - cache->read_position;
+        if (available > 0 && available < DEFAULT_BUFFER_SIZE)
+            size = available;
         else
             size = DEFAULT_BUFFER_SIZE;
 
-        ssize_t read_bytes = read(cache->readHandle, data, size);
+        ssize_t read_bytes = pread(cache->readHandle, data, size, cache->read_position);
         if (read_bytes > 0)
         {
             *buffer = gst_buffer_new_wrapped_full(0, data, DEFAULT_BUFFER_SIZE, 0, read_bytes, data, g_free);
@@ -142,7 +213,7 @@ GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_positio
         guint8 *data = (guint8*)g_try_malloc(size);
         if (data)
     {
-        ssize_t read_bytes = read(cache->readHandle, data, size);
+        ssize_t read_bytes = pread(cache->readHandle, data, size, start_position);
             if (read_bytes == size)
             {
                 *buffer = gst_buffer_new_wrapped_full(0, data, size, 0, read_bytes, data, g_free);
@@ -155,42 +226,37 @@ GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_positio
             else
             g_free(data); // Wrong size, deleting buffer to avoid leaking.
 
-            cache->read_position += read_bytes;
+            if (read_bytes > 0)
+                cache->read_position += read_bytes;
     }
     }
     return result;
 }
 
-static inline gboolean cache_set_handler_position(int handle, guint64 position)
+gboolean cache_set_write_position(Cache* cache, gint64 position)
 {
-    return lseek(handle, position, SEEK_SET) >= 0;
+    if (position < 0)
+        return FALSE;
+
+    cache->write_position = position;
+    return TRUE;
 }
 
-gboolean cache_set_write_position(Cache* cache, gint64 position)
+gboolean cache_set_read_position(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->write_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->writeHandle, position);
-        if (result)
-            cache->write_position = position;
-    }
-    return result;
+    if (position < 0)
+        return FALSE;
+
+    cache->read_position = position;
+    return TRUE;
 }
 
-gboolean cache_set_read_position(Cache* cache, gint64 position)
+gint64 cache_get_range_end(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->read_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->readHandle, position);
-        if (result)
-            cache->read_position = position;
-    }
-    return result;
+    return cache_index_get_range_end(&cache->index, position);
 }
 
 gboolean cache_has_enough_data(Cache* cache)
 {
-    return cache->read_position < cache->write_position;
+    return cache->read_position < cache_get_range_end(cache, cache->read_position);
 }
@@ -48,7 +48,8 @@ enum
     PROP_THRESHOLD,
     PROP_BANDWIDTH,
     PROP_PREBUFFER_TIME,
-    PROP_WAIT_TOLERANCE
+    PROP_WAIT_TOLERANCE,
+    PROP_CACHE_BUDGET
 };
 
 /***********************************************************************************
@@ -75,7 +76,7 @@ struct _ProgressBuffer
     // Cache infrastructure
     Cache         *cache;
     GstEvent      *pending_src_event;
-    gint64         cache_read_offset;
+    gint64         cache_budget; // property controlled.
 
     GstSegment    sink_segment;
     gdouble       last_update;
@@ -94,6 +95,7 @@ struct _ProgressBuffer
 
     gboolean      instant_seek;
     gboolean      is_source_seeking;
+    gboolean      is_prefetching; // Source seek filling the cache behind the read position.
 
 #if ENABLE_PULL_MODE
     gint64       range_start;
@@ -237,6 +239,15 @@ static void progress_buffer_class_init (ProgressBufferClass *klass)
                                                           2.0  /* default value */,
                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
 
+    g_object_class_install_property (gobject_class, PROP_CACHE_BUDGET,
+                                     g_param_spec_int64 ("cache-budget",
+                                                         "Cache budget",
+                                                         "Maximum amount of downloaded data kept in the cache in bytes, 0 means unlimited.",
+                                                         0  /* minimum value */,
+                                                         G_MAXINT64 /* maximum value */,
+                                                         0  /* default value */,
+                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
     cache_static_init();
 }
 
@@ -255,11 +266,12 @@ static void progress_buffer_init(ProgressBuffer *element)
 
     element->srcpad = NULL;
     element->cache = NULL;
-    element->cache_read_offset = 0;
+    element->cache_budget = 0;
     g_mutex_init(&element->lock);
     g_cond_init(&element->add_cond);
     element->bandwidth_timer = g_timer_new();
     element->is_source_seeking = FALSE;
+    element->is_prefetching = FALSE;
 
 #if ENABLE_PULL_MODE
     element->monitor_thread = NULL;
@@ -288,6 +300,13 @@ static void progress_buffer_set_property (GObject *object, guint property_id,
         case PROP_WAIT_TOLERANCE:
             element->wait_tolerance = g_value_get_double(value);
             break;
+        case PROP_CACHE_BUDGET:
+            g_mutex_lock(&element->lock);
+            element->cache_budget = g_value_get_int64(value);
+            if (element->cache)
+                cache_set_budget(element->cache, element->cache_budget);
+            g_mutex_unlock(&element->lock);
+            break;
 
         default:
             break;
@@ -321,6 +340,10 @@ static void progress_buffer_get_property (GObject *object, guint property_id,
             g_value_set_double(value, element->wait_tolerance);
             break;
 
+        case PROP_CACHE_BUDGET:
+            g_value_set_int64(value, element->cache_budget);
+            break;
+
         default:
             break;
     }
@@ -636,12 +659,25 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                         gst_event_unref(event); // INLINE - gst_event_unref()
                         return GST_FLOW_ERROR;
                     }
+                    cache_set_budget(element->cache, element->cache_budget);
                 }
                 else
                 {
-                    cache_set_write_position(element->cache, 0);
-                    cache_set_read_position(element->cache, 0);
-                    element->cache_read_offset = segment.start;
+                    // Cache positions are stream offsets, downloaded ranges survive the source seek.
+                    cache_set_write_position(element->cache, segment.start);
+
+                    if (element->is_prefetching)
+                    {
+                        // Downstream keeps reading the cached data, it must not see this segment.
+                        element->is_prefetching = FALSE;
+                        gst_segment_copy_into (&segment, &element->sink_segment);
+                        gst_event_unref(event); // INLINE - gst_event_unref()
+
+                        signal = send_position_message(element, TRUE);
+                        break;
+                    }
+
+                    cache_set_read_position(element->cache, segment.start);
                 }
 
                 gst_segment_copy_into (&segment, &element->sink_segment);
@@ -676,6 +712,10 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
     gint64       position;
     GstSegment   segment;
     guint32      seqnum;
+#ifdef ENABLE_SOURCE_SEEKING
+    gint64       cached_end;
+    gboolean     prefetch = FALSE;
+#endif
 
     gst_event_parse_seek(event, &rate, &format, &flags, &start_type, &position, &stop_type, NULL);
     seqnum = gst_event_get_seqnum(event);
@@ -712,12 +752,26 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
     element->srcresult = GST_FLOW_OK;
 
 #ifdef ENABLE_SOURCE_SEEKING
-    element->instant_seek = (position >= element->sink_segment.start &&
-                             (position - (gint64)element->sink_segment.position) <= element->bandwidth * element->wait_tolerance);
+    // Seek is served from the cache if the position has been downloaded before
+    // or the current download is about to reach it.
+    cached_end = cache_get_range_end(element->cache, position);
+    element->instant_seek = (cached_end > position ||
+                             (position >= element->sink_segment.position &&
+                              (position - (gint64)element->sink_segment.position) <= element->bandwidth * element->wait_tolerance));
 
     if (element->instant_seek)
     {
-        cache_set_read_position(element->cache, position - element->cache_read_offset);
+        // Cached range is not continued by the current download, fetch the rest in the background.
+        if (cached_end > position && cached_end < element->sink_segment.stop &&
+            (cached_end < element->sink_segment.position ||
+             (cached_end - (gint64)element->sink_segment.position) > element->bandwidth * element->wait_tolerance))
+        {
+            prefetch = TRUE;
+            element->is_prefetching = TRUE;
+            reset_eos(element, FALSE);
+        }
+
+        cache_set_read_position(element->cache, position);
         gst_segment_init(&segment, GST_FORMAT_BYTES);
         segment.rate = rate;
         segment.start = position;
@@ -729,9 +783,10 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
     {
         // Clear any pending events, since we doing seek.
         reset_eos(element, TRUE);
+        element->is_prefetching = FALSE;
     }
 #else
-    cache_set_read_position(element->cache, position - element->cache_read_offset);
+    cache_set_read_position(element->cache, position);
     gst_segment_init(&segment, GST_FORMAT_BYTES);
     segment.rate = rate;
     segment.start = position;
@@ -751,7 +806,7 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
         if (!gst_pad_push_event(element->sinkpad, e))
         {
             element->instant_seek = TRUE;
-            cache_set_read_position(element->cache, position - element->cache_read_offset);
+            cache_set_read_position(element->cache, position);
             gst_segment_init(&segment, GST_FORMAT_BYTES);
             segment.rate = rate;
             segment.start = position;
@@ -761,6 +816,18 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
         }
         element->is_source_seeking = FALSE;
     }
+    else if (prefetch)
+    {
+        element->is_source_seeking = TRUE;
+        if (!gst_pad_push_event(element->sinkpad, gst_event_new_seek(rate, GST_FORMAT_BYTES, GST_SEEK_FLAG_NONE,
+                                                                     GST_SEEK_TYPE_SET, cached_end, GST_SEEK_TYPE_NONE, 0)))
+        {
+            g_mutex_lock(&element->lock);
+            element->is_prefetching = FALSE;
+            g_mutex_unlock(&element->lock);
+        }
+        element->is_source_seeking = FALSE;
+    }
 #endif
 
     if (flags & GST_SEEK_FLAG_FLUSH) {
@@ -879,7 +946,6 @@ next_item:
         {
             GstBuffer *buffer = NULL;
             guint64 read_position = cache_read_buffer(element->cache, &buffer);
-            read_position += element->cache_read_offset;
             GST_BUFFER_OFFSET(buffer) = read_position - gst_buffer_get_size(buffer);
 
             if (read_position == element->sink_segment.stop)
@@ -1044,37 +1110,32 @@ static GstFlowReturn progress_buffer_getrange(GstPad *pad, GstObject *parent, gu
     ProgressBuffer *element = PROGRESS_BUFFER(parent);
     GstFlowReturn  result = GST_FLOW_OK;
     guint64        end_position = start_position + size;
+    gint64         cached_end = 0;
     gboolean       needs_seeking = FALSE;
 
     g_mutex_lock(&element->lock); // Use one lock for push and pull modes
 
     if (element->sink_segment.stop < (gint64)end_position)
         result = GST_FLOW_EOS;
-    else if (element->sink_segment.start <= (gint64)start_position &&
-             element->sink_segment.position >= (gint64)end_position)
+    else if ((cached_end = cache_get_range_end(element->cache, start_position)) >= (gint64)end_position)
         result = cache_read_buffer_from_position(element->cache, start_position, size, buffer);
     else
     {
+        // cached_end is the first byte of the request which is not in the cache.
 #if ENABLE_SOURCE_SEEKING
-        needs_seeking = element->sink_segment.start > (gint64)start_position;
+        needs_seeking = cached_end < element->sink_segment.position ||
+                        (element->bandwidth > 0 &&
+                         cached_end - element->sink_segment.position > element->bandwidth * element->wait_tolerance);
         if (needs_seeking)
         {
-            element->range_start = start_position;
+            element->range_start = cached_end;
             reset_eos(element, TRUE);
         }
 #endif
-        if (element->sink_segment.position < (gint64)end_position)
-        {
-            element->range_stop = end_position + (gint64)(element->bandwidth * element->prebuffer_time);
-
-            if (element->sink_segment.stop < element->range_stop)
-                element->range_stop = element->sink_segment.stop;
+        element->range_stop = end_position + (gint64)(element->bandwidth * element->prebuffer_time);
 
-#if ENABLE_SOURCE_SEEKING
-            needs_seeking = element->bandwidth > 0 &&
-                end_position - element->sink_segment.position > element->bandwidth * element->wait_tolerance;
-#endif
-        }
+        if (element->sink_segment.stop < element->range_stop)
+            element->range_stop = element->sink_segment.stop;
 
         send_underrun_message(element);
         result = GST_FLOW_FLUSHING;
@@ -1084,7 +1145,7 @@ static GstFlowReturn progress_buffer_getrange(GstPad *pad, GstObject *parent, gu
 
     if (needs_seeking)
         gst_pad_push_event(element->sinkpad, gst_event_new_seek(element->sink_segment.rate, GST_FORMAT_BYTES, GST_SEEK_FLAG_NONE,
-            GST_SEEK_TYPE_SET, start_position, GST_SEEK_TYPE_NONE, 0));
+            GST_SEEK_TYPE_SET, cached_end, GST_SEEK_TYPE_NONE, 0));
 
     return result;
 #else
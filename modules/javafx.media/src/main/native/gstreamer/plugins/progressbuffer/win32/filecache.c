@@ -24,7 +24,9 @@
  */
 
 #include <cache.h>
+#include <cacheindex.h>
 #include <windows.h>
+#include <winioctl.h>
 
 #define DEFAULT_BUFFER_SIZE 4096
 static char tempDir[MAX_PATH];
@@ -37,6 +39,9 @@ struct _Cache
 
     gint64  read_position;
     gint64  write_position;
+
+    CacheIndex index;
+    gint64  budget;
 };
 
 void cache_static_init(void)
@@ -66,7 +71,13 @@ Cache* create_cache()
             if(result->writeHandle == INVALID_HANDLE_VALUE || result->readHandle == INVALID_HANDLE_VALUE)
                 goto _error_exit;
 
+            // Data is stored at its stream offset, skipped ranges should not take disk space.
+            DWORD returned = 0;
+            DeviceIoControl(result->writeHandle, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &returned, NULL);
+
             result->read_position = result->write_position = 0;
+            result->budget = 0;
+            cache_index_init(&result->index);
         }
     }
     return result;
@@ -80,18 +91,55 @@ void destroy_cache(Cache* instance)
 {
     CloseHandle(instance->writeHandle);
     CloseHandle(instance->readHandle);
+    cache_index_free(&instance->index);
 
     g_free(instance);
 }
 
+void cache_clear(Cache* cache)
+{
+    cache_index_clear(&cache->index);
+    cache_set_write_position(cache, 0);
+    cache_set_read_position(cache, 0);
+}
+
+void cache_set_budget(Cache* cache, gint64 budget)
+{
+    cache->budget = budget;
+}
+
+// Drops data the reader has passed, oldest first, until the cache fits the budget.
+static void cache_apply_budget(Cache* cache)
+{
+    CacheRange evicted;
+    FILE_ZERO_DATA_INFORMATION zero;
+    DWORD returned = 0;
+
+    while (cache->budget > 0 && cache->index.size > cache->budget &&
+           cache_index_get_eviction(&cache->index, cache->read_position,
+                                    cache->index.size - cache->budget, &evicted))
+    {
+        cache_index_remove(&cache->index, evicted.start, evicted.stop);
+
+        // Give the disk space back. Failing is harmless, the data is just kept.
+        zero.FileOffset.QuadPart = evicted.start;
+        zero.BeyondFinalZero.QuadPart = evicted.stop;
+        DeviceIoControl(cache->writeHandle, FSCTL_SET_ZERO_DATA, &zero, sizeof(zero), NULL, 0, &returned, NULL);
+    }
+}
+
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
     DWORD written = 0;
     GstMapInfo info;
     if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        if (WriteFile(cache->writeHandle, info.data, info.size, &written, NULL))
+        if (WriteFile(cache->writeHandle, info.data, info.size, &written, NULL) && written > 0)
+        {
+            cache_index_add(&cache->index, cache->write_position, cache->write_position + written);
             cache->write_position += written;
+            cache_apply_budget(cache);
+        }
         gst_buffer_unmap(buffer, &info);
     }
 }
@@ -101,10 +149,11 @@ gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
     DWORD read = 0;
     DWORD size = 0;
     guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
+    gint64 available = cache_get_range_end(cache, cache->read_position) - cache->read_position;
     *buffer = NULL;
 
-    if ((cache->write_position - cache->read_position) > 0 && (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
-        size = cache->write_position - cache->read_position;
+    if (available > 0 && available < DEFAULT_BUFFER_SIZE)
+        size = (DWORD)available;
     else
         size = DEFAULT_BUFFER_SIZE;
 
@@ -187,7 +236,12 @@ gboolean cache_set_read_position(Cache* cache, gint64 position)
     return result;
 }
 
+gint64 cache_get_range_end(Cache* cache, gint64 position)
+{
+    return cache_index_get_range_end(&cache->index, position);
+}
+
 gboolean cache_has_enough_data(Cache* cache)
 {
-    return cache->read_position < cache->write_position;
+    return cache->read_position < cache_get_range_end(cache, cache->read_position);
 }
@@ -56,6 +56,12 @@ public:
     /* CopyBlock copies the datra from whatever internal buffer to the destination.*/
     virtual void CopyBlock(void* destination, int size) = 0;
 
+    /* ReadNextBlockInto and ReadBlockInto work like ReadNextBlock and ReadBlock,
+     * but read at most size bytes straight into destination, so no CopyBlock is needed.
+     */
+    virtual int  ReadNextBlockInto(void* destination, int size) = 0;
+    virtual int  ReadBlockInto(int64_t position, void* destination, int size) = 0;
+
     /* Detects whether the source is seekable.*/
     virtual bool IsSeekable() = 0;
 
@@ -48,7 +48,9 @@ public:
     :   m_PipelineType(pipelineType),
         m_bBufferingEnabled(false),
         m_StreamMimeType(-1),
-        m_bHLSModeEnabled(false)
+        m_bHLSModeEnabled(false),
+        m_VideoDecoderThreads(0),
+        m_CacheBudget(0)
     {}
 
     virtual ~CPipelineOptions() {}
@@ -64,11 +66,21 @@ public:
     inline void SetHLSModeEnabled(bool enabled) { m_bHLSModeEnabled = enabled; }
     inline bool GetHLSModeEnabled() { return m_bHLSModeEnabled; }
 
+    // Number of video decoding threads, 0 picks one thread per CPU core.
+    inline void SetVideoDecoderThreads(int threads) { m_VideoDecoderThreads = threads; }
+    inline int GetVideoDecoderThreads() { return m_VideoDecoderThreads; }
+
+    // Bytes of downloaded data the progress buffer keeps, 0 keeps everything.
+    inline void SetCacheBudget(int64_t budget) { m_CacheBudget = budget; }
+    inline int64_t GetCacheBudget() { return m_CacheBudget; }
+
 private:
     int         m_PipelineType;
     bool        m_bBufferingEnabled;
     int         m_StreamMimeType;
     bool        m_bHLSModeEnabled;
+    int         m_VideoDecoderThreads;
+    int64_t     m_CacheBudget;
 };
 
 #endif  //_PIPELINE_OPTIONS_H_
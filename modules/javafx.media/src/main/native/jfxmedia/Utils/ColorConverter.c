@@ -26,6 +26,7 @@
 #include <Common/ProductFlags.h>
 #include "ColorConverter.h"
 #include <stdio.h>
+#include <string.h>
 
 #if (! TARGET_OS_LINUX || defined(__SSE2__))
 #if defined(TARGET_OS_MAC_ARM64)
@@ -37,6 +38,20 @@
 #define ENABLE_SIMD_SSE2 0
 #endif
 
+// AVX2 kernels are compiled in whenever SSE2 is available and are selected
+// at runtime if the CPU supports them.
+#if ENABLE_SIMD_SSE2 && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
+#define ENABLE_SIMD_AVX2 1
+#else
+#define ENABLE_SIMD_AVX2 0
+#endif
+
+#if defined(__aarch64__) || defined(TARGET_OS_MAC_ARM64)
+#define ENABLE_SIMD_NEON 1
+#else
+#define ENABLE_SIMD_NEON 0
+#endif
+
 // --- Begin macros
 #define TCLAMP_U8(val, dst) dst = pClip[val]
 
@@ -380,6 +395,454 @@ const uint16_t color_tBU[256] = {
 };
 // --- End tables
 
+// --- Begin row conversion functions
+/*
+ * The row functions convert a single row of pixels to opaque BGRA or ARGB.
+ * Every implementation uses the fixed point coefficients of the SSE2 4:2:0
+ * functions below so that all code paths produce identical pixels.
+ *
+ * Each pair of pixels shares the chroma samples at u[0] and v[0], which are
+ * then advanced by uv_step bytes: 1 for planar and 2 for interleaved (NV12)
+ * chroma. An odd trailing pixel uses the chroma samples of its own pair.
+ */
+#define YCC_C0      0x2543      /* 1.1644  * 8192 */
+#define YCC_C1      0x4097      /* 2.0184  * 8192 */
+#define YCC_C4      0xc8b       /* abs( -0.3920 * 8192 ) */
+#define YCC_C5      0x1a06      /* abs( -0.8132 * 8192 ) */
+#define YCC_C8      0x3317      /* 1.5966  * 8192 */
+#define YCC_COFF0   (-8864)     /* -276.9856 * 32 */
+#define YCC_COFF1   0x10f4      /* 135.6352  * 32 */
+#define YCC_COFF2   (-7136)     /* -222.9952 * 32 */
+
+typedef void (*ColorConvertRowFunc)(uint8_t *dst,
+                                    const uint8_t *y,
+                                    const uint8_t *u,
+                                    const uint8_t *v,
+                                    int32_t uv_step,
+                                    int32_t width,
+                                    int32_t argb);
+
+static uint8_t ColorConvert_clamp_u8(int32_t val)
+{
+    return (uint8_t)(val < 0 ? 0 : (val > 255 ? 255 : val));
+}
+
+static void ColorConvert_row_c(uint8_t *dst,
+                               const uint8_t *y,
+                               const uint8_t *u,
+                               const uint8_t *v,
+                               int32_t uv_step,
+                               int32_t width,
+                               int32_t argb)
+{
+    // byte offsets of the color components in the destination pixel
+    const int32_t ai = argb ? 0 : 3;
+    const int32_t ri = argb ? 1 : 2;
+    const int32_t gi = argb ? 2 : 1;
+    const int32_t bi = argb ? 3 : 0;
+    int32_t i, k;
+
+    for (i = 0; i < width; i += 2) {
+        int32_t iu = *u;
+        int32_t iv = *v;
+        int32_t ib = ((iu * YCC_C1) >> 8) + YCC_COFF0;
+        int32_t ig = YCC_COFF1 - ((iu * YCC_C4) >> 8) - ((iv * YCC_C5) >> 8);
+        int32_t ir = ((iv * YCC_C8) >> 8) + YCC_COFF2;
+
+        for (k = 0; k < 2 && i + k < width; k++) {
+            int32_t iy = (y[k] * YCC_C0) >> 8;
+
+            dst[ai] = 0xff;
+            dst[ri] = ColorConvert_clamp_u8((iy + ir) >> 5);
+            dst[gi] = ColorConvert_clamp_u8((iy + ig) >> 5);
+            dst[bi] = ColorConvert_clamp_u8((iy + ib) >> 5);
+            dst += 4;
+        }
+
+        y += 2;
+        u += uv_step;
+        v += uv_step;
+    }
+}
+
+#if ENABLE_SIMD_SSE2
+#include <emmintrin.h>
+
+/* x = 8 unsigned 8 bit values in the high bytes of 16 bit lanes */
+#define MULHI_SSE2(x, c) _mm_mulhi_epu16(x, _mm_set1_epi16(c))
+
+static void ColorConvert_row_sse2(uint8_t *dst,
+                                  const uint8_t *y,
+                                  const uint8_t *u,
+                                  const uint8_t *v,
+                                  int32_t uv_step,
+                                  int32_t width,
+                                  int32_t argb)
+{
+    const __m128i x_zero = _mm_setzero_si128();
+    const __m128i x_aa = _mm_set1_epi8((char)0xff);
+    const __m128i x_hi = _mm_set1_epi16((short)0xff00);
+    __m128i x_u, x_v, x_y1, x_y2, x_b, x_g, x_r, x_temp;
+    __m128i x_c0, x_c1, x_c2, x_c3, x_01l, x_01h, x_23l, x_23h;
+    int32_t i;
+
+    // 16 pixels
+    for (i = 0; i <= width - 16; i += 16) {
+        if (uv_step == 2) {
+            x_temp = _mm_loadu_si128((const __m128i*)u);
+            x_u = _mm_slli_epi16(x_temp, 8);
+            x_v = _mm_and_si128(x_temp, x_hi);
+        } else {
+            x_u = _mm_unpacklo_epi8(x_zero, _mm_loadl_epi64((const __m128i*)u));
+            x_v = _mm_unpacklo_epi8(x_zero, _mm_loadl_epi64((const __m128i*)v));
+        }
+        x_temp = _mm_loadu_si128((const __m128i*)y);
+        x_y1 = MULHI_SSE2(_mm_unpacklo_epi8(x_zero, x_temp), YCC_C0);
+        x_y2 = MULHI_SSE2(_mm_unpackhi_epi8(x_zero, x_temp), YCC_C0);
+
+        x_b = _mm_add_epi16(MULHI_SSE2(x_u, YCC_C1), _mm_set1_epi16(YCC_COFF0));
+        x_g = _mm_sub_epi16(_mm_set1_epi16(YCC_COFF1),
+                            _mm_add_epi16(MULHI_SSE2(x_u, YCC_C4), MULHI_SSE2(x_v, YCC_C5)));
+        x_r = _mm_add_epi16(MULHI_SSE2(x_v, YCC_C8), _mm_set1_epi16(YCC_COFF2));
+
+        // each chroma value covers two pixels
+        x_b = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_add_epi16(x_y1, _mm_unpacklo_epi16(x_b, x_b)), 5),
+                _mm_srai_epi16(_mm_add_epi16(x_y2, _mm_unpackhi_epi16(x_b, x_b)), 5));
+        x_g = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_add_epi16(x_y1, _mm_unpacklo_epi16(x_g, x_g)), 5),
+                _mm_srai_epi16(_mm_add_epi16(x_y2, _mm_unpackhi_epi16(x_g, x_g)), 5));
+        x_r = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_add_epi16(x_y1, _mm_unpacklo_epi16(x_r, x_r)), 5),
+                _mm_srai_epi16(_mm_add_epi16(x_y2, _mm_unpackhi_epi16(x_r, x_r)), 5));
+
+        if (argb) {
+            x_c0 = x_aa; x_c1 = x_r; x_c2 = x_g; x_c3 = x_b;
+        } else {
+            x_c0 = x_b; x_c1 = x_g; x_c2 = x_r; x_c3 = x_aa;
+        }
+
+        x_01l = _mm_unpacklo_epi8(x_c0, x_c1);
+        x_01h = _mm_unpackhi_epi8(x_c0, x_c1);
+        x_23l = _mm_unpacklo_epi8(x_c2, x_c3);
+        x_23h = _mm_unpackhi_epi8(x_c2, x_c3);
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(x_01l, x_23l));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(x_01l, x_23l));
+        _mm_storeu_si128((__m128i*)(dst + 32), _mm_unpacklo_epi16(x_01h, x_23h));
+        _mm_storeu_si128((__m128i*)(dst + 48), _mm_unpackhi_epi16(x_01h, x_23h));
+
+        dst += 64;
+        y += 16;
+        u += 8 * uv_step;
+        v += 8 * uv_step;
+    }
+
+    if (i < width)
+        ColorConvert_row_c(dst, y, u, v, uv_step, width - i, argb);
+}
+#endif // ENABLE_SIMD_SSE2
+
+#if ENABLE_SIMD_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static int ColorConvert_HasAVX2(void)
+{
+#if defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+
+    // AVX and OSXSAVE, and the OS must preserve the YMM registers
+    __cpuid(info, 1);
+    if ((info[2] & 0x18000000) != 0x18000000 || (_xgetbv(0) & 6) != 6)
+        return 0;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & 0x20) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#define MULHI_AVX2(x, c) _mm256_mulhi_epu16(x, _mm256_set1_epi16(c))
+
+/* b = 16 chroma terms, returns their pixel sums with y1 (pixels 0-15) and y2 (16-31) */
+#define APPLY_CHROMA_AVX2(b, y1, y2)                                        \
+{                                                                           \
+    __m256i x_t = _mm256_permute4x64_epi64(b, 0xd8);                        \
+    b = _mm256_packus_epi16(                                                \
+        _mm256_srai_epi16(_mm256_add_epi16(y1, _mm256_unpacklo_epi16(x_t, x_t)), 5), \
+        _mm256_srai_epi16(_mm256_add_epi16(y2, _mm256_unpackhi_epi16(x_t, x_t)), 5)); \
+    b = _mm256_permute4x64_epi64(b, 0xd8);                                  \
+}
+
+TARGET_AVX2
+static void ColorConvert_row_avx2(uint8_t *dst,
+                                  const uint8_t *y,
+                                  const uint8_t *u,
+                                  const uint8_t *v,
+                                  int32_t uv_step,
+                                  int32_t width,
+                                  int32_t argb)
+{
+    const __m256i x_aa = _mm256_set1_epi8((char)0xff);
+    const __m256i x_hi = _mm256_set1_epi16((short)0xff00);
+    __m256i x_u, x_v, x_y1, x_y2, x_b, x_g, x_r, x_temp;
+    __m256i x_c0, x_c1, x_c2, x_c3, x_01l, x_01h, x_23l, x_23h;
+    __m256i x_q0, x_q1, x_q2, x_q3;
+    int32_t i;
+
+    // 32 pixels
+    for (i = 0; i <= width - 32; i += 32) {
+        if (uv_step == 2) {
+            x_temp = _mm256_loadu_si256((const __m256i*)u);
+            x_u = _mm256_slli_epi16(x_temp, 8);
+            x_v = _mm256_and_si256(x_temp, x_hi);
+        } else {
+            x_u = _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)u)), 8);
+            x_v = _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)v)), 8);
+        }
+        x_temp = _mm256_loadu_si256((const __m256i*)y);
+        x_y1 = _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(x_temp)), 8);
+        x_y2 = _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(x_temp, 1)), 8);
+        x_y1 = MULHI_AVX2(x_y1, YCC_C0);
+        x_y2 = MULHI_AVX2(x_y2, YCC_C0);
+
+        x_b = _mm256_add_epi16(MULHI_AVX2(x_u, YCC_C1), _mm256_set1_epi16(YCC_COFF0));
+        x_g = _mm256_sub_epi16(_mm256_set1_epi16(YCC_COFF1),
+                               _mm256_add_epi16(MULHI_AVX2(x_u, YCC_C4), MULHI_AVX2(x_v, YCC_C5)));
+        x_r = _mm256_add_epi16(MULHI_AVX2(x_v, YCC_C8), _mm256_set1_epi16(YCC_COFF2));
+
+        APPLY_CHROMA_AVX2(x_b, x_y1, x_y2);
+        APPLY_CHROMA_AVX2(x_g, x_y1, x_y2);
+        APPLY_CHROMA_AVX2(x_r, x_y1, x_y2);
+
+        if (argb) {
+            x_c0 = x_aa; x_c1 = x_r; x_c2 = x_g; x_c3 = x_b;
+        } else {
+            x_c0 = x_b; x_c1 = x_g; x_c2 = x_r; x_c3 = x_aa;
+        }
+
+        // unpacking works within 128 bit lanes, so the lanes hold pixels
+        // 0-3|16-19, 4-7|20-23, 8-11|24-27 and 12-15|28-31
+        x_01l = _mm256_unpacklo_epi8(x_c0, x_c1);
+        x_01h = _mm256_unpackhi_epi8(x_c0, x_c1);
+        x_23l = _mm256_unpacklo_epi8(x_c2, x_c3);
+        x_23h = _mm256_unpackhi_epi8(x_c2, x_c3);
+        x_q0 = _mm256_unpacklo_epi16(x_01l, x_23l);
+        x_q1 = _mm256_unpackhi_epi16(x_01l, x_23l);
+        x_q2 = _mm256_unpacklo_epi16(x_01h, x_23h);
+        x_q3 = _mm256_unpackhi_epi16(x_01h, x_23h);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_permute2x128_si256(x_q0, x_q1, 0x20));
+        _mm256_storeu_si256((__m256i*)(dst + 32), _mm256_permute2x128_si256(x_q2, x_q3, 0x20));
+        _mm256_storeu_si256((__m256i*)(dst + 64), _mm256_permute2x128_si256(x_q0, x_q1, 0x31));
+        _mm256_storeu_si256((__m256i*)(dst + 96), _mm256_permute2x128_si256(x_q2, x_q3, 0x31));
+
+        dst += 128;
+        y += 32;
+        u += 16 * uv_step;
+        v += 16 * uv_step;
+    }
+
+    if (i < width)
+        ColorConvert_row_sse2(dst, y, u, v, uv_step, width - i, argb);
+}
+#endif // ENABLE_SIMD_AVX2
+
+#if ENABLE_SIMD_NEON
+#include <arm_neon.h>
+
+/* x = 8 unsigned 8 bit values widened to 16 bits */
+static uint16x8_t ColorConvert_mulhi_neon(uint16x8_t x, uint16_t c)
+{
+    return vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(x), c), 8),
+                        vshrn_n_u32(vmull_n_u16(vget_high_u16(x), c), 8));
+}
+
+static uint8x16_t ColorConvert_apply_chroma_neon(int16x8_t c, int16x8_t y1, int16x8_t y2)
+{
+    int16x8x2_t x_c = vzipq_s16(c, c);
+
+    return vcombine_u8(vqshrun_n_s16(vaddq_s16(y1, x_c.val[0]), 5),
+                       vqshrun_n_s16(vaddq_s16(y2, x_c.val[1]), 5));
+}
+
+static void ColorConvert_row_neon(uint8_t *dst,
+                                  const uint8_t *y,
+                                  const uint8_t *u,
+                                  const uint8_t *v,
+                                  int32_t uv_step,
+                                  int32_t width,
+                                  int32_t argb)
+{
+    const uint8x16_t x_aa = vdupq_n_u8(0xff);
+    uint16x8_t x_u, x_v;
+    int16x8_t x_y1, x_y2, x_b, x_g, x_r;
+    uint8x16_t x_y;
+    uint8x16x4_t x_out;
+    int32_t i;
+
+    // 16 pixels
+    for (i = 0; i <= width - 16; i += 16) {
+        if (uv_step == 2) {
+            uint8x8x2_t x_uv = vld2_u8(u);
+            x_u = vmovl_u8(x_uv.val[0]);
+            x_v = vmovl_u8(x_uv.val[1]);
+        } else {
+            x_u = vmovl_u8(vld1_u8(u));
+            x_v = vmovl_u8(vld1_u8(v));
+        }
+        x_y = vld1q_u8(y);
+        x_y1 = vreinterpretq_s16_u16(ColorConvert_mulhi_neon(vmovl_u8(vget_low_u8(x_y)), YCC_C0));
+        x_y2 = vreinterpretq_s16_u16(ColorConvert_mulhi_neon(vmovl_u8(vget_high_u8(x_y)), YCC_C0));
+
+        x_b = vaddq_s16(vreinterpretq_s16_u16(ColorConvert_mulhi_neon(x_u, YCC_C1)),
+                        vdupq_n_s16(YCC_COFF0));
+        x_g = vsubq_s16(vdupq_n_s16(YCC_COFF1),
+                        vreinterpretq_s16_u16(vaddq_u16(ColorConvert_mulhi_neon(x_u, YCC_C4),
+                                                        ColorConvert_mulhi_neon(x_v, YCC_C5))));
+        x_r = vaddq_s16(vreinterpretq_s16_u16(ColorConvert_mulhi_neon(x_v, YCC_C8)),
+                        vdupq_n_s16(YCC_COFF2));
+
+        if (argb) {
+            x_out.val[0] = x_aa;
+            x_out.val[1] = ColorConvert_apply_chroma_neon(x_r, x_y1, x_y2);
+            x_out.val[2] = ColorConvert_apply_chroma_neon(x_g, x_y1, x_y2);
+            x_out.val[3] = ColorConvert_apply_chroma_neon(x_b, x_y1, x_y2);
+        } else {
+            x_out.val[0] = ColorConvert_apply_chroma_neon(x_b, x_y1, x_y2);
+            x_out.val[1] = ColorConvert_apply_chroma_neon(x_g, x_y1, x_y2);
+            x_out.val[2] = ColorConvert_apply_chroma_neon(x_r, x_y1, x_y2);
+            x_out.val[3] = x_aa;
+        }
+        vst4q_u8(dst, x_out);
+
+        dst += 64;
+        y += 16;
+        u += 8 * uv_step;
+        v += 8 * uv_step;
+    }
+
+    if (i < width)
+        ColorConvert_row_c(dst, y, u, v, uv_step, width - i, argb);
+}
+#endif // ENABLE_SIMD_NEON
+
+#if ENABLE_SIMD_AVX2
+/*
+ * Converts test rows with the AVX2 kernel and with the SSE2 and C kernels it
+ * must match. The rows cover planar and interleaved chroma, both pixel
+ * formats and widths that end in the SSE2 and C tails. Returns 0 if any
+ * pixel differs, the SSE2 kernel is used then.
+ */
+static int ColorConvert_CheckAVX2(void)
+{
+    enum { WIDTH = 75 };
+    uint8_t y[WIDTH], uv[WIDTH + 1];
+    uint8_t expected[WIDTH * 4], actual[WIDTH * 4], reference[WIDTH * 4];
+    int32_t i, uv_step, argb, width;
+
+    // every value from 0 to 255 appears in some plane, extremes included
+    for (i = 0; i < WIDTH; i++)
+        y[i] = (uint8_t)(i * 37 + (i & 1 ? 255 : 0));
+    for (i = 0; i <= WIDTH; i++)
+        uv[i] = (uint8_t)(i * 71 + 3);
+
+    for (uv_step = 1; uv_step <= 2; uv_step++) {
+        const uint8_t *u = uv;
+        const uint8_t *v = uv_step == 2 ? uv + 1 : uv + WIDTH / 2;
+
+        for (argb = 0; argb <= 1; argb++) {
+            for (width = WIDTH - 2; width <= WIDTH; width++) {
+                ColorConvert_row_c(expected, y, u, v, uv_step, width, argb);
+                ColorConvert_row_sse2(reference, y, u, v, uv_step, width, argb);
+                ColorConvert_row_avx2(actual, y, u, v, uv_step, width, argb);
+                if (memcmp(expected, reference, width * 4) != 0 ||
+                    memcmp(expected, actual, width * 4) != 0)
+                    return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+#endif // ENABLE_SIMD_AVX2
+
+static ColorConvertRowFunc ColorConvert_GetRowFunc(void)
+{
+    // Selecting the function is idempotent, so a race is harmless
+    static ColorConvertRowFunc rowFunc = NULL;
+
+    if (rowFunc == NULL) {
+#if ENABLE_SIMD_AVX2
+        if (ColorConvert_HasAVX2() && ColorConvert_CheckAVX2()) {
+            rowFunc = &ColorConvert_row_avx2;
+        } else {
+            rowFunc = &ColorConvert_row_sse2;
+        }
+#elif ENABLE_SIMD_SSE2
+        rowFunc = &ColorConvert_row_sse2;
+#elif ENABLE_SIMD_NEON
+        rowFunc = &ColorConvert_row_neon;
+#else
+        rowFunc = &ColorConvert_row_c;
+#endif
+    }
+
+    return rowFunc;
+}
+
+/*
+ * Converts a frame with a full resolution luma plane and chroma subsampled
+ * horizontally by two. Chroma rows are shared by (1 << uv_vshift) luma rows.
+ */
+static int ColorConvert_planes(uint8_t *dst,
+                               int32_t dst_stride,
+                               int32_t width,
+                               int32_t height,
+                               const uint8_t *y,
+                               const uint8_t *u,
+                               const uint8_t *v,
+                               int32_t y_stride,
+                               int32_t u_stride,
+                               int32_t v_stride,
+                               int32_t uv_step,
+                               int32_t uv_vshift,
+                               int32_t argb)
+{
+    ColorConvertRowFunc rowFunc;
+    int32_t j;
+
+    if (dst == NULL || y == NULL || u == NULL || v == NULL)
+        return 1;
+
+    if (width <= 0 || height <= 0)
+        return 1;
+
+    rowFunc = ColorConvert_GetRowFunc();
+    for (j = 0; j < height; j++) {
+        int32_t cj = j >> uv_vshift;
+
+        rowFunc(dst + (intptr_t)j * dst_stride,
+                y + (intptr_t)j * y_stride,
+                u + (intptr_t)cj * u_stride,
+                v + (intptr_t)cj * v_stride,
+                uv_step, width, argb);
+    }
+
+    return 0;
+}
+// --- End row conversion functions
+
 // --- Begin YCbCr420p conversion functions
 #if ENABLE_SIMD_SSE2
 // --- Begin SSE2 YCbCr420p conversion functions
@@ -990,6 +1453,14 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
     uint8_t *pY1, *pY2, *pU, *pV, *pD1, *pD2, *pd1, *pd2;
 
     __m128i (*load_si128) (const __m128i*);
+
+#if ENABLE_SIMD_AVX2
+    if (ColorConvert_GetRowFunc() == &ColorConvert_row_avx2) {
+        return ColorConvert_planes(argb, argb_stride, width, height, y, u, v,
+                                   y_stride, u_stride, v_stride, 1, 1, 1);
+    }
+#endif
+
     if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0)
         load_si128 = &inline_loadu_si128;
     else
@@ -1957,6 +2428,14 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
     uint8_t *pY1, *pY2, *pU, *pV, *pD1, *pD2, *pd1, *pd2;
 
     __m128i (*load_si128) (const __m128i*);
+
+#if ENABLE_SIMD_AVX2
+    if (ColorConvert_GetRowFunc() == &ColorConvert_row_avx2) {
+        return ColorConvert_planes(bgra, bgra_stride, width, height, y, u, v,
+                                   y_stride, u_stride, v_stride, 1, 1, 0);
+    }
+#endif
+
     if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0)
         load_si128 = &inline_loadu_si128;
     else
@@ -2384,7 +2863,8 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
                                      int32_t v_stride,
                                      int32_t u_stride)
 {
-    return 1; // NOTE: Not implemented
+    return ColorConvert_planes(argb, argb_stride, width, height, y, u, v,
+                               y_stride, u_stride, v_stride, 1, 1, 1);
 }
 
 int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
@@ -2508,46 +2988,69 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
                                               int32_t y_stride,
                                               int32_t v_stride,
                                               int32_t u_stride)
+{
+    return ColorConvert_planes(bgra, bgra_stride, width, height, y, u, v,
+                               y_stride, u_stride, v_stride, 1, 1, 0);
+}
+// --- End C YCbCr420p conversion functions
+#endif // ENABLE_SIMD_SSE2
+// --- End YCbCr420p conversion functions
+
+// --- Begin YCbCr422p conversion functions
+
+/*
+ * The 4:2:2 input of these functions is packed: y, u and v point into the
+ * same plane and advance by 2, 4 and 4 bytes per pair of pixels.
+ */
+static int ColorConvert_YCbCr422p_to_32(uint8_t *dst,
+                                        int32_t dst_stride,
+                                        int32_t width,
+                                        int32_t height,
+                                        const uint8_t *y,
+                                        const uint8_t *v,
+                                        const uint8_t *u,
+                                        int32_t y_stride,
+                                        int32_t uv_stride,
+                                        int32_t argb)
 {
     int32_t i, j;
-    const uint8_t *say1, *say2, *sau, *sav, *sly1, *sly2, *slu, *slv;
-    uint8_t *da1, *dl1, *da2, *dl2;
+    const uint8_t *say1, *sau, *sav, *sly1, *slu, *slv;
+    uint8_t *da1, *dl1;
 
     int32_t BBi = 554;
     int32_t RRi = 446;
 
+    // byte offsets of the color components in the destination pixel
+    const int32_t ai = argb ? 0 : 3;
+    const int32_t ri = argb ? 1 : 2;
+    const int32_t gi = argb ? 2 : 1;
+    const int32_t bi = argb ? 3 : 0;
+
     uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
 
-    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
+    if (dst == NULL || y == NULL || u == NULL || v == NULL)
         return 1;
 
     if (width <= 0 || height <= 0)
         return 1;
 
-    if ((width | height) & 1)
+    if (width & 1)
         return 1;
 
     sly1 = say1 = y;
-    sly2 = say2 = y + y_stride;
     slu = sau = u;
     slv = sav = v;
-    dl1 = da1 = bgra;
-    dl2 = da2 = bgra + bgra_stride;
+    dl1 = da1 = dst;
 
-    // non aligned case
-
-    for (j = 0; j < (height >> 1); j++) {
+    for (j = 0; j < height; j++) {
         for (i = 0; i < (width >> 1); i++) {
-            int32_t sf01, sf02, sf03, sf04, sf1, sf2, sfr,
-            sfg, sfb;
+            int32_t sf01, sf03, sf1, sf2, sfr, sfg, sfb;
 
             sf1 = sau[0];
             sf2 = sav[0];
 
             sf01 = say1[0];
-            sf03 = say1[1];
-            sf02 = say2[0];
-            sf04 = say2[1];
+            sf03 = say1[2];
 
             sfr = color_tRV[sf2] - RRi;
             sfg = color_tGU[sf1] - color_tGV[sf2];
@@ -2555,47 +3058,30 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
 
             sf01 = color_tYY[sf01];
             sf03 = color_tYY[sf03];
-            sf02 = color_tYY[sf02];
-            sf04 = color_tYY[sf04];
 
-            TCLAMP_U8(sf01 + sfr, da1[2]);
-            TCLAMP_U8(sf01 + sfg, da1[1]);
-            SCLAMP_U8(sf01 + sfb, da1[0]);
-            TCLAMP_U8(sf03 + sfr, da1[6]);
-            TCLAMP_U8(sf03 + sfg, da1[5]);
-            SCLAMP_U8(sf03 + sfb, da1[4]);
-            TCLAMP_U8(sf02 + sfr, da2[2]);
-            TCLAMP_U8(sf02 + sfg, da2[1]);
-            SCLAMP_U8(sf02 + sfb, da2[0]);
-            TCLAMP_U8(sf04 + sfr, da2[6]);
-            SCLAMP_U8(sf04 + sfg, da2[5]);
-            TCLAMP_U8(sf04 + sfb, da2[4]);
+            TCLAMP_U8(sf01 + sfr, da1[ri]);
+            TCLAMP_U8(sf01 + sfg, da1[gi]);
+            SCLAMP_U8(sf01 + sfb, da1[bi]);
+            TCLAMP_U8(sf03 + sfr, da1[ri + 4]);
+            TCLAMP_U8(sf03 + sfg, da1[gi + 4]);
+            SCLAMP_U8(sf03 + sfb, da1[bi + 4]);
 
-            da1[3] = da1[7] = da2[3] = da2[7] = 0xff;
+            da1[ai] = da1[ai + 4] = 0xff;
 
-            say1 += 2;
-            say2 += 2;
-            sau++;
-            sav++;
+            say1 += 4;
+            sau += 4;
+            sav += 4;
             da1 += 8;
-            da2 += 8;
         }
 
-        sly1 = say1 = ((uint8_t *)sly1 + 2 * y_stride);
-        sly2 = say2 = ((uint8_t *)sly2 + 2 * y_stride);
-        slu = sau = ((uint8_t *)slu + u_stride);
-        slv = sav = ((uint8_t *)slv + v_stride);
-        dl1 = da1 = ((uint8_t *)dl1 + 2 * bgra_stride);
-        dl2 = da2 = ((uint8_t *)dl2 + 2 * bgra_stride);
+        sly1 = say1 = ((uint8_t *)sly1 + y_stride);
+        slu = sau = ((uint8_t *)slu + uv_stride);
+        slv = sav = ((uint8_t *)slv + uv_stride);
+        dl1 = da1 = ((uint8_t *)dl1 + dst_stride);
     }
 
     return 0;
 }
-// --- End C YCbCr420p conversion functions
-#endif // ENABLE_SIMD_SSE2
-// --- End YCbCr420p conversion functions
-
-// --- Begin YCbCr422p conversion functions
 
 int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
                                               int32_t argb_stride,
@@ -2607,7 +3093,8 @@ int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
                                               int32_t y_stride,
                                               int32_t uv_stride)
 {
-    return 1; // NOTE: Not implemented
+    return ColorConvert_YCbCr422p_to_32(argb, argb_stride, width, height,
+                                        y, v, u, y_stride, uv_stride, 1);
 }
 
 int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
@@ -2620,67 +3107,73 @@ int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
                                               int32_t y_stride,
                                               int32_t uv_stride)
 {
-    int32_t i, j;
-    const uint8_t *say1, *sau, *sav, *sly1, *slu, *slv;
-    uint8_t *da1, *dl1;
-
-    int32_t BBi = 554;
-    int32_t RRi = 446;
+    return ColorConvert_YCbCr422p_to_32(bgra, bgra_stride, width, height,
+                                        y, v, u, y_stride, uv_stride, 0);
+}
+// --- End YCbCr422p conversion functions
 
-    uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
+// --- Begin planar YCbCr422 conversion functions
+int ColorConvert_YCbCr422_planar_to_ARGB32_no_alpha(uint8_t *argb,
+                                                    int32_t argb_stride,
+                                                    int32_t width,
+                                                    int32_t height,
+                                                    const uint8_t *y,
+                                                    const uint8_t *v,
+                                                    const uint8_t *u,
+                                                    int32_t y_stride,
+                                                    int32_t v_stride,
+                                                    int32_t u_stride)
+{
+    return ColorConvert_planes(argb, argb_stride, width, height, y, u, v,
+                               y_stride, u_stride, v_stride, 1, 0, 1);
+}
 
-    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
+int ColorConvert_YCbCr422_planar_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                    int32_t bgra_stride,
+                                                    int32_t width,
+                                                    int32_t height,
+                                                    const uint8_t *y,
+                                                    const uint8_t *v,
+                                                    const uint8_t *u,
+                                                    int32_t y_stride,
+                                                    int32_t v_stride,
+                                                    int32_t u_stride)
+{
+    return ColorConvert_planes(bgra, bgra_stride, width, height, y, u, v,
+                               y_stride, u_stride, v_stride, 1, 0, 0);
+}
+// --- End planar YCbCr422 conversion functions
+
+// --- Begin YCbCr420sp (NV12) conversion functions
+int ColorConvert_YCbCr420sp_to_ARGB32_no_alpha(uint8_t *argb,
+                                               int32_t argb_stride,
+                                               int32_t width,
+                                               int32_t height,
+                                               const uint8_t *y,
+                                               const uint8_t *uv,
+                                               int32_t y_stride,
+                                               int32_t uv_stride)
+{
+    if (uv == NULL)
         return 1;
 
-    if (width <= 0 || height <= 0)
-        return 1;
+    return ColorConvert_planes(argb, argb_stride, width, height, y, uv, uv + 1,
+                               y_stride, uv_stride, uv_stride, 2, 1, 1);
+}
 
-    if (width & 1)
+int ColorConvert_YCbCr420sp_to_BGRA32_no_alpha(uint8_t *bgra,
+                                               int32_t bgra_stride,
+                                               int32_t width,
+                                               int32_t height,
+                                               const uint8_t *y,
+                                               const uint8_t *uv,
+                                               int32_t y_stride,
+                                               int32_t uv_stride)
+{
+    if (uv == NULL)
         return 1;
 
-    sly1 = say1 = y;
-    slu = sau = u;
-    slv = sav = v;
-    dl1 = da1 = bgra;
-
-    for (j = 0; j < height; j++) {
-        for (i = 0; i < (width >> 1); i++) {
-            int32_t sf01, sf03, sf1, sf2, sfr, sfg, sfb;
-
-            sf1 = sau[0];
-            sf2 = sav[0];
-
-            sf01 = say1[0];
-            sf03 = say1[2];
-
-            sfr = color_tRV[sf2] - RRi;
-            sfg = color_tGU[sf1] - color_tGV[sf2];
-            sfb = color_tBU[sf1] - BBi;
-
-            sf01 = color_tYY[sf01];
-            sf03 = color_tYY[sf03];
-
-            TCLAMP_U8(sf01 + sfr, da1[2]);
-            TCLAMP_U8(sf01 + sfg, da1[1]);
-            SCLAMP_U8(sf01 + sfb, da1[0]);
-            TCLAMP_U8(sf03 + sfr, da1[6]);
-            TCLAMP_U8(sf03 + sfg, da1[5]);
-            SCLAMP_U8(sf03 + sfb, da1[4]);
-
-            da1[3] = da1[7] = 0xff;
-
-            say1 += 4;
-            sau += 4;
-            sav += 4;
-            da1 += 8;
-        }
-
-        sly1 = say1 = ((uint8_t *)sly1 + y_stride);
-        slu = sau = ((uint8_t *)slu + uv_stride);
-        slv = sav = ((uint8_t *)slv + uv_stride);
-        dl1 = da1 = ((uint8_t *)dl1 + bgra_stride);
-    }
-
-    return 0;
+    return ColorConvert_planes(bgra, bgra_stride, width, height, y, uv, uv + 1,
+                               y_stride, uv_stride, uv_stride, 2, 1, 0);
 }
-// --- End YCbCr422p conversion functions
+// --- End YCbCr420sp (NV12) conversion functions
@@ -101,6 +101,48 @@ extern "C" {
                                                   int32_t y_stride,
                                                   int32_t uv_stride);
 
+    // Planar 4:2:2 (I422), one chroma row per luma row.
+    int ColorConvert_YCbCr422_planar_to_ARGB32_no_alpha(uint8_t *argb,
+                                                        int32_t argb_stride,
+                                                        int32_t width,
+                                                        int32_t height,
+                                                        const uint8_t *y,
+                                                        const uint8_t *v,
+                                                        const uint8_t *u,
+                                                        int32_t y_stride,
+                                                        int32_t v_stride,
+                                                        int32_t u_stride);
+
+    int ColorConvert_YCbCr422_planar_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                        int32_t bgra_stride,
+                                                        int32_t width,
+                                                        int32_t height,
+                                                        const uint8_t *y,
+                                                        const uint8_t *v,
+                                                        const uint8_t *u,
+                                                        int32_t y_stride,
+                                                        int32_t v_stride,
+                                                        int32_t u_stride);
+
+    // Semi-planar 4:2:0 (NV12), interleaved Cb/Cr samples in a single plane.
+    int ColorConvert_YCbCr420sp_to_ARGB32_no_alpha(uint8_t *argb,
+                                                   int32_t argb_stride,
+                                                   int32_t width,
+                                                   int32_t height,
+                                                   const uint8_t *y,
+                                                   const uint8_t *uv,
+                                                   int32_t y_stride,
+                                                   int32_t uv_stride);
+
+    int ColorConvert_YCbCr420sp_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                   int32_t bgra_stride,
+                                                   int32_t width,
+                                                   int32_t height,
+                                                   const uint8_t *y,
+                                                   const uint8_t *uv,
+                                                   int32_t y_stride,
+                                                   int32_t uv_stride);
+
 #ifdef __cplusplus
 };
 #endif
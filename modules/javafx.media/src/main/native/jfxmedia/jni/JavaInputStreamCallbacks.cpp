@@ -35,6 +35,8 @@ jfieldID  CJavaInputStreamCallbacks::m_BufferFID = 0;
 jmethodID CJavaInputStreamCallbacks::m_NeedBufferMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_ReadNextBlockMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_ReadBlockMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_ReadNextBlockIntoMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_ReadBlockIntoMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_IsSeekableMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_IsRandomAccessMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_SeekMID = 0;
@@ -112,6 +114,18 @@ bool CJavaInputStreamCallbacks::Init(JNIEnv *env, jobject jLocator)
             hasException = javaEnv.reportException();
         }
 
+        if (!hasException)
+        {
+            m_ReadNextBlockIntoMID = env->GetMethodID(klass, "readNextBlock", "(Ljava/nio/ByteBuffer;)I");
+            hasException = javaEnv.reportException();
+        }
+
+        if (!hasException)
+        {
+            m_ReadBlockIntoMID = env->GetMethodID(klass, "readBlock", "(JLjava/nio/ByteBuffer;)I");
+            hasException = javaEnv.reportException();
+        }
+
         if (!hasException)
         {
             m_IsSeekableMID = env->GetMethodID(klass, "isSeekable", "()Z");
@@ -235,6 +249,59 @@ void CJavaInputStreamCallbacks::CopyBlock(void* destination, int size)
     }
  }
 
+int CJavaInputStreamCallbacks::ReadNextBlockInto(void* destination, int size)
+{
+    int result = -1;
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        // Java side reads straight into the native memory, no copy through the holder's buffer
+        jobject target = pEnv->NewDirectByteBuffer(destination, (jlong)size);
+        if (connection && target) {
+            result = pEnv->CallIntMethod(connection, m_ReadNextBlockIntoMID, target);
+        }
+
+        if (target)
+            pEnv->DeleteLocalRef(target);
+        if (connection)
+            pEnv->DeleteLocalRef(connection);
+
+        if (javaEnv.clearException()) {
+            result = -2;
+        }
+    }
+
+    return result;
+}
+
+int CJavaInputStreamCallbacks::ReadBlockInto(int64_t position, void* destination, int size)
+{
+    int result = -1;
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        jobject target = pEnv->NewDirectByteBuffer(destination, (jlong)size);
+        if (connection && target) {
+            result = pEnv->CallIntMethod(connection, m_ReadBlockIntoMID, (jlong)position, target);
+        }
+
+        if (target)
+            pEnv->DeleteLocalRef(target);
+        if (connection)
+            pEnv->DeleteLocalRef(connection);
+
+        if (javaEnv.clearException()) {
+            result = -2;
+        }
+    }
+
+    return result;
+}
+
 bool CJavaInputStreamCallbacks::IsSeekable()
 {
     CJavaEnvironment javaEnv(m_jvm);
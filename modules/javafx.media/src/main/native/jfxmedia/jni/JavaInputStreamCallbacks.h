@@ -41,6 +41,8 @@ virtual ~CJavaInputStreamCallbacks();
     int  ReadNextBlock();
     int  ReadBlock(int64_t position, int size);
     void CopyBlock(void* destination, int size);
+    int  ReadNextBlockInto(void* destination, int size);
+    int  ReadBlockInto(int64_t position, void* destination, int size);
     bool IsSeekable();
     bool IsRandomAccess();
     int64_t Seek(int64_t position);
@@ -56,6 +58,8 @@ private:
     static jmethodID m_NeedBufferMID;
     static jmethodID m_ReadNextBlockMID;
     static jmethodID m_ReadBlockMID;
+    static jmethodID m_ReadNextBlockIntoMID;
+    static jmethodID m_ReadBlockIntoMID;
     static jmethodID m_IsSeekableMID;
     static jmethodID m_IsRandomAccessMID;
     static jmethodID m_SeekMID;
@@ -71,10 +71,11 @@ extern "C" {
         return result;
     }
 
-    static jint InitMedia(JNIEnv *env, CPipelineOptions* pOptions, jobject jLocator, jstring jContentType, jlong jSizeHint,
-                          jlongArray jlMediaHandle)
+    static jint InitMedia(JNIEnv *env, jint jDecoderThreads, jlong jCacheBudget, jobject jLocator, jstring jContentType,
+                          jlong jSizeHint, jlongArray jlMediaHandle)
     {
         CMedia*         pMedia = NULL;
+        CPipelineOptions* pOptions = NULL;
         char*           pjContent = (char*)env->GetStringUTFChars(jContentType , NULL);
         jstring         jLocation = LocatorToString(env, jLocator);
         char*           pjLocation = NULL;
@@ -127,6 +128,16 @@ extern "C" {
         if (NULL == locator)
             return ERROR_MEMORY_ALLOCATION;
 
+        //***** Create the pipeline options, owned by the pipeline from here on
+        pOptions = new (nothrow) CPipelineOptions();
+        if (NULL == pOptions)
+        {
+            delete locator;
+            return ERROR_MEMORY_ALLOCATION;
+        }
+        pOptions->SetVideoDecoderThreads((int)jDecoderThreads);
+        pOptions->SetCacheBudget((int64_t)jCacheBudget);
+
         //***** Create the media object
         uErrCode  = pManager->CreatePlayer(locator, pOptions, &pMedia);
 
@@ -166,11 +177,12 @@ extern "C" {
      * @return  Media reference.  This reference must be used when calling GSTMediaPlayer function.
      */
     JNIEXPORT jint JNICALL Java_com_sun_media_jfxmediaimpl_platform_gstreamer_GSTMedia_gstInitNativeMedia
-    (JNIEnv *env, jobject obj, jobject jLocator, jstring jContentType, jlong jSizeHint, jlongArray jlMediaHandle)
+    (JNIEnv *env, jobject obj, jobject jLocator, jstring jContentType, jlong jSizeHint, jint jDecoderThreads,
+     jlong jCacheBudget, jlongArray jlMediaHandle)
     {
         LOWLEVELPERF_EXECTIMESTART("gstInitNativeMediaToSendToJavaPlayerStateEventPaused");
         LOWLEVELPERF_EXECTIMESTART("gstInitNativeMedia()");
-        uint32_t result = InitMedia(env, NULL, jLocator, jContentType, jSizeHint, jlMediaHandle);
+        uint32_t result = InitMedia(env, jDecoderThreads, jCacheBudget, jLocator, jContentType, jSizeHint, jlMediaHandle);
         LOWLEVELPERF_EXECTIMESTOP("gstInitNativeMedia()");
 
         return result;
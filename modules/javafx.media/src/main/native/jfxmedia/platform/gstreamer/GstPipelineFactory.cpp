@@ -205,13 +205,17 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
 
             g_signal_connect (javaSource, "read-next-block", G_CALLBACK (SourceReadNextBlock), callbacks);
             g_signal_connect (javaSource, "copy-block", G_CALLBACK (SourceCopyBlock), callbacks);
+            g_signal_connect (javaSource, "read-next-block-into", G_CALLBACK (SourceReadNextBlockInto), callbacks);
             g_signal_connect (javaSource, "seek-data", G_CALLBACK (SourceSeekData), callbacks);
             g_signal_connect (javaSource, "close-connection", G_CALLBACK (SourceCloseConnection), callbacks);
             g_signal_connect (javaSource, "property", G_CALLBACK (SourceProperty), callbacks);
             g_signal_connect (javaSource, "get-stream-size", G_CALLBACK (SourceGetStreamSize), callbacks);
 
             if (isRandomAccess)
+            {
                 g_signal_connect (javaSource, "read-block", G_CALLBACK (SourceReadBlock), callbacks);
+                g_signal_connect (javaSource, "read-block-into", G_CALLBACK (SourceReadBlockInto), callbacks);
+            }
 
             if (hlsMode == 1)
                 g_object_set (javaSource, "hls-mode", TRUE, NULL);
@@ -247,6 +251,9 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
                 if (NULL == buffer)
                     return ERROR_GSTREAMER_ELEMENT_CREATE;
 
+                if (hlsMode != 1 && pOptions->GetCacheBudget() > 0)
+                    g_object_set (buffer, "cache-budget", (gint64)pOptions->GetCacheBudget(), NULL);
+
                 gst_bin_add_many(GST_BIN(source), javaSource, buffer, NULL);
 
                 if (!gst_element_link(javaSource, buffer))
@@ -297,6 +304,16 @@ void CGstPipelineFactory::SourceCopyBlock(GstElement *src, gpointer buffer, int
     ((CStreamCallbacks*)data)->CopyBlock(buffer, size);
 }
 
+gint CGstPipelineFactory::SourceReadNextBlockInto(GstElement *src, gpointer buffer, int size, gpointer data)
+{
+    return ((CStreamCallbacks*)data)->ReadNextBlockInto(buffer, size);
+}
+
+gint CGstPipelineFactory::SourceReadBlockInto(GstElement *src, guint64 position, gpointer buffer, int size, gpointer data)
+{
+    return ((CStreamCallbacks*)data)->ReadBlockInto((int64_t)position, buffer, size);
+}
+
 gint64 CGstPipelineFactory::SourceSeekData(GstElement *src, guint64 offset, gpointer data)
 {
     return (gint64)((CStreamCallbacks*)data)->Seek((int64_t)offset);
@@ -319,6 +336,8 @@ void CGstPipelineFactory::SourceCloseConnection(GstElement *src, gpointer data)
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReadNextBlock), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReadBlock), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceCopyBlock), callbacks);
+    g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReadNextBlockInto), callbacks);
+    g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReadBlockInto), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceSeekData), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceCloseConnection), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceProperty), callbacks);
@@ -651,6 +670,9 @@ uint32_t CGstPipelineFactory::CreateAVPipeline(GstElement* source, const char* s
         g_object_set(G_OBJECT(elements[VIDEO_DECODER]), "location", location, NULL);
     }
 
+    if (elements[VIDEO_DECODER] != NULL && NULL != g_object_class_find_property(G_OBJECT_GET_CLASS(G_OBJECT(elements[VIDEO_DECODER])), "thread-count"))
+        g_object_set(G_OBJECT(elements[VIDEO_DECODER]), "thread-count", pOptions->GetVideoDecoderThreads(), NULL);
+
     *ppPipeline = new CGstAVPlaybackPipeline(elements, audioFlags, pOptions);
     if( NULL == *ppPipeline)
         return ERROR_MEMORY_ALLOCATION;
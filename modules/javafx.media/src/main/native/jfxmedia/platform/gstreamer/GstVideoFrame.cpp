@@ -72,6 +72,157 @@ static GstBuffer *alloc_aligned_buffer(guint size)
     return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, alignedSize, 0, alignedSize, newData, free_aligned_buffer);
 }
 
+// Frames of at least this many pixels are converted in horizontal bands,
+// one of them on the calling thread and the others on a shared thread pool.
+#define PARALLEL_CONVERT_MIN_PIXELS (1280 * 720)
+#define PARALLEL_CONVERT_MAX_BANDS  4
+
+typedef struct {
+    GMutex lock;
+    GCond  cond;
+    gint   pending;
+} ConvertSync;
+
+typedef struct {
+    bool           argb;
+    uint8_t       *dst;
+    int32_t        dstStride;
+    int32_t        width;
+    int32_t        height;
+    const uint8_t *y;
+    const uint8_t *v;
+    const uint8_t *u;
+    const uint8_t *a; // NULL if there is no alpha plane
+    int32_t        yStride;
+    int32_t        vStride;
+    int32_t        uStride;
+    int32_t        aStride;
+    int            status;
+    ConvertSync   *sync;
+} ConvertYCbCr420pJob;
+
+static int convert_YCbCr420p_band(const ConvertYCbCr420pJob *job)
+{
+    if (job->argb) {
+        if (job->a) {
+            return ColorConvert_YCbCr420p_to_ARGB32(job->dst, job->dstStride, job->width, job->height,
+                                                    job->y, job->v, job->u, job->a,
+                                                    job->yStride, job->vStride, job->uStride, job->aStride);
+        }
+        return ColorConvert_YCbCr420p_to_ARGB32_no_alpha(job->dst, job->dstStride, job->width, job->height,
+                                                         job->y, job->v, job->u,
+                                                         job->yStride, job->vStride, job->uStride);
+    }
+
+    if (job->a) {
+        return ColorConvert_YCbCr420p_to_BGRA32(job->dst, job->dstStride, job->width, job->height,
+                                                job->y, job->v, job->u, job->a,
+                                                job->yStride, job->vStride, job->uStride, job->aStride);
+    }
+    return ColorConvert_YCbCr420p_to_BGRA32_no_alpha(job->dst, job->dstStride, job->width, job->height,
+                                                     job->y, job->v, job->u,
+                                                     job->yStride, job->vStride, job->uStride);
+}
+
+static void convert_band_func(gpointer data, gpointer user_data)
+{
+    ConvertYCbCr420pJob *band = (ConvertYCbCr420pJob*)data;
+
+    band->status = convert_YCbCr420p_band(band);
+
+    g_mutex_lock(&band->sync->lock);
+    if (--band->sync->pending == 0) {
+        g_cond_signal(&band->sync->cond);
+    }
+    g_mutex_unlock(&band->sync->lock);
+}
+
+// Number of bands a large frame is split into, set by get_convert_pool()
+static int convertBandCount = 1;
+
+// Returns NULL on single processor systems
+static GThreadPool *get_convert_pool()
+{
+    static gsize pool = 0;
+
+// INLINE - g_once_init_enter()
+    if (g_once_init_enter(&pool)) {
+        guint workers = MIN(g_get_num_processors(), PARALLEL_CONVERT_MAX_BANDS) - 1;
+        GThreadPool *newPool = NULL;
+
+        if (workers > 0) {
+            newPool = g_thread_pool_new(convert_band_func, NULL, (gint)workers, FALSE, NULL);
+        }
+        if (newPool) {
+            convertBandCount = (int)workers + 1;
+        }
+        // g_once_init_leave() does not accept 0, so mark "no pool" with 1
+        g_once_init_leave(&pool, newPool ? (gsize)newPool : 1);
+    }
+
+    return pool != 1 ? (GThreadPool*)pool : NULL;
+}
+
+static int convert_YCbCr420p(const ConvertYCbCr420pJob *job)
+{
+    ConvertYCbCr420pJob bands[PARALLEL_CONVERT_MAX_BANDS];
+    ConvertSync sync;
+    GThreadPool *pool = NULL;
+    int32_t bandHeight, row = 0;
+    int bandCount = 0, ii, status = 0;
+
+    if ((gint64)job->width * job->height >= PARALLEL_CONVERT_MIN_PIXELS) {
+        pool = get_convert_pool();
+    }
+    if (pool == NULL) {
+        return convert_YCbCr420p_band(job);
+    }
+
+    // Bands start on even rows so they don't split a chroma row
+    bandHeight = ((job->height + convertBandCount - 1) / convertBandCount + 1) & ~1;
+    while (row < job->height && bandCount < PARALLEL_CONVERT_MAX_BANDS) {
+        ConvertYCbCr420pJob *band = &bands[bandCount++];
+
+        *band = *job;
+        band->height = MIN(bandHeight, job->height - row);
+        band->dst += (intptr_t)row * job->dstStride;
+        band->y += (intptr_t)row * job->yStride;
+        band->v += (intptr_t)(row / 2) * job->vStride;
+        band->u += (intptr_t)(row / 2) * job->uStride;
+        if (band->a) {
+            band->a += (intptr_t)row * job->aStride;
+        }
+        band->sync = &sync;
+        row += band->height;
+    }
+
+    g_mutex_init(&sync.lock);
+    g_cond_init(&sync.cond);
+    sync.pending = bandCount - 1;
+
+    for (ii = 1; ii < bandCount; ii++) {
+        g_thread_pool_push(pool, &bands[ii], NULL);
+    }
+    bands[0].status = convert_YCbCr420p_band(&bands[0]);
+
+    g_mutex_lock(&sync.lock);
+    while (sync.pending > 0) {
+        g_cond_wait(&sync.cond, &sync.lock);
+    }
+    g_mutex_unlock(&sync.lock);
+
+    g_cond_clear(&sync.cond);
+    g_mutex_clear(&sync.lock);
+
+    for (ii = 0; ii < bandCount; ii++) {
+        if (bands[ii].status != 0) {
+            status = bands[ii].status;
+        }
+    }
+
+    return status;
+}
+
 GstCaps *create_RGB_caps(CVideoFrame::FrameType type, guint width, guint height, guint encodedWidth, guint encodedHeight, guint stride)
 {
     gint red_mask, green_mask, blue_mask, alpha_mask;
@@ -430,49 +581,23 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
     }
 
     // now do the conversion
-    if (destType == ARGB) {
-        if (m_bHasAlpha) {
-            status = ColorConvert_YCbCr420p_to_ARGB32(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        (const uint8_t*)m_pvPlaneData[3],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index], m_puiPlaneStrides[3]);
-        } else {
-            status = ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index]);
-        }
-    } else {
-        if (m_bHasAlpha) {
-            status = ColorConvert_YCbCr420p_to_BGRA32(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        (const uint8_t*)m_pvPlaneData[3],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index], m_puiPlaneStrides[3]);
-        } else {
-            status = ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index]);
-        }
-    }
+    ConvertYCbCr420pJob job;
+    job.argb = (destType == ARGB);
+    job.dst = info.data;
+    job.dstStride = stride;
+    job.width = m_uiEncodedWidth;
+    job.height = m_uiEncodedHeight;
+    job.y = (const uint8_t*)m_pvPlaneData[0];
+    job.v = (const uint8_t*)m_pvPlaneData[v_index];
+    job.u = (const uint8_t*)m_pvPlaneData[u_index];
+    job.a = m_bHasAlpha ? (const uint8_t*)m_pvPlaneData[3] : NULL;
+    job.yStride = m_puiPlaneStrides[0];
+    job.vStride = m_puiPlaneStrides[v_index];
+    job.uStride = m_puiPlaneStrides[u_index];
+    job.aStride = m_bHasAlpha ? m_puiPlaneStrides[3] : 0;
+    job.status = 0;
+    job.sync = NULL;
+    status = convert_YCbCr420p(&job);
 
     gst_buffer_unmap(destBuffer, &info);
 
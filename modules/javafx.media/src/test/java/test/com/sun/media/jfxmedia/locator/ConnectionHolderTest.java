@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.media.jfxmedia.locator;
+
+import com.sun.media.jfxmedia.locator.ConnectionHolder;
+import java.io.File;
+import java.io.IOException;
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.net.URI;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.file.Files;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+public class ConnectionHolderTest {
+
+    private static final int SIZE = 10000;
+
+    private byte[] data;
+    private File file;
+
+    @Before
+    public void setUp() throws IOException {
+        data = new byte[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            data[i] = (byte) (i * 7 + (i >> 8));
+        }
+        file = File.createTempFile("connectionholder", ".bin");
+        Files.write(file.toPath(), data);
+    }
+
+    @After
+    public void tearDown() {
+        file.delete();
+    }
+
+    // The factories and readBlock are package private, the holders are only
+    // created and read by Locator and the native source.
+    private static Object invoke(String name, Class<?>[] types, Object target, Object... args)
+            throws Exception {
+        Method method = ConnectionHolder.class.getDeclaredMethod(name, types);
+        method.setAccessible(true);
+        try {
+            return method.invoke(target, args);
+        } catch (InvocationTargetException e) {
+            if (e.getCause() instanceof Exception) {
+                throw (Exception) e.getCause();
+            }
+            throw e;
+        }
+    }
+
+    private ConnectionHolder createFileHolder() throws Exception {
+        return (ConnectionHolder) invoke("createFileConnectionHolder",
+                new Class<?>[] { URI.class }, null, file.toURI());
+    }
+
+    private ConnectionHolder createMemoryHolder(ByteBuffer buffer) throws Exception {
+        return (ConnectionHolder) invoke("createMemoryConnectionHolder",
+                new Class<?>[] { ByteBuffer.class }, null, buffer);
+    }
+
+    private static int readBlock(ConnectionHolder holder, long position, ByteBuffer target)
+            throws Exception {
+        return (Integer) invoke("readBlock",
+                new Class<?>[] { long.class, ByteBuffer.class }, holder, position, target);
+    }
+
+    private void checkData(ByteBuffer target, int offset, long position, int length) {
+        for (int i = 0; i < length; i++) {
+            assertEquals("byte " + i, data[(int) position + i], target.get(offset + i));
+        }
+    }
+
+    private void testReadBlock(ConnectionHolder holder) throws Exception {
+        ByteBuffer target = ByteBuffer.allocateDirect(4096);
+
+        // A whole block, from the start and from the middle
+        assertEquals(4096, readBlock(holder, 0, target));
+        assertEquals(4096, target.position());
+        checkData(target, 0, 0, 4096);
+
+        target.clear();
+        assertEquals(4096, readBlock(holder, 5000, target));
+        checkData(target, 0, 5000, 4096);
+
+        // Never more than the target can take, at the target's position
+        target.clear();
+        target.position(10).limit(110);
+        assertEquals(100, readBlock(holder, 1234, target));
+        assertEquals(110, target.position());
+        checkData(target, 10, 1234, 100);
+
+        // Going backwards
+        target.clear();
+        assertEquals(4096, readBlock(holder, 100, target));
+        checkData(target, 0, 100, 4096);
+
+        // The tail of the stream
+        target.clear();
+        assertEquals(SIZE - 9000, readBlock(holder, 9000, target));
+        assertEquals(SIZE - 9000, target.position());
+        checkData(target, 0, 9000, SIZE - 9000);
+
+        // Past the end of the stream
+        target.clear();
+        assertEquals(-1, readBlock(holder, SIZE + 1, target));
+        assertEquals(0, target.position());
+    }
+
+    private void testClosed(ConnectionHolder holder) throws Exception {
+        holder.closeConnection();
+        try {
+            readBlock(holder, 0, ByteBuffer.allocateDirect(16));
+            fail("ClosedChannelException expected");
+        } catch (ClosedChannelException e) {
+        }
+    }
+
+    @Test
+    public void testFileReadBlock() throws Exception {
+        ConnectionHolder holder = createFileHolder();
+        try {
+            testReadBlock(holder);
+
+            // Exactly at the end of the file
+            assertEquals(-1, readBlock(holder, SIZE, ByteBuffer.allocateDirect(16)));
+        } finally {
+            holder.closeConnection();
+        }
+    }
+
+    @Test
+    public void testFileReadBlockClosed() throws Exception {
+        testClosed(createFileHolder());
+    }
+
+    @Test
+    public void testMemoryReadBlock() throws Exception {
+        testReadBlock(createMemoryHolder(ByteBuffer.wrap(data)));
+    }
+
+    @Test
+    public void testDirectMemoryReadBlock() throws Exception {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(SIZE);
+        buffer.put(data).rewind();
+        testReadBlock(createMemoryHolder(buffer));
+
+        // The source buffer is not moved by the holder
+        assertEquals(0, buffer.position());
+        assertEquals(SIZE, buffer.limit());
+    }
+
+    @Test
+    public void testMemoryReadBlockThenNextBlock() throws Exception {
+        ConnectionHolder holder = createMemoryHolder(ByteBuffer.wrap(data));
+        ByteBuffer target = ByteBuffer.allocateDirect(100);
+
+        // Like readBlock(long, int), the stream continues after the block
+        assertEquals(100, readBlock(holder, 2000, target));
+        target.clear();
+        assertEquals(100, holder.readNextBlock(target));
+        checkData(target, 0, 2100, 100);
+    }
+
+    @Test
+    public void testMemoryReadBlockClosed() throws Exception {
+        testClosed(createMemoryHolder(ByteBuffer.wrap(data)));
+    }
+}
@@ -99,7 +99,7 @@ final class RTImage extends PrismImage implements ResourceFactoryListener {
         return g;
     }
 
-    private RTTexture getTexture() {
+    RTTexture getTexture() {
         if (txt != null && txt.isSurfaceLost()) {
             log.fine("RTImage::getTexture : surface lost: " + this);
         }
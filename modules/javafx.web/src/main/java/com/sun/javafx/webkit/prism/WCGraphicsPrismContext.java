@@ -854,6 +854,41 @@ class WCGraphicsPrismContext extends WCGraphicsContext {
         }
     }
 
+    @Override
+    public void drawImageMasked(final WCImage img, final WCImage mask) {
+        if (log.isLoggable(Level.FINE)) {
+            log.fine("drawImageMasked(img, mask)");
+        }
+        if (!(img instanceof RTImage) || !(mask instanceof RTImage)) {
+            return;
+        }
+        new Composite() {
+            @Override void doPaint(Graphics g) {
+                RTTexture imgtex = ((RTImage) img).getTexture();
+                RTTexture masktex = ((RTImage) mask).getTexture();
+                if (imgtex == null || masktex == null) {
+                    return;
+                }
+                // Both images are device pixel sized, as is the target
+                int w = Math.min(imgtex.getContentWidth(), masktex.getContentWidth());
+                int h = Math.min(imgtex.getContentHeight(), masktex.getContentHeight());
+                if (g instanceof MaskTextureGraphics && ! (g instanceof PrinterGraphics)) {
+                    ((MaskTextureGraphics) g).drawPixelsMasked(imgtex, masktex,
+                                                               0, 0, w, h, 0, 0, 0, 0);
+                } else {
+                    FilterContext fctx = getFilterContext(g);
+                    Blend blend = new Blend(Blend.Mode.SRC_IN,
+                            new PassThrough(PrDrawable.create(fctx, masktex), w, h),
+                            new PassThrough(PrDrawable.create(fctx, imgtex), w, h));
+                    Affine3D tx = new Affine3D(g.getTransformNoClone());
+                    g.setTransform(BaseTransform.IDENTITY_TRANSFORM);
+                    PrEffectHelper.render(blend, g, 0, 0, null);
+                    g.setTransform(tx);
+                }
+            }
+        }.paint();
+    }
+
     @Override
     public void drawBitmapImage(final ByteBuffer image, final int x, final int y, final int w, final int h) {
         if (!shouldRenderRect(x, y, w, h, null, null)) {
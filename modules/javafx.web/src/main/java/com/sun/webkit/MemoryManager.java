@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+/**
+ * A collection of static methods for managing the memory used by WebKit.
+ * WebKit caches are shared by all the pages of the process, so the limits
+ * set here apply to all the pages at once. The methods must be called on
+ * the event thread.
+ */
+public final class MemoryManager {
+
+    /**
+     * Purges the font, style and layout caches and the resources of the
+     * memory cache that are not used by any page.
+     */
+    public static final int PURGE_CACHES = 0;
+
+    /**
+     * In addition to {@link #PURGE_CACHES}, discards the decoded data of
+     * the images used by the pages, discards the compiled JavaScript code
+     * and collects the JavaScript heap.
+     */
+    public static final int PURGE_DECODED_DATA = 1;
+
+    /**
+     * In addition to {@link #PURGE_DECODED_DATA}, empties the page cache.
+     */
+    public static final int PURGE_ALL = 2;
+
+    /**
+     * The private default constructor. Ensures non-instantiability.
+     */
+    private MemoryManager() {
+        throw new AssertionError();
+    }
+
+
+    /**
+     * Returns the memory footprint of the process, including the Java heap.
+     * @return the memory footprint of the process, in bytes.
+     */
+    public static long getMemoryFootprint() {
+        return twkGetMemoryFootprint();
+    }
+
+    /**
+     * Returns the memory limit of the process.
+     * @return the current memory limit, in bytes, or zero if there is none.
+     */
+    public static long getMemoryLimit() {
+        return twkGetMemoryLimit();
+    }
+
+    /**
+     * Sets the memory limit of the process. While the memory footprint
+     * of the process is above 80% of the limit, the caches are purged
+     * periodically as by {@link #PURGE_CACHES}; once it reaches the limit,
+     * as by {@link #PURGE_ALL}, and the page cache stops accepting pages.
+     * The footprint includes the Java heap, which these purges cannot
+     * shrink, so purges that do not bring the footprint down are repeated
+     * less and less often, down to once every five minutes.
+     * @param limit specifies the new memory limit, in bytes, or zero to
+     *        remove the limit.
+     * @throws IllegalArgumentException if {@code limit} is negative.
+     */
+    public static void setMemoryLimit(long limit) {
+        if (limit < 0) {
+            throw new IllegalArgumentException(
+                    "limit is negative:" + limit);
+        }
+        twkSetMemoryLimit(limit);
+    }
+
+    /**
+     * Sets the capacities of the memory cache, which holds the resources
+     * loaded by the pages along with their decoded data.
+     * @param minDeadBytes specifies the amount of memory kept for resources
+     *        not used by any page when the cache is full, in bytes.
+     * @param maxDeadBytes specifies the maximum amount of memory used by
+     *        resources not used by any page, in bytes.
+     * @param totalBytes specifies the capacity of the cache, in bytes.
+     * @throws IllegalArgumentException if any capacity is negative or if
+     *         {@code minDeadBytes > maxDeadBytes} or
+     *         {@code maxDeadBytes > totalBytes}.
+     */
+    public static void setCacheCapacities(int minDeadBytes, int maxDeadBytes,
+                                          int totalBytes) {
+        if (minDeadBytes < 0 || minDeadBytes > maxDeadBytes
+                || maxDeadBytes > totalBytes) {
+            throw new IllegalArgumentException(
+                    "invalid capacities:" + minDeadBytes + ", "
+                    + maxDeadBytes + ", " + totalBytes);
+        }
+        twkSetCacheCapacities(minDeadBytes, maxDeadBytes, totalBytes);
+    }
+
+    /**
+     * Releases memory held by WebKit.
+     * @param level specifies what to release, one of {@link #PURGE_CACHES},
+     *        {@link #PURGE_DECODED_DATA} or {@link #PURGE_ALL}.
+     * @throws IllegalArgumentException if {@code level} is not valid.
+     */
+    public static void releaseMemory(int level) {
+        if (level < PURGE_CACHES || level > PURGE_ALL) {
+            throw new IllegalArgumentException(
+                    "invalid level:" + level);
+        }
+        twkReleaseMemory(level);
+    }
+
+    native private static long twkGetMemoryFootprint();
+    native private static long twkGetMemoryLimit();
+    native private static void twkSetMemoryLimit(long limit);
+    native private static void twkSetCacheCapacities(int minDeadBytes,
+                                                     int maxDeadBytes,
+                                                     int totalBytes);
+    native private static void twkReleaseMemory(int level);
+}
@@ -95,6 +95,9 @@ public final class WebPage {
 
     private int fontSmoothingType;
 
+    // Whether this page keeps its IndexedDB databases on disk
+    private boolean pagePersistentIndexedDB = persistentIndexedDB;
+
     private final WCFrameView hostWindow;
 
     // List of created frames
@@ -155,8 +158,30 @@ public final class WebPage {
                     "com.sun.webkit.useCSS3D", "false"));
             useCSS3D = useCSS3D && Platform.isSupported(ConditionalFeature.SCENE3D);
 
+            // Edge length of the surfaces used to composite layers with
+            // filters, masks or blending
+            final int compositingTileSize = Integer.getInteger(
+                    "com.sun.webkit.compositingTileSize", 512);
+
+            // Megabytes of memory the JavaScript heap sizes itself
+            // against; zero uses the physical memory of the machine
+            final int jsHeapSize = Integer.getInteger(
+                    "com.sun.webkit.jsHeapSize", 0);
+
+            // DNS prefetching sends host names found in pages to the
+            // resolver before the user follows a link, so it is opt-in
+            final boolean dnsPrefetch = Boolean.valueOf(System.getProperty(
+                    "com.sun.webkit.dnsPrefetch", "false"));
+
+            persistentIndexedDB = Boolean.valueOf(System.getProperty(
+                    "com.sun.webkit.persistentIndexedDB", "false"));
+            // Megabytes per origin; zero or less disables the quota
+            indexedDBQuota = Math.max(0L, Long.getLong(
+                    "com.sun.webkit.indexedDBQuota", 1024L)) * 1024 * 1024;
+
             // Initialize WTF, WebCore and JavaScriptCore.
-            twkInitWebCore(useJIT, useDFGJIT, useCSS3D);
+            twkInitWebCore(useJIT, useDFGJIT, useCSS3D, compositingTileSize,
+                           jsHeapSize, dnsPrefetch);
 
             // Inform the native webkit code when either the JVM or the
             // JavaFX runtime is being shutdown
@@ -175,6 +200,12 @@ public final class WebPage {
 
     }
 
+    // Persistent IndexedDB is opt-in: without it, databases are kept in
+    // memory and discarded when the application exits.
+    private static boolean persistentIndexedDB;
+    // The per-origin IndexedDB quota in bytes, or 0 if unlimited.
+    private static long indexedDBQuota;
+
     private static boolean firstWebPageCreated = false;
 
     private static void collectJSCGarbages() {
@@ -263,6 +294,13 @@ public final class WebPage {
     private WCPageBackBuffer backbuffer;
     private List<WCRectangle> dirtyRects = new LinkedList<WCRectangle>();
 
+    // Package scope for testing: the fwkRepaint calls and the rects they
+    // passed, and the number of fwkRepaint calls before the last fwkScroll
+    int repaintCount;
+    int repaintRectCount;
+    int[] lastRepaintRects;
+    int repaintCountAtScroll = -1;
+
     private void addDirtyRect(WCRectangle toPaint) {
         if (toPaint.getWidth() <= 0 || toPaint.getHeight() <= 0) {
             return;
@@ -1792,6 +1830,29 @@ public final class WebPage {
         }
     }
 
+    /**
+     * Tells the page whether it is shown on the screen. Hidden pages
+     * throttle their timers and suspend their animations.
+     */
+    public void setVisible(boolean visible) {
+        lockPage();
+        try {
+            log.fine("setVisible: " + visible);
+            if (isDisposed) {
+                log.fine("setVisible() request for a disposed web page.");
+                return;
+            }
+
+            twkSetVisible(getPage(), visible);
+            if (visible) {
+                // Render frames were dropped while the page was hidden
+                repaintAll();
+            }
+        } finally {
+            unlockPage();
+        }
+    }
+
     /**
      * @return HTML content of the frame,
      *         or null if frame document is absent or non-HTML.
@@ -2074,6 +2135,27 @@ public final class WebPage {
         }
     }
 
+    public boolean isPersistentIndexedDBEnabled() {
+        return pagePersistentIndexedDB;
+    }
+
+    /**
+     * Sets the directory that the IndexedDB databases of this page are
+     * stored in. Pages with the same directory share an IndexedDB server,
+     * pages with different directories never see each other's databases.
+     * Ignored unless persistent IndexedDB is enabled.
+     */
+    public void setIndexedDatabasePath(String path) {
+        lockPage();
+        try {
+            if (pagePersistentIndexedDB) {
+                twkSetIndexedDatabasePath(getPage(), path, indexedDBQuota);
+            }
+        } finally {
+            unlockPage();
+        }
+    }
+
     // ---- INSPECTOR SUPPORT ---- //
 
     public void connectInspectorFrontend() {
@@ -2131,20 +2213,30 @@ public final class WebPage {
         frames.remove(frameID);
     }
 
-    private void fwkRepaint(int x, int y, int w, int h) {
+    // The native page batches its repaint requests: rects holds
+    // x, y, width and height of each rect to repaint
+    private void fwkRepaint(int[] rects) {
         lockPage();
         try {
-            if (paintLog.isLoggable(Level.FINEST)) {
-                paintLog.finest("x: {0}, y: {1}, w: {2}, h: {3}",
-                        new Object[] {x, y, w, h});
+            repaintCount++;
+            repaintRectCount += rects.length / 4;
+            lastRepaintRects = rects;
+            for (int i = 0; i + 3 < rects.length; i += 4) {
+                int x = rects[i], y = rects[i + 1];
+                int w = rects[i + 2], h = rects[i + 3];
+                if (paintLog.isLoggable(Level.FINEST)) {
+                    paintLog.finest("x: {0}, y: {1}, w: {2}, h: {3}",
+                            new Object[] {x, y, w, h});
+                }
+                addDirtyRect(new WCRectangle(x, y, w, h));
             }
-            addDirtyRect(new WCRectangle(x, y, w, h));
         } finally {
             unlockPage();
         }
     }
 
     private void fwkScroll(int x, int y, int w, int h, int deltaX, int deltaY) {
+        repaintCountAtScroll = repaintCount;
         if (paintLog.isLoggable(Level.FINEST)) {
             paintLog.finest("Scroll: " + x + " " + y + " " + w + " " + h + "  " + deltaX + " " + deltaY);
         }
@@ -2562,11 +2654,30 @@ public final class WebPage {
         return frames.size();
     }
 
+    // Package scope method for testing: applies to documents loaded
+    // from now on
+    void test_setDNSPrefetchEnabled(boolean enabled) {
+        lockPage();
+        try {
+            twkSetDNSPrefetchEnabled(getPage(), enabled);
+        } finally {
+            unlockPage();
+        }
+    }
+
+    // Package scope method for testing: must be called before the
+    // IndexedDB path is set
+    void test_setPersistentIndexedDBEnabled(boolean enabled) {
+        pagePersistentIndexedDB = enabled;
+    }
+
     // *************************************************************************
     // Native methods
     // *************************************************************************
 
-    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useCSS3D);
+    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useCSS3D,
+                                              int compositingTileSize, int jsHeapSize,
+                                              boolean dnsPrefetch);
     private native long twkCreatePage(boolean editable);
     private native void twkInit(long pPage, boolean usePlugins, float devicePixelScale);
     private native void twkDestroyPage(long pPage);
@@ -2672,6 +2783,7 @@ public final class WebPage {
     private native String twkQueryCommandValue(long page, String command);
     private native boolean twkIsEditable(long page);
     private native void twkSetEditable(long page, boolean editable);
+    private native void twkSetVisible(long page, boolean visible);
     private native String twkGetHtml(long pFrame);
 
     private native boolean twkGetUsePageCache(long page);
@@ -2688,6 +2800,8 @@ public final class WebPage {
     private native void twkSetUserAgent(long page, String userAgent);
     private native void twkSetLocalStorageDatabasePath(long page, String path);
     private native void twkSetLocalStorageEnabled(long page, boolean enabled);
+    private native void twkSetDNSPrefetchEnabled(long page, boolean enabled);
+    private native void twkSetIndexedDatabasePath(long page, String path, long perOriginQuota);
 
     private native int twkGetUnloadEventListenersCount(long pFrame);
 
@@ -86,6 +86,7 @@ public final class GraphicsDecoder  {
     @Native public final static int SET_MITER_LIMIT        = 54;
     @Native public final static int SET_TEXT_MODE          = 55;
     @Native public final static int SET_PERSPECTIVE_TRANSFORM = 56;
+    @Native public final static int DRAWIMAGE_MASKED       = 57;
 
     private final static PlatformLogger log =
             PlatformLogger.getLogger(GraphicsDecoder.class.getName());
@@ -201,6 +202,11 @@ public final class GraphicsDecoder  {
                         buf.getFloat(),
                         buf.getFloat());
                     break;
+                case DRAWIMAGE_MASKED:
+                    gc.drawImageMasked(
+                        WCImage.getImage(gm.getRef(buf.getInt())),
+                        WCImage.getImage(gm.getRef(buf.getInt())));
+                    break;
                 case DRAWICON:
                     gc.drawIcon((WCIcon)gm.getRef(buf.getInt()),
                         buf.getInt(),
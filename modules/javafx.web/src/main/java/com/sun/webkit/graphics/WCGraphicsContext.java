@@ -77,6 +77,8 @@ public abstract class WCGraphicsContext {
                           float dstx, float dsty, float dstw, float dsth,
                           float srcx, float srcy, float srcw, float srch);
 
+    public abstract void drawImageMasked(WCImage img, WCImage mask);
+
     public abstract void drawIcon(WCIcon icon, int x, int y);
 
     public abstract void drawPattern(WCImage texture, WCRectangle srcRect,
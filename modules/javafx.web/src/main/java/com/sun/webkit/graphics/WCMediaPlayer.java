@@ -224,6 +224,21 @@ public abstract class WCMediaPlayer extends Ref {
         });
     }
 
+    /**
+     * A frame notification is in flight and the page has not painted the
+     * player since. Frames arriving meanwhile are not announced, the page
+     * picks up the latest one when it paints, so frames are dropped at
+     * the page's rendering cadence rather than queued on the event thread.
+     */
+    private volatile boolean newFramePending;
+    private volatile long newFrameNotifyTime;
+
+    /**
+     * Re-announce a pending frame after this long in case the page did
+     * not paint the player, e.g. because it was scrolled out of view.
+     */
+    private static final long NEW_FRAME_RENOTIFY_DELAY = 100_000_000L; // ns
+
     private Runnable newFrameNotifier = () -> {
         if (nPtr != 0) {
             notifyNewFrame(nPtr);
@@ -231,6 +246,12 @@ public abstract class WCMediaPlayer extends Ref {
     };
 
     protected void notifyNewFrame() {
+        long now = System.nanoTime();
+        if (newFramePending && now - newFrameNotifyTime < NEW_FRAME_RENOTIFY_DELAY) {
+            return;
+        }
+        newFramePending = true;
+        newFrameNotifyTime = now;
         Invoker.getInvoker().invokeOnEventThread(newFrameNotifier);
     }
 
@@ -336,6 +357,7 @@ public abstract class WCMediaPlayer extends Ref {
     /* called from GraphicsDecoder */
     void render(WCGraphicsContext gc, int x, int y, int w, int h) {
         log.finer("render(x={0}, y={1}, w={2}, h={3}", new Object[]{x, y, w, h});
+        newFramePending = false;
         renderCurrentFrame(gc, x, y, w, h);
     }
 
@@ -74,6 +74,17 @@ final class ByteBufferPool {
         return new ByteBufferAllocatorImpl(maxBufferCount);
     }
 
+    /**
+     * Creates a new allocator of native segments of the pool's buffer
+     * size. Segments are not recycled through the pool: once a segment
+     * is handed over, its memory is owned by WebCore.
+     * As with {@link #newAllocator}, no more than {@code maxBufferCount}
+     * segments are outstanding through the allocator at any given time.
+     */
+    ByteBufferAllocator newSegmentAllocator(int maxBufferCount) {
+        return new SegmentAllocatorImpl(maxBufferCount);
+    }
+
     /**
      * The allocator implementation.
      */
@@ -116,6 +127,66 @@ final class ByteBufferPool {
             byteBuffers.add(byteBuffer);
             semaphore.release();
         }
+
+        /**
+         * {@inheritDoc}
+         */
+        @Override
+        public void handOver(ByteBuffer byteBuffer) {
+            release(byteBuffer);
+        }
+    }
+
+    /**
+     * The native segment allocator implementation.
+     */
+    private final class SegmentAllocatorImpl implements ByteBufferAllocator {
+
+        /**
+         * The semaphore used to limit the number of segments
+         * outstanding through this allocator.
+         */
+        private final Semaphore semaphore;
+
+
+        /**
+         * Creates a new allocator.
+         */
+        private SegmentAllocatorImpl(int maxBufferCount) {
+            semaphore = new Semaphore(maxBufferCount);
+        }
+
+
+        /**
+         * {@inheritDoc}
+         */
+        @Override
+        public ByteBuffer allocate() throws InterruptedException {
+            semaphore.acquire();
+            try {
+                return URLLoaderBase.twkAllocateSegment(bufferSize);
+            } catch (Throwable t) {
+                semaphore.release();
+                throw t;
+            }
+        }
+
+        /**
+         * {@inheritDoc}
+         */
+        @Override
+        public void release(ByteBuffer byteBuffer) {
+            URLLoaderBase.twkReleaseSegment(byteBuffer);
+            semaphore.release();
+        }
+
+        /**
+         * {@inheritDoc}
+         */
+        @Override
+        public void handOver(ByteBuffer byteBuffer) {
+            semaphore.release();
+        }
     }
 }
 
@@ -133,4 +204,11 @@ interface ByteBufferAllocator {
      * Releases a byte buffer.
      */
     void release(ByteBuffer byteBuffer);
+
+    /**
+     * Notifies the allocator that the contents of a byte buffer have been
+     * passed to WebCore. Allocators of native segments give up the buffer,
+     * since its memory now belongs to WebCore; other allocators release it.
+     */
+    void handOver(ByteBuffer byteBuffer);
 }
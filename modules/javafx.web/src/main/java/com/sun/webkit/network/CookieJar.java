@@ -38,13 +38,47 @@ import java.util.Map;
 
 final class CookieJar {
 
+    /**
+     * The cookie handler whose results the native cookie cache may hold.
+     * Only our own {@link CookieManager} reports its changes, results of
+     * any other handler are never cached.
+     */
+    private static volatile CookieManager cachedManager;
+
     private CookieJar() {
     }
 
-    private static void fwkPut(String url, String cookie) {
+    /**
+     * Returns the default cookie handler, invalidating the native cookie
+     * cache if it is not the one the cache was filled from.
+     */
+    static CookieHandler checkHandler() {
         @SuppressWarnings("removal")
         CookieHandler handler =
             AccessController.doPrivileged((PrivilegedAction<CookieHandler>) CookieHandler::getDefault);
+        if (handler instanceof CookieManager) {
+            if (handler != cachedManager) {
+                cachedManager = (CookieManager) handler;
+                cachedManager.reportState();
+            }
+        } else {
+            cachedManager = null;
+            twkCookiesChanged(Long.MIN_VALUE);
+        }
+        return handler;
+    }
+
+    /**
+     * Called by {@link CookieManager} whenever its store changes.
+     */
+    static void cookiesChanged(CookieManager manager, long earliestExpiryTime) {
+        if (manager == cachedManager) {
+            twkCookiesChanged(earliestExpiryTime);
+        }
+    }
+
+    private static void fwkPut(String url, String cookie) {
+        CookieHandler handler = checkHandler();
         if (handler != null) {
             URI uri = null;
             try {
@@ -66,9 +100,7 @@ final class CookieJar {
     }
 
     private static String fwkGet(String url, boolean includeHttpOnlyCookies) {
-        @SuppressWarnings("removal")
-        CookieHandler handler =
-            AccessController.doPrivileged((PrivilegedAction<CookieHandler>) CookieHandler::getDefault);
+        CookieHandler handler = checkHandler();
         if (handler != null) {
             URI uri = null;
             try {
@@ -120,4 +152,10 @@ final class CookieJar {
                 uri.getRawSchemeSpecificPart(),
                 uri.getRawFragment());
     }
+
+    /**
+     * Drops the native cookie cache. Cached results stay valid until
+     * the given time unless this is called again.
+     */
+    private static native void twkCookiesChanged(long earliestExpiryTime);
 }
@@ -111,6 +111,7 @@ public final class CookieManager extends CookieHandler {
         synchronized (store) {
             cookieList = store.get(host, uri.getPath(),
                     secureProtocol, httpApi);
+            reportChanges();
         }
 
         StringBuilder sb = new StringBuilder();
@@ -230,11 +231,32 @@ public final class CookieManager extends CookieHandler {
             }
 
             store.put(cookie);
+            reportChanges();
         }
 
         logger.finest("Stored: {0}", cookie);
     }
 
+    /**
+     * Tells the native cookie cache about changes to the store. Called
+     * with the store lock held so that notifications are not reordered.
+     */
+    private void reportChanges() {
+        if (store.takeModified()) {
+            CookieJar.cookiesChanged(this, store.earliestExpiryTime());
+        }
+    }
+
+    /**
+     * Reports the current state of the store to the native cookie cache.
+     */
+    void reportState() {
+        synchronized (store) {
+            store.takeModified();
+            CookieJar.cookiesChanged(this, store.earliestExpiryTime());
+        }
+    }
+
     /**
      * Converts a map of HTTP headers to a string suitable for displaying
      * in the log.
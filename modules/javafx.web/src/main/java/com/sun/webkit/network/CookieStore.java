@@ -67,6 +67,18 @@ final class CookieStore {
      */
     private int totalCount = 0;
 
+    /**
+     * A lower bound of the expiry times of the cookies currently
+     * in the store.
+     */
+    private long earliestExpiryTime = Long.MAX_VALUE;
+
+    /**
+     * Whether the store has changed since the last call to
+     * {@link #takeModified()}.
+     */
+    private boolean modified = false;
+
 
     /**
      * Creates a new {@code CookieStore}.
@@ -91,6 +103,7 @@ final class CookieStore {
         if (storedCookie.hasExpired()) {
             bucket.remove(storedCookie);
             totalCount--;
+            modified = true;
             log("Expired cookie removed by get", storedCookie, bucket);
             return null;
         }
@@ -151,6 +164,7 @@ final class CookieStore {
             if (cookie.hasExpired()) {
                 it.remove();
                 totalCount--;
+                modified = true;
                 log("Expired cookie removed by find", cookie, bucket);
                 continue;
             }
@@ -196,6 +210,7 @@ final class CookieStore {
      * Stores the given cookie.
      */
     void put(Cookie cookie) {
+        modified = true;
         Map<Cookie,Cookie> bucket = buckets.get(cookie.getDomain());
         if (bucket == null) {
             bucket = new LinkedHashMap<Cookie,Cookie>(20);
@@ -208,6 +223,8 @@ final class CookieStore {
                 log("Expired cookie removed by put", cookie, bucket);
             }
         } else {
+            earliestExpiryTime =
+                    Math.min(earliestExpiryTime, cookie.getExpiryTime());
             if (bucket.put(cookie, cookie) == null) {
                 totalCount++;
                 log("Cookie added", cookie, bucket);
@@ -223,6 +240,50 @@ final class CookieStore {
         }
     }
 
+    /**
+     * Returns a lower bound of the expiry times of the stored cookies.
+     * No cookie returned by a query changes before that time unless the
+     * store is modified.
+     */
+    long earliestExpiryTime() {
+        return earliestExpiryTime;
+    }
+
+    /**
+     * Returns whether the store has changed since the last call, dropping
+     * the cookies that have expired in the meantime first.
+     */
+    boolean takeModified() {
+        if (System.currentTimeMillis() > earliestExpiryTime) {
+            removeExpired();
+        }
+        boolean result = modified;
+        modified = false;
+        return result;
+    }
+
+    /**
+     * Removes expired cookies globally and updates the earliest expiry time.
+     */
+    private void removeExpired() {
+        long earliest = Long.MAX_VALUE;
+        for (Map<Cookie,Cookie> bucket : buckets.values()) {
+            Iterator<Cookie> it = bucket.values().iterator();
+            while (it.hasNext()) {
+                Cookie cookie = it.next();
+                if (cookie.hasExpired()) {
+                    it.remove();
+                    totalCount--;
+                    log("Expired cookie removed", cookie, bucket);
+                } else {
+                    earliest = Math.min(earliest, cookie.getExpiryTime());
+                }
+            }
+        }
+        earliestExpiryTime = earliest;
+        modified = true;
+    }
+
     /**
      * Removes excess cookies from a given bucket.
      */
@@ -110,17 +110,6 @@ final class HTTP2Loader extends URLLoaderBase {
                 .connectTimeout(Duration.ofSeconds(30)) // FIXME: Add a property to control the timeout
                 .cookieHandler(CookieHandler.getDefault())
                 .build());
-    // Singleton instance of direct ByteBuffer to transfer downloaded bytes from
-    // Java to native
-    private static final int DEFAULT_BUFSIZE = 40 * 1024;
-    private final static ByteBuffer BUFFER;
-    static {
-       @SuppressWarnings("removal")
-       int bufSize  = AccessController.doPrivileged(
-                        (PrivilegedAction<Integer>) () ->
-                            Integer.valueOf(System.getProperty("jdk.httpclient.bufsize", Integer.toString(DEFAULT_BUFSIZE))));
-       BUFFER = ByteBuffer.allocateDirect(bufSize);
-    }
 
     /**
      * Creates a new {@code HTTP2Loader}.
@@ -522,30 +511,23 @@ final class HTTP2Loader extends URLLoaderBase {
         });
     }
 
-    private ByteBuffer getDirectBuffer(int size) {
-        ByteBuffer dbb = BUFFER;
-        // Though the chance of reaching here is rare, handle the
-        // case by allocating a tmp direct buffer.
-        if (size > dbb.capacity()) {
-            dbb = ByteBuffer.allocateDirect(size);
-        }
-        return dbb.clear();
-    }
-
-    private ByteBuffer copyToDirectBuffer(final ByteBuffer bb) {
-        return getDirectBuffer(bb.limit()).put(bb).flip();
+    // Each chunk is copied once into a native segment, which WebCore
+    // then adopts as is.
+    private ByteBuffer copyToSegment(final ByteBuffer bb) {
+        return twkAllocateSegment(bb.remaining()).put(bb).flip();
     }
 
     // another variant to use from createZIPEncodedBodySubscriber
     private void didReceiveData(final byte[] bytes, int size) {
         callBackIfNotCanceled(() -> {
-            notifyDidReceiveData(getDirectBuffer(size).put(bytes, 0, size).flip());
+            notifyDidReceiveData(twkAllocateSegment(size).put(bytes, 0, size).flip());
         });
     }
 
     private void didReceiveData(final List<ByteBuffer> bytes) {
         callBackIfNotCanceled(() -> bytes.stream()
-                                          .map(this::copyToDirectBuffer)
+                                          .filter(ByteBuffer::hasRemaining)
+                                          .map(this::copyToSegment)
                                           .forEach(this::notifyDidReceiveData)
         );
     }
@@ -563,7 +545,7 @@ final class HTTP2Loader extends URLLoaderBase {
                     byteBuffer.remaining(),
                     data));
         }
-        twkDidReceiveData(byteBuffer, byteBuffer.position(), byteBuffer.remaining(), data);
+        twkDidReceiveSegment(byteBuffer, byteBuffer.position(), byteBuffer.remaining(), data);
     }
 
     private void didFinishLoading() {
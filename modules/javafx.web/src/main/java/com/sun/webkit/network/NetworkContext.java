@@ -27,11 +27,22 @@ package com.sun.webkit.network;
 
 import static com.sun.webkit.network.URLs.newURL;
 
+import java.net.InetAddress;
 import java.net.MalformedURLException;
+import java.net.Proxy;
+import java.net.ProxySelector;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.net.UnknownHostException;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
+import java.security.PrivilegedActionException;
+import java.security.PrivilegedExceptionAction;
 import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.ArrayBlockingQueue;
 import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.RejectedExecutionException;
 import java.util.concurrent.ThreadFactory;
 import java.util.concurrent.ThreadPoolExecutor;
 import java.util.concurrent.TimeUnit;
@@ -39,6 +50,7 @@ import java.util.concurrent.atomic.AtomicInteger;
 
 import com.sun.javafx.logging.PlatformLogger;
 import com.sun.javafx.logging.PlatformLogger.Level;
+import com.sun.webkit.Invoker;
 import com.sun.webkit.WebPage;
 import java.security.Permission;
 
@@ -78,6 +90,34 @@ final class NetworkContext {
      */
     private static final ThreadPoolExecutor threadPool;
 
+    /**
+     * The number of threads that resolve host names for DNS prefetch
+     * and preconnect.
+     */
+    private static final int RESOLVER_POOL_SIZE = 2;
+
+    /**
+     * The number of lookups that may wait for a thread.
+     */
+    private static final int RESOLVER_QUEUE_SIZE = 32;
+
+    /**
+     * The thread pool used for DNS prefetch and preconnect, kept apart from
+     * the loaders so that slow lookups never delay a real load. Lookups are
+     * only hints, so those that do not fit in the queue fail right away.
+     */
+    private static final ThreadPoolExecutor resolverPool;
+
+    /**
+     * Resolves a host name to its addresses, throws UnknownHostException
+     * if it cannot. Replaced by tests only.
+     */
+    interface Resolver {
+        InetAddress[] resolve(String host) throws UnknownHostException;
+    }
+
+    static volatile Resolver resolver = InetAddress::getAllByName;
+
     /**
      * Can use HTTP2Loader
      */
@@ -89,9 +129,18 @@ final class NetworkContext {
                 THREAD_POOL_KEEP_ALIVE_TIME,
                 TimeUnit.MILLISECONDS,
                 new LinkedBlockingQueue<Runnable>(),
-                new URLLoaderThreadFactory());
+                new URLLoaderThreadFactory("URL-Loader-"));
         threadPool.allowCoreThreadTimeOut(true);
 
+        resolverPool = new ThreadPoolExecutor(
+                RESOLVER_POOL_SIZE,
+                RESOLVER_POOL_SIZE,
+                THREAD_POOL_KEEP_ALIVE_TIME,
+                TimeUnit.MILLISECONDS,
+                new ArrayBlockingQueue<Runnable>(RESOLVER_QUEUE_SIZE),
+                new URLLoaderThreadFactory("URL-Resolver-"));
+        resolverPool.allowCoreThreadTimeOut(true);
+
         @SuppressWarnings("removal")
         boolean tmp = AccessController.doPrivileged((PrivilegedAction<Boolean>) () -> {
             // Use HTTP2 by default on JDK 12 or later
@@ -164,6 +213,10 @@ final class NetworkContext {
                     Util.formatHeaders(headers)));
         }
 
+        // Keep the native cookie cache in sync if the application has
+        // replaced the default cookie handler
+        CookieJar.checkHandler();
+
         if (useHTTP2Loader) {
             final URLLoaderBase loader = HTTP2Loader.create(
                 webPage,
@@ -229,10 +282,87 @@ final class NetworkContext {
     }
 
     /**
-     * Thread factory for URL loader threads.
+     * Checks whether HTTP requests to the given host are routed through a
+     * proxy. Resolving the host ourselves is pointless in that case since
+     * the proxy resolves host names.
+     */
+    private static boolean fwkIsUsingProxy(String host) {
+        @SuppressWarnings("removal")
+        ProxySelector proxySelector = AccessController.doPrivileged(
+                (PrivilegedAction<ProxySelector>) () -> ProxySelector.getDefault());
+        if (proxySelector == null) {
+            return false;
+        }
+        try {
+            for (String scheme : new String[] {"http", "https"}) {
+                List<Proxy> proxies = proxySelector.select(
+                        new URI(scheme, host, "/", null));
+                for (Proxy proxy : proxies) {
+                    if (proxy.type() != Proxy.Type.DIRECT) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        } catch (URISyntaxException | RuntimeException ex) {
+            // Be conservative if the selector cannot tell
+            return true;
+        }
+    }
+
+    /**
+     * Resolves the given host for DNS prefetch or preconnect. The lookup
+     * goes through InetAddress, so the answer is cached by the JDK for the
+     * loads that follow. The addresses, or null if the host cannot be
+     * resolved, are passed to the native callback on the event thread.
+     */
+    private static void fwkResolve(String host, long data) {
+        if (logger.isLoggable(Level.FINEST)) {
+            logger.finest(String.format("host: [%s]", host));
+        }
+        try {
+            resolverPool.execute(() -> {
+                byte[][] addresses = resolve(host);
+                Invoker.getInvoker().postOnEventThread(() -> {
+                    twkDidResolve(addresses, data);
+                });
+            });
+        } catch (RejectedExecutionException ex) {
+            logger.finest("Too many lookups, dropping [" + host + "]");
+            Invoker.getInvoker().postOnEventThread(() -> {
+                twkDidResolve(null, data);
+            });
+        }
+    }
+
+    private static byte[][] resolve(String host) {
+        try {
+            @SuppressWarnings("removal")
+            InetAddress[] addresses = AccessController.doPrivileged(
+                    (PrivilegedExceptionAction<InetAddress[]>) () -> resolver.resolve(host));
+            byte[][] result = new byte[addresses.length][];
+            for (int i = 0; i < addresses.length; i++) {
+                result[i] = addresses[i].getAddress();
+            }
+            return result;
+        } catch (PrivilegedActionException ex) {
+            if (logger.isLoggable(Level.FINEST)) {
+                logger.finest(String.format("Cannot resolve [%s]", host));
+            }
+        } catch (SecurityException ex) {
+            logger.finest("Lookup not permitted", ex);
+        }
+        return null;
+    }
+
+    private static native void twkDidResolve(byte[][] addresses, long data);
+
+    /**
+     * Thread factory for URL loader and resolver threads.
      */
     private static final class URLLoaderThreadFactory implements ThreadFactory {
         private final ThreadGroup group;
+        private final String namePrefix;
         private final AtomicInteger index = new AtomicInteger(1);
 
         // Need to assert the modifyThread and modifyThreadGroup permission when
@@ -242,7 +372,8 @@ final class NetworkContext {
         private static final Permission modifyThreadGroupPerm = new RuntimePermission("modifyThreadGroup");
         private static final Permission modifyThreadPerm = new RuntimePermission("modifyThread");
 
-        private URLLoaderThreadFactory() {
+        private URLLoaderThreadFactory(String namePrefix) {
+            this.namePrefix = namePrefix;
             @SuppressWarnings("removal")
             SecurityManager sm = System.getSecurityManager();
             group = (sm != null) ? sm.getThreadGroup()
@@ -256,7 +387,7 @@ final class NetworkContext {
             return
                 AccessController.doPrivileged((PrivilegedAction<Thread>) () -> {
                     Thread t = new Thread(group, r,
-                            "URL-Loader-" + index.getAndIncrement());
+                            namePrefix + index.getAndIncrement());
                     t.setDaemon(true);
                     if (t.getPriority() != Thread.NORM_PRIORITY) {
                         t.setPriority(Thread.NORM_PRIORITY);
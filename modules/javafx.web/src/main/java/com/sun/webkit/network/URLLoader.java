@@ -510,7 +510,7 @@ final class URLLoader extends URLLoaderBase implements Runnable {
         }
 
         ByteBufferAllocator allocator =
-                byteBufferPool.newAllocator(MAX_BUF_COUNT);
+                byteBufferPool.newSegmentAllocator(MAX_BUF_COUNT);
         ByteBuffer byteBuffer = null;
         try {
             if (inputStream != null) {
@@ -738,8 +738,10 @@ final class URLLoader extends URLLoaderBase implements Runnable {
                         byteBuffer,
                         byteBuffer.position(),
                         byteBuffer.remaining());
+                allocator.handOver(byteBuffer);
+            } else {
+                allocator.release(byteBuffer);
             }
-            allocator.release(byteBuffer);
         });
     }
 
@@ -758,7 +760,7 @@ final class URLLoader extends URLLoaderBase implements Runnable {
                     remaining,
                     data));
         }
-        twkDidReceiveData(byteBuffer, position, remaining, data);
+        twkDidReceiveSegment(byteBuffer, position, remaining, data);
     }
 
     private void didFinishLoading() {
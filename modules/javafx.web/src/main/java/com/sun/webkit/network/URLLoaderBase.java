@@ -56,10 +56,30 @@ abstract class URLLoaderBase {
                                                      String url,
                                                      long data);
 
-    protected static native void twkDidReceiveData(ByteBuffer byteBuffer,
-                                                 int position,
-                                                 int remaining,
-                                                 long data);
+    /**
+     * Allocates a direct byte buffer backed by native memory that
+     * {@link #twkDidReceiveSegment} can hand over to WebCore without
+     * copying. The buffer must be passed either to
+     * {@code twkDidReceiveSegment} or to {@link #twkReleaseSegment}.
+     */
+    protected static native ByteBuffer twkAllocateSegment(int capacity);
+
+    /**
+     * Frees a buffer allocated by {@link #twkAllocateSegment} that has
+     * not been handed over.
+     */
+    protected static native void twkReleaseSegment(ByteBuffer byteBuffer);
+
+    /**
+     * Passes the bytes in {@code [position, position + remaining)} of a
+     * buffer allocated by {@link #twkAllocateSegment} to WebCore. The
+     * native memory is adopted by WebCore, so the buffer must not be
+     * used after this call.
+     */
+    protected static native void twkDidReceiveSegment(ByteBuffer byteBuffer,
+                                                    int position,
+                                                    int remaining,
+                                                    long data);
 
     protected static native void twkDidFinishLoading(long data);
 
@@ -238,6 +238,13 @@ public final class WCGraphicsPerfLogger extends WCGraphicsContext {
         logger.suspendCount("DRAWIMAGE");
     }
 
+    @Override
+    public void drawImageMasked(WCImage img, WCImage mask) {
+        logger.resumeCount("DRAWIMAGEMASKED");
+        gc.drawImageMasked(img, mask);
+        logger.suspendCount("DRAWIMAGEMASKED");
+    }
+
     @Override
     public void drawIcon(WCIcon icon, int x, int y) {
         logger.resumeCount("DRAWICON");
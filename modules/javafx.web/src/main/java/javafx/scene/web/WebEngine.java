@@ -1025,10 +1025,10 @@ final public class WebEngine {
             try {
                 userDataDir = DirectoryLock.canonicalize(userDataDir);
                 File localStorageDir = new File(userDataDir, "localstorage");
-                File[] dirs = new File[] {
-                    userDataDir,
-                    localStorageDir,
-                };
+                File indexedDBDir = new File(userDataDir, "indexeddb");
+                File[] dirs = page.isPersistentIndexedDBEnabled()
+                    ? new File[] { userDataDir, localStorageDir, indexedDBDir }
+                    : new File[] { userDataDir, localStorageDir };
                 for (File dir : dirs) {
                     createDirectories(dir);
                     // Additional security check to make sure the caller
@@ -1042,6 +1042,7 @@ final public class WebEngine {
 
                 page.setLocalStorageDatabasePath(localStorageDir.getPath());
                 page.setLocalStorageEnabled(true);
+                page.setIndexedDatabasePath(indexedDBDir.getPath());
 
                 logger.fine("User data directory [{0}] has "
                         + "been applied successfully", displayString);
@@ -40,10 +40,12 @@ import javafx.css.StyleableObjectProperty;
 import javafx.css.StyleableProperty;
 import javafx.event.EventHandler;
 import javafx.event.EventType;
+import javafx.geometry.Bounds;
 import javafx.geometry.NodeOrientation;
 import javafx.geometry.Point2D;
 import javafx.scene.Node;
 import javafx.scene.Parent;
+import javafx.scene.Scene;
 import javafx.scene.input.DataFormat;
 import javafx.scene.input.DragEvent;
 import javafx.scene.input.Dragboard;
@@ -136,6 +138,17 @@ final public class WebView extends Parent {
      */
     private final TKPulseListener stagePulseListener;
 
+    /**
+     * Whether the page was last told it is shown on the screen.
+     */
+    private boolean pageVisible = true;
+
+    /**
+     * Whether the view has been shown on the screen. Views that never were,
+     * such as offscreen views used for snapshots, are never hidden.
+     */
+    private boolean shown = false;
+
     /**
      * Returns the {@code WebEngine} object.
      * @return the WebEngine
@@ -947,6 +960,18 @@ final public class WebView extends Parent {
                && !iconified;
     }
 
+    // Whether the page is shown on the screen, that is, the tree is
+    // visible and the view is not entirely outside the scene
+    private boolean isPageVisible(boolean reallyVisible) {
+        if (!reallyVisible) {
+            return false;
+        }
+
+        final Scene scene = getScene();
+        final Bounds bounds = localToScene(getLayoutBounds());
+        return bounds.intersects(0, 0, scene.getWidth(), scene.getHeight());
+    }
+
     private void handleStagePulse() {
         // The stage pulse occurs before the scene pulse.
         // Here the page content is updated before CSS/Layout/Sync pass
@@ -966,6 +991,17 @@ final public class WebView extends Parent {
 
         boolean reallyVisible = isTreeReallyVisible();
 
+        // Pages that were shown and are now hidden or off-screen throttle
+        // their timers and suspend their animations
+        if (reallyVisible) {
+            shown = true;
+        }
+        boolean visible = !shown || isPageVisible(reallyVisible);
+        if (visible != pageVisible) {
+            pageVisible = visible;
+            page.setVisible(visible);
+        }
+
         if (reallyVisible) {
             if (page.isDirty()) {
                 SceneHelper.setAllowPGAccess(true);
@@ -107,6 +107,7 @@ list(APPEND WebCore_PRIVATE_FRAMEWORK_HEADERS
     platform/mock/GeolocationClientMock.h
     platform/network/java/AuthenticationChallenge.h
     platform/network/java/CertificateInfo.h
+    platform/network/java/DNSResolveQueueJava.h
     platform/network/java/ResourceError.h
     platform/network/java/ResourceRequest.h
     platform/network/java/ResourceResponse.h
@@ -91,6 +91,13 @@ public:
     // Notification that this layer requires a flush on the next display refresh.
     virtual void notifySubsequentFlushRequired(const GraphicsLayer*) { }
 
+#if PLATFORM(JAVA)
+    // Sent to the client of the root layer when only the contents layer of
+    // a descendant (e.g. a video frame) needs to be drawn again, which does
+    // not require a flush.
+    virtual void notifyContentsLayerNeedsDisplay(GraphicsLayer*) { }
+#endif
+
     virtual void paintContents(const GraphicsLayer*, GraphicsContext&, const FloatRect& /* inClip */, OptionSet<GraphicsLayerPaintBehavior>) { }
     virtual void didChangePlatformLayerForLayer(const GraphicsLayer*) { }
 
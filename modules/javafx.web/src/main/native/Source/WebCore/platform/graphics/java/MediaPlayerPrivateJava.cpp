@@ -30,6 +30,7 @@
 #include "MediaPlayerPrivateJava.h"
 #include "NotImplemented.h"
 #include "PlatformContextJava.h"
+#include "TextureMapperJava.h"
 
 #include "Document.h"
 #include "Settings.h"
@@ -288,6 +289,11 @@ MediaPlayerPrivate::MediaPlayerPrivate(MediaPlayer *player)
 
 MediaPlayerPrivate::~MediaPlayerPrivate()
 {
+#if USE(TEXTURE_MAPPER)
+    if (client())
+        client()->platformLayerWillBeDestroyed();
+#endif
+
     WC_GETJAVAENV_CHKRET(env);
     static jmethodID s_mID
         = env->GetMethodID(PG_GetMediaPlayerClass(env), "fwkDispose", "()V");
@@ -600,6 +606,16 @@ void MediaPlayerPrivate::paint(GraphicsContext& gc, const FloatRect& r)
 
 //void MediaPlayerPrivate::paintCurrentFrameInContext(GraphicsContext* c, const IntRect& r) { paint(c, r); }
 
+#if USE(TEXTURE_MAPPER)
+void MediaPlayerPrivate::paintToTextureMapper(TextureMapper& textureMapper, const FloatRect& targetRect, const TransformationMatrix& modelViewMatrix, float opacity)
+{
+    if (!m_isVisible)
+        return;
+
+    static_cast<TextureMapperJava&>(textureMapper).drawMediaPlayer(m_jPlayer, targetRect, modelViewMatrix, opacity);
+}
+#endif
+
 void MediaPlayerPrivate::setPreload(MediaPlayer::Preload preload)
 {
     // enum Preload { None, MetaData, Auto };
@@ -770,6 +786,13 @@ void MediaPlayerPrivate::notifySizeChanged(int width, int height)
 void MediaPlayerPrivate::notifyNewFrame()
 {
     PLOG_TRACE0(">>MediaPlayerPrivate notifyNewFrame\n");
+#if USE(TEXTURE_MAPPER)
+    // Attached to a composited layer, only the compositor needs to run
+    if (client()) {
+        client()->setPlatformLayerNeedsDisplay();
+        return;
+    }
+#endif
     m_player->repaint();
     //PLOG_TRACE0("<<MediaPlayerPrivate notifyNewFrame\n");
 }
@@ -29,10 +29,16 @@
 #include "MediaPlayerPrivate.h"
 #include <jni.h>
 #include "TimeRanges.h"
+#if USE(TEXTURE_MAPPER)
+#include "TextureMapperPlatformLayer.h"
+#endif
 
 namespace WebCore {
     extern void resetErrorCodeInMediaPlayer(unsigned int err);
     class MediaPlayerPrivate : public MediaPlayerPrivateInterface
+#if USE(TEXTURE_MAPPER)
+                             , public TextureMapperPlatformLayer
+#endif
                              , public RefCounted<MediaPlayerPrivate> {
     public:
         //typedef MediaPlayerPrivateInterface* (*CreateMediaEnginePlayer)(MediaPlayer*);
@@ -59,8 +65,8 @@ namespace WebCore {
 
         virtual void prepareToPlay() override;
         //virtual PlatformMedia platformMedia() const { return NoPlatformMedia; }
-#if USE(ACCELERATED_COMPOSITING)
-        //virtual PlatformLayer* platformLayer() const { return 0; }
+#if USE(TEXTURE_MAPPER)
+        PlatformLayer* platformLayer() const override { return const_cast<MediaPlayerPrivate*>(this); }
 #endif
 
         virtual void play() override;
@@ -126,11 +132,13 @@ namespace WebCore {
 //        virtual void setMediaPlayerProxy(WebMediaPlayerProxy*) = 0;
 //#endif
 
-#if USE(ACCELERATED_COMPOSITING)
-        // whether accelerated rendering is supported by the media engine for the current media.
-        //virtual bool supportsAcceleratedRendering() const { return false; }
-        // called when the rendering system flips the into or out of accelerated rendering mode.
-        //virtual void acceleratedRenderingStateChanged() { }
+#if USE(TEXTURE_MAPPER)
+        // A composited <video> element draws its frames straight into the
+        // compositor output, so new frames do not repaint the element.
+        bool supportsAcceleratedRendering() const override { return true; }
+
+        // TextureMapperPlatformLayer
+        void paintToTextureMapper(TextureMapper&, const FloatRect&, const TransformationMatrix& modelViewMatrix = TransformationMatrix(), float opacity = 1.0) override;
 #endif
 
         virtual bool hasSingleSecurityOrigin() const { return true; }
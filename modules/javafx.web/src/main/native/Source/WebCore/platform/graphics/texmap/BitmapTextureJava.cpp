@@ -26,6 +26,9 @@
 #include "config.h"
 
 #include "BitmapTextureJava.h"
+#include "CSSFilter.h"
+#include "FilterOperations.h"
+#include "FilterResults.h"
 #include "GraphicsLayer.h"
 #include "NotImplemented.h"
 #include "PlatformContextJava.h"
@@ -51,10 +54,26 @@ void BitmapTextureJava::updateContents(NativeImage* image, const IntRect& target
     //m_image->context().drawImage(*image, targetRect, IntRect(offset, targetRect.size()));
 }
 
-RefPtr<BitmapTexture> BitmapTextureJava::applyFilters(TextureMapper&, const FilterOperations&, bool)
+RefPtr<BitmapTexture> BitmapTextureJava::applyFilters(TextureMapper& textureMapper, const FilterOperations& filters, bool)
 {
-    notImplemented();
-    return this;
+    if (filters.isEmpty() || !m_image)
+        return this;
+
+    // The surface already covers the filter outsets of the layer, so the
+    // whole texture is both the source and the filter region.
+    FloatRect sourceRect(FloatPoint(), contentSize());
+    auto filter = CSSFilter::create(filters, FilterRenderingMode::Software, { 1, 1 }, sourceRect);
+    if (!filter)
+        return this;
+
+    auto resultTexture = textureMapper.acquireTextureFromPool(contentSize(), BitmapTexture::SupportsAlpha);
+    GraphicsContext* context = static_cast<BitmapTextureJava&>(*resultTexture).graphicsContext();
+    if (!context)
+        return this;
+
+    FilterResults results;
+    context->drawFilteredImageBuffer(m_image.get(), sourceRect, *filter, results);
+    return resultTexture;
 }
 
 } // namespace WebCore
@@ -82,6 +82,25 @@ void GraphicsLayerTextureMapper::setContentsNeedsDisplay()
     addRepaintRect(contentsRect());
 }
 
+#if PLATFORM(JAVA)
+void GraphicsLayerTextureMapper::setPlatformLayerNeedsDisplay()
+{
+    // The contents layer is drawn on every composite, so a new frame
+    // changes neither the layer tree nor any backing store. Once the
+    // contents layer is committed, ask the root layer's client to
+    // recomposite the area it covers instead of requesting a flush.
+    if (m_changeMask & ContentChange) {
+        setContentsNeedsDisplay();
+        return;
+    }
+
+    GraphicsLayer* rootLayer = this;
+    while (rootLayer->parent())
+        rootLayer = rootLayer->parent();
+    rootLayer->client().notifyContentsLayerNeedsDisplay(this);
+}
+#endif
+
 void GraphicsLayerTextureMapper::setNeedsDisplayInRect(const FloatRect& rect, ShouldClipToLayer)
 {
     if (!drawsContent())
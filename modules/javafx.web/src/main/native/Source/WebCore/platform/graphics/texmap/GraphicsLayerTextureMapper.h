@@ -102,7 +102,11 @@ private:
 
     // TextureMapperPlatformLayer::Client
     void platformLayerWillBeDestroyed() override { setContentsToPlatformLayer(0, ContentsLayerPurpose::None); }
+#if PLATFORM(JAVA)
+    void setPlatformLayerNeedsDisplay() override;
+#else
     void setPlatformLayerNeedsDisplay() override { setContentsNeedsDisplay(); }
+#endif
 
     void commitLayerChanges();
     void updateDebugBorderAndRepaintCount();
@@ -29,6 +29,7 @@
 #include "PlatformContextJava.h"
 #include "BitmapTexturePool.h"
 #include "GraphicsLayer.h"
+#include "NativeImage.h"
 #include "NotImplemented.h"
 
 #include "com_sun_webkit_graphics_GraphicsDecoder.h"
@@ -36,7 +37,32 @@
 #if USE(TEXTURE_MAPPER)
 namespace WebCore {
 
-static const int s_maximumAllowedImageBufferDimension = 256;
+static const int s_minimumTileDimension = 128;
+static const int s_maximumTileDimension = 2048;
+static int s_tileDimension = 512;
+
+unsigned TextureMapperJava::s_cachedSurfacesGeneration = 0;
+
+// Sets the transform of a layer draw. Most composited layers are only
+// translated or scaled, so affine transforms are concatenated to the CTM
+// instead of sending a full perspective matrix through the render queue.
+static void applyLayerTransform(GraphicsContext& context, const TransformationMatrix& transform)
+{
+    if (transform.isIdentity())
+        return;
+
+    if (transform.isAffine()) {
+        context.concatCTM(transform.toAffineTransform());
+        return;
+    }
+
+    context.platformContext()->rq().freeSpace(68)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
+        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
+        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
+        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
+        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+}
 
 std::unique_ptr<TextureMapper> TextureMapper::platformCreateAccelerated()
 {
@@ -48,9 +74,14 @@ TextureMapperJava::TextureMapperJava()
     m_texturePool = std::make_unique<BitmapTexturePool>();
 }
 
+void TextureMapperJava::setTileSize(int dimension)
+{
+    s_tileDimension = std::clamp(dimension, s_minimumTileDimension, s_maximumTileDimension);
+}
+
 IntSize TextureMapperJava::maxTextureSize() const
 {
-    return IntSize(s_maximumAllowedImageBufferDimension, s_maximumAllowedImageBufferDimension);
+    return IntSize(s_tileDimension, s_tileDimension);
 }
 
 void TextureMapperJava::beginClip(const TransformationMatrix& matrix, const FloatRoundedRect& rect)
@@ -76,12 +107,7 @@ void TextureMapperJava::drawTexture(const BitmapTexture& texture, const FloatRec
     context->save();
     context->setCompositeOperation(isInMaskMode() ? CompositeOperator::DestinationIn : CompositeOperator::SourceOver);
     context->setAlpha(opacity);
-    context->platformContext()->rq().freeSpace(68)
-        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
-        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
-        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
-        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
-        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+    applyLayerTransform(*context, transform);
     context->drawImageBuffer(*image, targetRect);
     context->restore();
 }
@@ -94,20 +120,73 @@ void TextureMapperJava::drawSolidColor(const FloatRect& rect, const Transformati
 
     context->save();
     context->setCompositeOperation(isInMaskMode() ? CompositeOperator::DestinationIn : CompositeOperator::SourceOver);
-    context->platformContext()->rq().freeSpace(68)
-        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
-        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
-        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
-        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
-        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
-
+    applyLayerTransform(*context, transform);
     context->fillRect(rect, color);
     context->restore();
 }
 
-void TextureMapperJava::drawBorder(const Color&, float /* borderWidth */, const FloatRect&, const TransformationMatrix&)
+void TextureMapperJava::drawBorder(const Color& color, float borderWidth, const FloatRect& rect, const TransformationMatrix& transform)
 {
-    notImplemented();
+    GraphicsContext* context = currentContext();
+    if (!context)
+        return;
+
+    context->save();
+    applyLayerTransform(*context, transform);
+    context->setStrokeColor(color);
+    context->strokeRect(rect, borderWidth);
+    context->restore();
+}
+
+void TextureMapperJava::drawMediaPlayer(const RefPtr<RQRef>& player, const FloatRect& targetRect, const TransformationMatrix& transform, float opacity)
+{
+    GraphicsContext* context = currentContext();
+    if (!context || !player)
+        return;
+
+    context->save();
+    context->setAlpha(opacity);
+    applyLayerTransform(*context, transform);
+    context->platformContext()->rq().freeSpace(24)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_RENDERMEDIAPLAYER
+        << player << (jint)targetRect.x() << (jint)targetRect.y()
+        << (jint)targetRect.width() << (jint)targetRect.height();
+    context->restore();
+}
+
+// Makes the queued drawing of a surface visible to the queue it is read from.
+static void flushImageRQ(RenderingQueue& rq, const PlatformImagePtr& image)
+{
+    auto imageRQ = image->getRenderingQueue();
+    if (!imageRQ || imageRQ->isEmpty())
+        return;
+
+    imageRQ->flushBuffer();
+    rq.freeSpace(8)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_DECODERQ
+        << imageRQ->getRQRenderingQueue();
+}
+
+void TextureMapperJava::drawTextureMasked(const BitmapTexture& texture, const BitmapTexture& mask)
+{
+    GraphicsContext* context = currentContext();
+    ImageBuffer* image = static_cast<const BitmapTextureJava&>(texture).image();
+    ImageBuffer* maskImage = static_cast<const BitmapTextureJava&>(mask).image();
+    if (!context || !image || !maskImage)
+        return;
+
+    auto nativeImage = image->createNativeImageReference();
+    auto nativeMask = maskImage->createNativeImageReference();
+    if (!nativeImage || !nativeMask)
+        return;
+
+    RenderingQueue& rq = context->platformContext()->rq();
+    flushImageRQ(rq, nativeImage->platformImage());
+    flushImageRQ(rq, nativeMask->platformImage());
+    rq.freeSpace(12)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_DRAWIMAGE_MASKED
+        << nativeImage->platformImage()->getImage()
+        << nativeMask->platformImage()->getImage();
 }
 
 void TextureMapperJava::drawNumber(int /* number */, const Color&, const FloatPoint&, const TransformationMatrix&)
@@ -27,6 +27,7 @@
 
 #include "BitmapTextureJava.h"
 #include "ImageBuffer.h"
+#include "RQRef.h"
 #include "TextureMapper.h"
 #include "GraphicsContext.h"
 #if USE(TEXTURE_MAPPER)
@@ -37,6 +38,10 @@ class TextureMapperJava final : public TextureMapper {
 public:
     TextureMapperJava();
 
+    // Sets the edge length of the intermediate surfaces used for layers
+    // with filters, masks or blending. Clamped to [128, 2048].
+    static void setTileSize(int);
+
     // TextureMapper implementation
     void drawBorder(const Color&, float borderWidth, const FloatRect&, const TransformationMatrix&) final;
     void drawNumber(int number, const Color&, const FloatPoint&, const TransformationMatrix&) final;
@@ -53,6 +58,19 @@ public:
     void setDepthRange(double zNear, double zFar) final;
     void clearColor(const Color&) final;
 
+    // Draws the current frame of a media player that is the contents
+    // layer of a composited <video> element.
+    void drawMediaPlayer(const RefPtr<RQRef>& player, const FloatRect& targetRect, const TransformationMatrix&, float opacity);
+
+    // Draws a texture multiplied by the alpha of a mask texture of the
+    // same size at the origin of the current surface.
+    void drawTextureMasked(const BitmapTexture&, const BitmapTexture& mask);
+
+    // The intermediate surfaces of layers with filters or masks are kept
+    // between frames while the layer tree and contents layers are unchanged.
+    static unsigned cachedSurfacesGeneration() { return s_cachedSurfacesGeneration; }
+    static void invalidateCachedSurfaces() { ++s_cachedSurfacesGeneration; }
+
     inline GraphicsContext* currentContext()
     {
         return m_currentSurface ? static_cast<BitmapTextureJava*>(m_currentSurface.get())->graphicsContext() : graphicsContext();
@@ -61,6 +79,8 @@ public:
     void setGraphicsContext(GraphicsContext* context) { m_context = context; }
     GraphicsContext* graphicsContext() { return m_context; }
 private:
+    static unsigned s_cachedSurfacesGeneration;
+
     RefPtr<BitmapTexture> m_currentSurface;
     GraphicsContext* m_context;
 };
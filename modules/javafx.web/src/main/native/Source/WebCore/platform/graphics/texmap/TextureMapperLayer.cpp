@@ -23,6 +23,9 @@
 
 #include "FloatQuad.h"
 #include "Region.h"
+#if PLATFORM(JAVA)
+#include "TextureMapperJava.h"
+#endif
 #include <wtf/MathExtras.h>
 #include <wtf/SetForScope.h>
 
@@ -619,8 +622,30 @@ void TextureMapperLayer::paintUsingOverlapRegions(TextureMapperPaintOptions& opt
     }
 }
 
+static int floorToTile(int value, int tileDimension)
+{
+    return value >= 0 ? value - value % tileDimension : value - (value + 1) % tileDimension - tileDimension + 1;
+}
+
+static int ceilToTile(int value, int tileDimension)
+{
+    return floorToTile(value + tileDimension - 1, tileDimension);
+}
+
 void TextureMapperLayer::paintSelfChildrenFilterAndMask(TextureMapperPaintOptions& options)
 {
+    // The tiles are aligned to a grid and not to the repainted area, so that
+    // a tile, and the surface cached for it, stays the same whatever part of
+    // the layer is repainted.
+    IntSize maxTextureSize = options.textureMapper.maxTextureSize();
+    IntRect clipBounds = options.textureMapper.clipBounds();
+    clipBounds.move(-options.offset);
+    int minX = floorToTile(clipBounds.x(), maxTextureSize.width());
+    int minY = floorToTile(clipBounds.y(), maxTextureSize.height());
+    IntRect tileAlignedClipBounds(minX, minY,
+        ceilToTile(clipBounds.maxX(), maxTextureSize.width()) - minX,
+        ceilToTile(clipBounds.maxY(), maxTextureSize.height()) - minY);
+
     Region overlapRegion;
     Region nonOverlapRegion;
     auto mode = ComputeOverlapRegionMode::Union;
@@ -628,11 +653,10 @@ void TextureMapperLayer::paintSelfChildrenFilterAndMask(TextureMapperPaintOption
         mode = ComputeOverlapRegionMode::Mask;
     ComputeOverlapRegionData data {
         mode,
-        options.textureMapper.clipBounds(),
+        tileAlignedClipBounds,
         overlapRegion,
         nonOverlapRegion
     };
-    data.clipBounds.move(-options.offset);
     computeOverlapRegions(data, options.transform, false);
     ASSERT(nonOverlapRegion.isEmpty());
 
@@ -643,12 +667,13 @@ void TextureMapperLayer::paintSelfChildrenFilterAndMask(TextureMapperPaintOption
         rects.append(overlapRegion.bounds());
     }
 
-    IntSize maxTextureSize = options.textureMapper.maxTextureSize();
     for (auto& rect : rects) {
-        for (int x = rect.x(); x < rect.maxX(); x += maxTextureSize.width()) {
-            for (int y = rect.y(); y < rect.maxY(); y += maxTextureSize.height()) {
+        for (int x = floorToTile(rect.x(), maxTextureSize.width()); x < rect.maxX(); x += maxTextureSize.width()) {
+            for (int y = floorToTile(rect.y(), maxTextureSize.height()); y < rect.maxY(); y += maxTextureSize.height()) {
                 IntRect tileRect(IntPoint(x, y), maxTextureSize);
                 tileRect.intersect(rect);
+                if (!tileRect.intersects(clipBounds))
+                    continue;
 
                 paintSelfAndChildrenWithIntermediateSurface(options, tileRect);
             }
@@ -679,11 +704,41 @@ void TextureMapperLayer::paintIntoSurface(TextureMapperPaintOptions& options)
     bool defersLastFilter = !hasMask && !hasReplicaMask;
     options.surface = options.surface->applyFilters(options.textureMapper, m_currentFilters, defersLastFilter);
     options.textureMapper.bindSurface(options.surface.get());
+#if PLATFORM(JAVA)
+    if (hasMask || hasReplicaMask)
+        applyMasks(options, hasMask, hasReplicaMask);
+#else
     if (hasMask)
         m_state.maskLayer->applyMask(options);
     if (hasReplicaMask)
         m_state.replicaLayer->m_state.maskLayer->applyMask(options);
+#endif
+}
+
+#if PLATFORM(JAVA)
+void TextureMapperLayer::applyMasks(TextureMapperPaintOptions& options, bool hasMask, bool hasReplicaMask)
+{
+    // The masks are painted into a surface of their own, which is then
+    // applied to the contents in a single masked draw.
+    auto& textureMapper = static_cast<TextureMapperJava&>(options.textureMapper);
+    IntSize size = options.surface->contentSize();
+    auto maskSurface = textureMapper.acquireTextureFromPool(size, BitmapTexture::SupportsAlpha);
+    textureMapper.bindSurface(maskSurface.get());
+    if (hasMask)
+        m_state.maskLayer->paintSelf(options);
+    if (hasReplicaMask) {
+        if (hasMask)
+            m_state.replicaLayer->m_state.maskLayer->applyMask(options);
+        else
+            m_state.replicaLayer->m_state.maskLayer->paintSelf(options);
+    }
+
+    auto maskedSurface = textureMapper.acquireTextureFromPool(size, BitmapTexture::SupportsAlpha);
+    textureMapper.bindSurface(maskedSurface.get());
+    textureMapper.drawTextureMasked(*options.surface, *maskSurface);
+    options.surface = WTFMove(maskedSurface);
 }
+#endif
 
 static void commitSurface(TextureMapperPaintOptions& options, BitmapTexture& surface, const IntRect& rect, float opacity)
 {
@@ -708,8 +763,44 @@ void TextureMapperLayer::paintWithIntermediateSurface(TextureMapperPaintOptions&
     commitSurface(options, *surface, rect, options.opacity);
 }
 
+#if PLATFORM(JAVA)
+// Each cached tile holds a surface of up to the tile size, which the pool
+// can only reuse or release once the cache drops it.
+static constexpr size_t maxCachedSurfaces = 4;
+#endif
+
 void TextureMapperLayer::paintSelfAndChildrenWithIntermediateSurface(TextureMapperPaintOptions& options, const IntRect& rect)
 {
+#if PLATFORM(JAVA)
+    // Running the filters and masks again is only needed when the layer
+    // tree, a contents layer or an animation below this layer changed what
+    // the tile shows. Opacity is applied when the surface is committed.
+    bool canCacheSurface = !m_isBackdrop && !options.replicaLayer && !options.preserves3D && !descendantsOrSelfWereAnimated();
+    if (canCacheSurface && m_cachedSurfacesGeneration != TextureMapperJava::cachedSurfacesGeneration()) {
+        m_cachedSurfaces.clear();
+        m_cachedSurfacesGeneration = TextureMapperJava::cachedSurfacesGeneration();
+    }
+
+    if (canCacheSurface) {
+        // The entries are kept in least recently used order
+        size_t index = m_cachedSurfaces.findIf([&](auto& entry) {
+            return entry.rect == rect;
+        });
+        if (index != notFound) {
+            CachedSurface entry = WTFMove(m_cachedSurfaces[index]);
+            m_cachedSurfaces.remove(index);
+            if (entry.transform == options.transform
+                && entry.layerTransform == m_layerTransforms.combined
+                && entry.filters == m_currentFilters) {
+                commitSurface(options, *entry.surface, rect, options.opacity);
+                m_cachedSurfaces.append(WTFMove(entry));
+                return;
+            }
+        }
+    } else
+        m_cachedSurfaces.clear();
+#endif
+
     auto surface = options.textureMapper.acquireTextureFromPool(rect.size(), BitmapTexture::SupportsAlpha);
     {
         SetForScope scopedSurface(options.surface, surface);
@@ -720,6 +811,14 @@ void TextureMapperLayer::paintSelfAndChildrenWithIntermediateSurface(TextureMapp
         surface = options.surface;
     }
 
+#if PLATFORM(JAVA)
+    if (canCacheSurface) {
+        if (m_cachedSurfaces.size() == maxCachedSurfaces)
+            m_cachedSurfaces.remove(0);
+        m_cachedSurfaces.append({ rect, options.transform, m_layerTransforms.combined, m_currentFilters, surface });
+    }
+#endif
+
     commitSurface(options, *surface, rect, options.opacity);
 }
 
@@ -742,8 +841,14 @@ void TextureMapperLayer::paintSelfChildrenReplicaFilterAndMask(TextureMapperPain
             paintSelfChildrenFilterAndMask(options);
         }
         paintSelfChildrenFilterAndMask(options);
-    } else
+    } else {
+#if PLATFORM(JAVA)
+        // Hands the tiles of a layer that lost its filters and masks back
+        // to the texture pool
+        m_cachedSurfaces.clear();
+#endif
         paintSelfAndChildrenWithReplica(options);
+    }
 }
 
 void TextureMapperLayer::paintRecursive(TextureMapperPaintOptions& options)
@@ -1030,6 +1135,65 @@ bool TextureMapperLayer::descendantsOrSelfHaveRunningAnimations() const
         });
 }
 
+#if PLATFORM(JAVA)
+bool TextureMapperLayer::descendantsOrSelfWereAnimated() const
+{
+    if (m_hadRunningAnimations || m_animationsEnded)
+        return true;
+    if (m_state.maskLayer && m_state.maskLayer->descendantsOrSelfWereAnimated())
+        return true;
+    if (m_state.replicaLayer && m_state.replicaLayer->descendantsOrSelfWereAnimated())
+        return true;
+
+    return std::any_of(m_children.begin(), m_children.end(),
+        [](TextureMapperLayer* child) {
+            return child->descendantsOrSelfWereAnimated();
+        });
+}
+
+IntRect TextureMapperLayer::runningAnimationsBoundingRect(const IntRect& clipBounds)
+{
+    ComputeTransformData data;
+    computeTransformsRecursive(data);
+
+    IntRect boundingRect;
+    collectRunningAnimationsBoundingRect(boundingRect, clipBounds, false);
+    return boundingRect;
+}
+
+IntRect TextureMapperLayer::contentsLayerBoundingRect(const IntRect& clipBounds)
+{
+    if (!m_contentsLayer || !m_state.visible || !m_state.contentsVisible)
+        return { };
+
+    ComputeTransformData data;
+    rootLayer().computeTransformsRecursive(data);
+
+    return transformedBoundingBox(m_layerTransforms.combined, m_state.contentsRect, clipBounds);
+}
+
+void TextureMapperLayer::collectRunningAnimationsBoundingRect(IntRect& boundingRect, const IntRect& clipBounds, bool isAnimated)
+{
+    // An animated layer moves its whole subtree along with it. A layer whose
+    // animations just ended jumps to its final state, which is drawn too.
+    isAnimated |= m_animations.hasRunningAnimations() || m_animationsEnded;
+    if (isAnimated && m_state.visible) {
+        FloatRect localBoundingRect = unionRect(layerRect(), m_state.contentsRect);
+        if (m_currentFilters.hasOutsets()) {
+            auto outsets = m_currentFilters.outsets();
+            localBoundingRect.move(-outsets.left(), -outsets.top());
+            localBoundingRect.expand(outsets.left() + outsets.right(), outsets.top() + outsets.bottom());
+        }
+        boundingRect.unite(transformedBoundingBox(m_layerTransforms.combined, localBoundingRect, clipBounds));
+    }
+
+    if (m_state.replicaLayer)
+        m_state.replicaLayer->collectRunningAnimationsBoundingRect(boundingRect, clipBounds, isAnimated);
+    for (auto* child : m_children)
+        child->collectRunningAnimationsBoundingRect(boundingRect, clipBounds, isAnimated);
+}
+#endif
+
 bool TextureMapperLayer::applyAnimationsRecursively(MonotonicTime time)
 {
     bool hasRunningAnimations = syncAnimations(time);
@@ -1051,6 +1215,11 @@ bool TextureMapperLayer::syncAnimations(MonotonicTime time)
     m_currentOpacity = applicationResults.opacity.value_or(m_state.opacity);
     m_currentFilters = applicationResults.filters.value_or(m_state.filters);
 
+#if PLATFORM(JAVA)
+    m_animationsEnded = m_hadRunningAnimations && !applicationResults.hasRunningAnimations;
+    m_hadRunningAnimations = applicationResults.hasRunningAnimations;
+#endif
+
 #if USE(COORDINATED_GRAPHICS)
     // Calculate localTransform 50ms in the future.
     Nicosia::Animation::ApplicationResult futureApplicationResults;
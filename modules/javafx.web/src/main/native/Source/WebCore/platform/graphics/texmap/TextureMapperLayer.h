@@ -107,6 +107,14 @@ public:
     bool applyAnimationsRecursively(MonotonicTime);
     bool syncAnimations(MonotonicTime);
     bool descendantsOrSelfHaveRunningAnimations() const;
+#if PLATFORM(JAVA)
+    // Returns the viewport area covered by layers with running animations,
+    // or whose animations ended in the last applyAnimationsRecursively(),
+    // and their descendants, using the current transforms.
+    IntRect runningAnimationsBoundingRect(const IntRect& clipBounds);
+    // Returns the viewport area covered by the contents layer of this layer.
+    IntRect contentsLayerBoundingRect(const IntRect& clipBounds);
+#endif
 
     void paint(TextureMapper&);
 
@@ -143,6 +151,11 @@ private:
         Region& nonOverlapRegion;
     };
     void computeOverlapRegions(ComputeOverlapRegionData&, const TransformationMatrix&, bool includesReplica = true);
+#if PLATFORM(JAVA)
+    void collectRunningAnimationsBoundingRect(IntRect&, const IntRect& clipBounds, bool isAnimated);
+    bool descendantsOrSelfWereAnimated() const;
+    void applyMasks(TextureMapperPaintOptions&, bool hasMask, bool hasReplicaMask);
+#endif
 
     void paintRecursive(TextureMapperPaintOptions&);
     void paintWith3DRenderingContext(TextureMapperPaintOptions&);
@@ -236,6 +249,21 @@ private:
 #endif
     bool m_isBackdrop { false };
     bool m_isReplica { false };
+#if PLATFORM(JAVA)
+    bool m_hadRunningAnimations { false };
+    bool m_animationsEnded { false };
+
+    // Filtered and masked tiles of this layer from previous frames
+    struct CachedSurface {
+        IntRect rect;
+        TransformationMatrix transform;
+        TransformationMatrix layerTransform;
+        FilterOperations filters;
+        RefPtr<BitmapTexture> surface;
+    };
+    Vector<CachedSurface> m_cachedSurfaces;
+    unsigned m_cachedSurfacesGeneration { 0 };
+#endif
 
     struct {
         TransformationMatrix localTransform;
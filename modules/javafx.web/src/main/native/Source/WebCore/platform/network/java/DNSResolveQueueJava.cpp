@@ -28,30 +28,201 @@
 
 #if PLATFORM(JAVA)
 
-#include "NotImplemented.h"
+#include "PlatformJavaClasses.h"
+#include "ResourceError.h"
+#include "com_sun_webkit_LoadListenerClient.h"
+#include "com_sun_webkit_network_NetworkContext.h"
+#include <wtf/CompletionHandler.h>
+#include <wtf/MainThread.h>
+#include <wtf/URL.h>
+
+namespace DNSResolveQueueJavaInternal {
+
+static JGClass networkContextClass;
+static jmethodID isUsingProxyMethod;
+static jmethodID resolveMethod;
+
+static void initRefs(JNIEnv* env)
+{
+    if (!networkContextClass) {
+        networkContextClass = JLClass(env->FindClass(
+                "com/sun/webkit/network/NetworkContext"));
+        ASSERT(networkContextClass);
+
+        isUsingProxyMethod = env->GetStaticMethodID(
+                networkContextClass,
+                "fwkIsUsingProxy",
+                "(Ljava/lang/String;)Z");
+        ASSERT(isUsingProxyMethod);
+
+        resolveMethod = env->GetStaticMethodID(
+                networkContextClass,
+                "fwkResolve",
+                "(Ljava/lang/String;J)V");
+        ASSERT(resolveMethod);
+    }
+}
+
+using LookupCompletionHandler = CompletionHandler<void(const WebCore::DNSAddressesOrError&)>;
+
+}
 
 namespace WebCore {
 
+DNSResolveQueueJava::DNSResolveQueueJava()
+{
+}
+
 void DNSResolveQueueJava::updateIsUsingProxy()
 {
-    notImplemented();
+    // The ProxySelector decides per URI, so the proxy is checked for each
+    // host in isProxiedHost() rather than once for all of them.
+    m_isUsingProxy = false;
 }
 
-void DNSResolveQueueJava::platformResolve(const String& /* hostname */)
+bool DNSResolveQueueJava::isProxiedHost(const String& hostname)
 {
-    notImplemented();
+    using namespace DNSResolveQueueJavaInternal;
+
+    JNIEnv* env = WTF::GetJavaEnv();
+    initRefs(env);
+
+    jboolean result = env->CallStaticBooleanMethod(
+            networkContextClass,
+            isUsingProxyMethod,
+            (jstring) hostname.toJavaString(env));
+    // Don't resolve if the Java side could not tell
+    return WTF::CheckAndClearException(env) || result;
 }
 
-void DNSResolveQueueJava::resolve(const String& /* hostname */, uint64_t /* identifier */, DNSCompletionHandler&& /* completionHandler */)
+void DNSResolveQueueJava::lookup(const String& hostname, CompletionHandler<void(const DNSAddressesOrError&)>&& completionHandler)
 {
-    notImplemented();
+    using namespace DNSResolveQueueJavaInternal;
+
+    ASSERT(isMainThread());
+
+    if (hostname.isEmpty()) {
+        callOnMainThread([completionHandler = WTFMove(completionHandler)]() mutable {
+            completionHandler(makeUnexpected(DNSError::CannotResolve));
+        });
+        return;
+    }
+
+    JNIEnv* env = WTF::GetJavaEnv();
+    initRefs(env);
+
+    // NetworkContext resolves the host with InetAddress on a background
+    // thread, which also fills the JDK address cache used by the loaders,
+    // and hands the handler back to twkDidResolve on the main thread.
+    auto* handler = new LookupCompletionHandler(WTFMove(completionHandler));
+    env->CallStaticVoidMethod(
+            networkContextClass,
+            resolveMethod,
+            (jstring) hostname.toJavaString(env),
+            ptr_to_jlong(handler));
+    WTF::CheckAndClearException(env);
 }
 
-void DNSResolveQueueJava::stopResolve(uint64_t /* identifier */)
+void DNSResolveQueueJava::platformResolve(const String& hostname)
 {
-    notImplemented();
+    if (isProxiedHost(hostname)) {
+        decrementRequestCount();
+        return;
+    }
+    lookup(hostname, [this](const DNSAddressesOrError&) {
+        decrementRequestCount();
+    });
 }
 
+void DNSResolveQueueJava::resolve(const String& hostname, uint64_t identifier, DNSCompletionHandler&& completionHandler)
+{
+    ASSERT(isMainThread());
+
+    m_pendingRequests.add(identifier, WTFMove(completionHandler));
+    lookup(hostname, [this, identifier](const DNSAddressesOrError& result) {
+        // Already completed by stopResolve() if it is not pending anymore
+        if (auto completionHandler = m_pendingRequests.take(identifier))
+            completionHandler(DNSAddressesOrError { result });
+    });
+}
+
+void DNSResolveQueueJava::stopResolve(uint64_t identifier)
+{
+    ASSERT(isMainThread());
+
+    if (auto completionHandler = m_pendingRequests.take(identifier))
+        completionHandler(makeUnexpected(DNSError::Cancelled));
+}
+
+void DNSResolveQueueJava::preconnect(const URL& url, Function<void(const ResourceError&)>&& completionHandler)
+{
+    ASSERT(isMainThread());
+
+    String hostname = url.host().toString();
+    if (!url.protocolIsInHTTPFamily() || hostname.isEmpty()) {
+        completionHandler(ResourceError(
+                String(),
+                com_sun_webkit_LoadListenerClient_MALFORMED_URL,
+                url,
+                "Cannot preconnect to a non-HTTP URL"_s));
+        return;
+    }
+
+    // The proxy resolves host names on our behalf
+    if (isProxiedHost(hostname)) {
+        completionHandler(ResourceError { });
+        return;
+    }
+
+    // Neither HttpURLConnection nor HttpClient can open a pooled connection
+    // without a request, so the lookup, which warms the JDK address cache
+    // they connect through, is all the preconnecting there is.
+    lookup(hostname, [url, completionHandler = WTFMove(completionHandler)](const DNSAddressesOrError& result) mutable {
+        if (!result) {
+            completionHandler(ResourceError(
+                    String(),
+                    com_sun_webkit_LoadListenerClient_UNKNOWN_HOST,
+                    url,
+                    "Unknown host"_s));
+            return;
+        }
+        completionHandler(ResourceError { });
+    });
+}
+
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_NetworkContext_twkDidResolve
+  (JNIEnv* env, jclass, jobjectArray addresses, jlong data)
+{
+    using namespace WebCore;
+    using namespace DNSResolveQueueJavaInternal;
+
+    std::unique_ptr<LookupCompletionHandler> completionHandler(
+            static_cast<LookupCompletionHandler*>(jlong_to_ptr(data)));
+    ASSERT(completionHandler);
+
+    Vector<IPAddress> result;
+    jsize count = addresses ? env->GetArrayLength(addresses) : 0;
+    for (jsize i = 0; i < count; i++) {
+        JLocalRef<jbyteArray> address(static_cast<jbyteArray>(
+                env->GetObjectArrayElement(addresses, i)));
+        jsize length = env->GetArrayLength(address);
+        if (length == sizeof(struct in_addr)) {
+            struct in_addr ipv4 { };
+            env->GetByteArrayRegion(address, 0, length, reinterpret_cast<jbyte*>(&ipv4));
+            result.append(IPAddress { ipv4 });
+        } else if (length == sizeof(struct in6_addr)) {
+            struct in6_addr ipv6 { };
+            env->GetByteArrayRegion(address, 0, length, reinterpret_cast<jbyte*>(&ipv6));
+            result.append(IPAddress { ipv6 });
+        }
+    }
+
+    if (result.isEmpty())
+        (*completionHandler)(makeUnexpected(DNSError::CannotResolve));
+    else
+        (*completionHandler)(WTFMove(result));
 }
 
 #endif
@@ -26,18 +26,30 @@
 #pragma once
 
 #include "DNSResolveQueue.h"
+#include <wtf/HashMap.h>
 
 namespace WebCore {
 
+class ResourceError;
+
 class DNSResolveQueueJava final : public DNSResolveQueue {
 public:
-    DNSResolveQueueJava() = default;
+    DNSResolveQueueJava();
     void resolve(const String& hostname, uint64_t identifier, DNSCompletionHandler&&) final;
     void stopResolve(uint64_t identifier) final;
 
+    WEBCORE_EXPORT void preconnect(const URL&, Function<void(const ResourceError&)>&&);
+
 private:
     void updateIsUsingProxy() final;
     void platformResolve(const String&) final;
+    bool isProxiedHost(const String& hostname);
+
+    void lookup(const String& hostname, CompletionHandler<void(const DNSAddressesOrError&)>&&);
+
+    // Only touched on the main thread. Host names are resolved by the JDK,
+    // which also caches the results for the loads that follow.
+    HashMap<uint64_t, DNSCompletionHandler> m_pendingRequests;
 };
 
 using DNSResolveQueuePlatform = DNSResolveQueueJava;
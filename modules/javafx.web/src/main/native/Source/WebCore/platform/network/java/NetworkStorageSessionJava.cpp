@@ -33,10 +33,15 @@
 #include "NotImplemented.h"
 #include "ResourceHandle.h"
 
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
 #include <wtf/MainThread.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/URL.h>
+#include <wtf/WallTime.h>
+#include <wtf/text/StringConcatenate.h>
 #include "PlatformJavaClasses.h"
+#include "com_sun_webkit_network_CookieJar.h"
 
 namespace WebCore {
 
@@ -67,9 +72,83 @@ static void initRefs(JNIEnv* env)
     }
 }
 
+// Cookie strings returned by the Java cookie handler. CookieJar reports
+// every change of the Java store along with the earliest expiry time of
+// the stored cookies, so a cached string stays valid until either
+// happens. Handlers other than our own CookieManager report a change on
+// every access, which keeps their results out of the cache.
+class CookieCache {
+public:
+    static CookieCache& singleton()
+    {
+        static NeverDestroyed<CookieCache> cache;
+        return cache;
+    }
+
+    uint64_t generation()
+    {
+        Locker locker { m_lock };
+        return m_generation;
+    }
+
+    std::optional<String> get(const String& key)
+    {
+        Locker locker { m_lock };
+        if (!isValid())
+            return std::nullopt;
+        auto it = m_cookies.find(key);
+        if (it == m_cookies.end())
+            return std::nullopt;
+        return it->value;
+    }
+
+    void add(const String& key, const String& cookies, uint64_t generation)
+    {
+        Locker locker { m_lock };
+        // Drop results the Java store may have changed under us
+        if (generation != m_generation || !isValid())
+            return;
+        if (m_cookies.size() >= maxEntries)
+            m_cookies.clear();
+        m_cookies.set(key, cookies);
+    }
+
+    void invalidate(int64_t earliestExpiryTime)
+    {
+        Locker locker { m_lock };
+        ++m_generation;
+        m_earliestExpiryTime = earliestExpiryTime;
+        m_cookies.clear();
+    }
+
+private:
+    static constexpr unsigned maxEntries = 512;
+
+    bool isValid() const WTF_REQUIRES_LOCK(m_lock)
+    {
+        // Same check as Cookie.hasExpired() on the Java side
+        auto now = static_cast<int64_t>(WallTime::now().secondsSinceEpoch().milliseconds());
+        return now <= m_earliestExpiryTime;
+    }
+
+    Lock m_lock;
+    HashMap<String, String> m_cookies WTF_GUARDED_BY_LOCK(m_lock);
+    uint64_t m_generation WTF_GUARDED_BY_LOCK(m_lock) { 0 };
+    // Nothing is cached until CookieJar has reported the state of the store
+    int64_t m_earliestExpiryTime WTF_GUARDED_BY_LOCK(m_lock) { std::numeric_limits<int64_t>::min() };
+};
+
 static String getCookies(const URL& url, bool includeHttpOnlyCookies)
 {
     using namespace CookieInternalJava;
+
+    // The Java cookie handler only looks at the scheme, host and path
+    String key = makeString(includeHttpOnlyCookies ? '1' : '0', url.protocol(), "://"_s, url.host(), url.path());
+    auto& cache = CookieCache::singleton();
+    if (auto cookies = cache.get(key))
+        return *cookies;
+    uint64_t generation = cache.generation();
+
     JNIEnv* env = WTF::GetJavaEnv();
     initRefs(env);
 
@@ -78,9 +157,12 @@ static String getCookies(const URL& url, bool includeHttpOnlyCookies)
             getMethod,
             (jstring) url.string().toJavaString(env),
             bool_to_jbool(includeHttpOnlyCookies)));
-    WTF::CheckAndClearException(env);
+    if (WTF::CheckAndClearException(env))
+        return emptyString();
 
-    return result ? String(env, result) : emptyString();
+    String cookies = result ? String(env, result) : emptyString();
+    cache.add(key, cookies, generation);
+    return cookies;
 }
 }
 
@@ -181,3 +263,13 @@ Vector<Cookie> NetworkStorageSession::getCookies(const URL&)
 
 } // namespace WebCore
 
+extern "C" {
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_CookieJar_twkCookiesChanged
+  (JNIEnv*, jclass, jlong earliestExpiryTime)
+{
+    WebCore::CookieInternalJava::CookieCache::singleton().invalidate(earliestExpiryTime);
+}
+
+}
+
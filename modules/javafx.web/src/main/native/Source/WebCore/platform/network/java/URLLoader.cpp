@@ -47,6 +47,7 @@
 #include "com_sun_webkit_LoadListenerClient.h"
 #include "com_sun_webkit_network_URLLoaderBase.h"
 #include <wtf/CompletionHandler.h>
+#include <wtf/MallocPtr.h>
 
 namespace WebCore {
 class Page;
@@ -299,11 +300,11 @@ void URLLoader::AsynchronousTarget::didReceiveResponse(
     }
 }
 
-void URLLoader::AsynchronousTarget::didReceiveData(const SharedBuffer* data, int length)
+void URLLoader::AsynchronousTarget::didReceiveData(const SharedBuffer& data)
 {
     ResourceHandleClient* client = m_handle->client();
     if (client) {
-        client->didReceiveData(m_handle, *data, length);
+        client->didReceiveData(m_handle, data, data.size());
     }
 }
 
@@ -363,9 +364,9 @@ void URLLoader::SynchronousTarget::didReceiveResponse(
     m_response = response;
 }
 
-void URLLoader::SynchronousTarget::didReceiveData(const SharedBuffer* data, int length)
+void URLLoader::SynchronousTarget::didReceiveData(const SharedBuffer& data)
 {
-    m_data.append(data->data(), (size_t)length);
+    m_data.append(data.data(), data.size());
 }
 
 void URLLoader::SynchronousTarget::didFinishLoading()
@@ -497,7 +498,24 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveRe
     target->didReceiveResponse(response);
 }
 
-JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveData
+JNIEXPORT jobject JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkAllocateSegment
+  (JNIEnv* env, jclass, jint capacity)
+{
+    void* segment = fastMalloc(capacity);
+    jobject byteBuffer = env->NewDirectByteBuffer(segment, capacity);
+    if (!byteBuffer) {
+        fastFree(segment);
+    }
+    return byteBuffer;
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkReleaseSegment
+  (JNIEnv* env, jclass, jobject byteBuffer)
+{
+    fastFree(env->GetDirectBufferAddress(byteBuffer));
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveSegment
   (JNIEnv* env, jclass, jobject byteBuffer, jint position, jint remaining,
    jlong data)
 {
@@ -505,11 +523,16 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveDa
     URLLoader::Target* target =
             static_cast<URLLoader::Target*>(jlong_to_ptr(data));
     ASSERT(target);
-    const uint8_t* address =
-            static_cast<const uint8_t*>(env->GetDirectBufferAddress(byteBuffer));
-    Ref<FragmentedSharedBuffer> tmp_buf = FragmentedSharedBuffer::create(address,remaining);
-    target->didReceiveData(tmp_buf->makeContiguous().ptr() + position, remaining);
-    //target->didReceiveData((SharedBuffer*)(address) + position, remaining);
+
+    // The segment becomes a DataSegment of its own. Resource buffers append
+    // it by reference, so the bytes written by Java are never copied again.
+    auto segment = adoptMallocPtr<uint8_t, FastMalloc>(
+            static_cast<uint8_t*>(env->GetDirectBufferAddress(byteBuffer)));
+    Ref<SharedBuffer> buffer = SharedBuffer::create(DataSegment::Provider {
+        [segment = WTFMove(segment), position] { return segment.get() + position; },
+        [remaining] { return static_cast<size_t>(remaining); }
+    });
+    target->didReceiveData(buffer.get());
 }
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidFinishLoading
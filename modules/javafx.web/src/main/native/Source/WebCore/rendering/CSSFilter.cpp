@@ -49,7 +49,7 @@ RefPtr<CSSFilter> CSSFilter::create(RenderElement& renderer, const FilterOperati
 
     auto filter = adoptRef(*new CSSFilter(filterScale, hasFilterThatMovesPixels, hasFilterThatShouldBeRestrictedBySecurityOrigin));
 
-    if (!filter->buildFilterFunctions(renderer, operations, preferredFilterRenderingModes, targetBoundingBox, destinationContext)) {
+    if (!filter->buildFilterFunctions(&renderer, operations, preferredFilterRenderingModes, targetBoundingBox, &destinationContext)) {
         LOG_WITH_STREAM(Filters, stream << "CSSFilter::create: failed to build filters " << operations);
         return nullptr;
     }
@@ -61,6 +61,21 @@ RefPtr<CSSFilter> CSSFilter::create(RenderElement& renderer, const FilterOperati
     return filter;
 }
 
+RefPtr<CSSFilter> CSSFilter::create(const FilterOperations& operations, OptionSet<FilterRenderingMode> preferredFilterRenderingModes, const FloatSize& filterScale, const FloatRect& filterRegion)
+{
+    bool hasFilterThatMovesPixels = operations.hasFilterThatMovesPixels();
+    bool hasFilterThatShouldBeRestrictedBySecurityOrigin = operations.hasFilterThatShouldBeRestrictedBySecurityOrigin();
+
+    auto filter = adoptRef(*new CSSFilter(filterScale, hasFilterThatMovesPixels, hasFilterThatShouldBeRestrictedBySecurityOrigin));
+
+    if (!filter->buildFilterFunctions(nullptr, operations, preferredFilterRenderingModes, filterRegion, nullptr))
+        return nullptr;
+
+    filter->setFilterRenderingModes(preferredFilterRenderingModes);
+    filter->setFilterRegion(filterRegion);
+    return filter;
+}
+
 Ref<CSSFilter> CSSFilter::create(Vector<Ref<FilterFunction>>&& functions)
 {
     return adoptRef(*new CSSFilter(WTFMove(functions)));
@@ -236,7 +251,7 @@ static RefPtr<SVGFilter> createReferenceFilter(CSSFilter& filter, const Referenc
     return SVGFilter::create(*filterElement, preferredFilterRenderingModes, filter.filterScale(), filterRegion, targetBoundingBox, destinationContext);
 }
 
-bool CSSFilter::buildFilterFunctions(RenderElement& renderer, const FilterOperations& operations, OptionSet<FilterRenderingMode> preferredFilterRenderingModes, const FloatRect& targetBoundingBox, const GraphicsContext& destinationContext)
+bool CSSFilter::buildFilterFunctions(RenderElement* renderer, const FilterOperations& operations, OptionSet<FilterRenderingMode> preferredFilterRenderingModes, const FloatRect& targetBoundingBox, const GraphicsContext* destinationContext)
 {
     RefPtr<FilterFunction> function;
 
@@ -287,7 +302,11 @@ bool CSSFilter::buildFilterFunctions(RenderElement& renderer, const FilterOperat
             break;
 
         case FilterOperation::Type::Reference:
-            function = createReferenceFilter(*this, uncheckedDowncast<ReferenceFilterOperation>(*operation), renderer, preferredFilterRenderingModes, targetBoundingBox, destinationContext);
+            // SVG reference filters are resolved against the renderer's tree scope.
+            if (renderer && destinationContext)
+                function = createReferenceFilter(*this, uncheckedDowncast<ReferenceFilterOperation>(*operation), *renderer, preferredFilterRenderingModes, targetBoundingBox, *destinationContext);
+            else
+                function = nullptr;
             break;
 
         default:
@@ -131,6 +131,7 @@ list(APPEND WebKitLegacy_SOURCES
     java/WebCoreSupport/ChromeClientJava.cpp
     java/WebCoreSupport/BackForwardList.cpp
     java/WebCoreSupport/PageCacheJava.cpp
+    java/WebCoreSupport/MemoryManagerJava.cpp
 
     java/storage/WebDatabaseProviderJava.cpp
 )
@@ -49,11 +49,11 @@ Ref<InProcessIDBServer> InProcessIDBServer::create(PAL::SessionID sessionID)
     return adoptRef(*new InProcessIDBServer(sessionID));
 }
 
-Ref<InProcessIDBServer> InProcessIDBServer::create(PAL::SessionID sessionID, const String& databaseDirectoryPath)
+Ref<InProcessIDBServer> InProcessIDBServer::create(PAL::SessionID sessionID, const String& databaseDirectoryPath, std::optional<uint64_t> perOriginQuota)
 {
     ASSERT(!sessionID.isEphemeral());
 
-    return adoptRef(*new InProcessIDBServer(sessionID, databaseDirectoryPath));
+    return adoptRef(*new InProcessIDBServer(sessionID, databaseDirectoryPath, perOriginQuota));
 }
 
 InProcessIDBServer::~InProcessIDBServer()
@@ -70,17 +70,21 @@ InProcessIDBServer::~InProcessIDBServer()
     semaphore.wait();
 }
 
-InProcessIDBServer::InProcessIDBServer(PAL::SessionID sessionID, const String& databaseDirectoryPath)
+InProcessIDBServer::InProcessIDBServer(PAL::SessionID sessionID, const String& databaseDirectoryPath, std::optional<uint64_t> perOriginQuota)
     : m_queue(WorkQueue::create("com.apple.WebKit.IndexedDBServer"))
 {
     ASSERT(isMainThread());
     m_connectionToServer = IDBClient::IDBConnectionToServer::create(*this);
-    dispatchTask([this, protectedThis = Ref { *this }, directory = databaseDirectoryPath.isolatedCopy()] () mutable {
+    dispatchTask([this, protectedThis = Ref { *this }, directory = databaseDirectoryPath.isolatedCopy(), perOriginQuota] () mutable {
         m_connectionToClient = IDBServer::IDBConnectionToClient::create(*this);
 
         Locker locker { m_serverLock };
-        m_server = makeUnique<IDBServer::IDBServer>(directory, [](const ClientOrigin&, uint64_t) {
-            return true;
+        m_server = makeUnique<IDBServer::IDBServer>(directory, [directory, perOriginQuota](const ClientOrigin& origin, uint64_t spaceRequested) {
+            // Requests are made on the server queue, so the on-disk usage can be
+            // measured directly. Reads and deletions request no space.
+            if (!perOriginQuota || directory.isEmpty() || !spaceRequested)
+                return true;
+            return IDBServer::IDBServer::diskUsage(directory, origin) + spaceRequested <= *perOriginQuota;
         }, m_serverLock);
         m_server->registerConnection(*m_connectionToClient);
     });
@@ -56,7 +56,7 @@ class InProcessIDBServer final : public WebCore::IDBClient::IDBConnectionToServe
 public:
 
     static Ref<InProcessIDBServer> create(PAL::SessionID);
-    static Ref<InProcessIDBServer> create(PAL::SessionID, const String& databaseDirectoryPath);
+    static Ref<InProcessIDBServer> create(PAL::SessionID, const String& databaseDirectoryPath, std::optional<uint64_t> perOriginQuota = std::nullopt);
 
     virtual ~InProcessIDBServer();
 
@@ -124,7 +124,7 @@ public:
     void dispatchTaskReply(Function<void()>&&);
 
 private:
-    InProcessIDBServer(PAL::SessionID, const String& databaseDirectoryPath = nullString());
+    InProcessIDBServer(PAL::SessionID, const String& databaseDirectoryPath = nullString(), std::optional<uint64_t> perOriginQuota = std::nullopt);
 
     Lock m_serverLock;
     std::unique_ptr<WebCore::IDBServer::IDBServer> m_server;
@@ -44,8 +44,16 @@ WebDatabaseProvider::~WebDatabaseProvider()
 
 WebCore::IDBClient::IDBConnectionToServer& WebDatabaseProvider::idbConnectionToServerForSession(PAL::SessionID sessionID)
 {
-    return m_idbServerMap.ensure(sessionID, [&sessionID] {
-        return sessionID.isEphemeral() ? InProcessIDBServer::create(sessionID) : InProcessIDBServer::create(sessionID, indexedDatabaseDirectoryPath());
+#if PLATFORM(JAVA)
+    // Every page has its own provider. Pages without a directory share the
+    // in-memory servers of the singleton, the others a server per directory.
+    if (!sessionID.isEphemeral() && !m_indexedDatabaseDirectoryPath.isEmpty())
+        return persistentIDBServer(sessionID).connectionToServer();
+    if (this != &singleton())
+        return singleton().idbConnectionToServerForSession(sessionID);
+#endif
+    return m_idbServerMap.ensure(sessionID, [&] {
+        return sessionID.isEphemeral() ? InProcessIDBServer::create(sessionID) : InProcessIDBServer::create(sessionID, indexedDatabaseDirectoryPath(), indexedDatabasePerOriginQuota());
     }).iterator->value->connectionToServer();
 }
 
@@ -41,10 +41,26 @@ public:
 
     void deleteAllDatabases();
 
+#if PLATFORM(JAVA)
+    static Ref<WebDatabaseProvider> create();
+    void setIndexedDatabaseDirectoryPath(const String&, std::optional<uint64_t> perOriginQuota);
+#endif
+
 private:
     explicit WebDatabaseProvider();
 
+#if PLATFORM(JAVA)
+    String indexedDatabaseDirectoryPath() const { return m_indexedDatabaseDirectoryPath; }
+    std::optional<uint64_t> indexedDatabasePerOriginQuota() const { return m_indexedDatabasePerOriginQuota; }
+    InProcessIDBServer& persistentIDBServer(PAL::SessionID);
+#else
     static String indexedDatabaseDirectoryPath();
+    static std::optional<uint64_t> indexedDatabasePerOriginQuota();
+#endif
 
     HashMap<PAL::SessionID, RefPtr<InProcessIDBServer>> m_idbServerMap;
+#if PLATFORM(JAVA)
+    String m_indexedDatabaseDirectoryPath;
+    std::optional<uint64_t> m_indexedDatabasePerOriginQuota;
+#endif
 };
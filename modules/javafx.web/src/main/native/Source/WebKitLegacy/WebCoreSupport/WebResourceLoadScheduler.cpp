@@ -41,6 +41,10 @@
 #include <wtf/URL.h>
 #include <wtf/text/CString.h>
 
+#if PLATFORM(JAVA)
+#include <WebCore/DNSResolveQueueJava.h>
+#endif
+
 #if PLATFORM(IOS_FAMILY)
 #include <WebCore/RuntimeApplicationChecks.h>
 #endif
@@ -409,7 +413,13 @@ void WebResourceLoadScheduler::addOnlineStateChangeListener(WTF::Function<void(b
     NetworkStateNotifier::singleton().addListener(WTFMove(listener));
 }
 
-void WebResourceLoadScheduler::preconnectTo(FrameLoader&, const URL&, StoredCredentialsPolicy, ShouldPreconnectAsFirstParty, PreconnectCompletionHandler&&)
+void WebResourceLoadScheduler::preconnectTo(FrameLoader&, const URL& url, StoredCredentialsPolicy, ShouldPreconnectAsFirstParty, PreconnectCompletionHandler&& completionHandler)
 {
+#if PLATFORM(JAVA)
+    static_cast<DNSResolveQueueJava&>(DNSResolveQueue::singleton()).preconnect(url, WTFMove(completionHandler));
+#else
+    UNUSED_PARAM(url);
+    UNUSED_PARAM(completionHandler);
+#endif
 }
 
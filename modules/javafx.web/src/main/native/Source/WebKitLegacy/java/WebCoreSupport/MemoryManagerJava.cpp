@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+#include <WebCore/MemoryCache.h>
+#include <WebCore/MemoryRelease.h>
+#include <WebCore/PlatformJavaClasses.h>
+#include <WebCore/Timer.h>
+#include <wtf/MemoryFootprint.h>
+#include <wtf/MemoryPressureHandler.h>
+#include <wtf/MonotonicTime.h>
+#include <wtf/NeverDestroyed.h>
+#include "com_sun_webkit_MemoryManager.h"
+
+namespace WebCore {
+
+namespace MemoryManagerJava {
+
+// Mirrors com.sun.webkit.MemoryManager.PURGE_*
+enum PurgeLevel {
+    PurgeCaches = com_sun_webkit_MemoryManager_PURGE_CACHES,
+    PurgeDecodedData = com_sun_webkit_MemoryManager_PURGE_DECODED_DATA,
+    PurgeAll = com_sun_webkit_MemoryManager_PURGE_ALL,
+};
+
+// The periodic monitor of MemoryPressureHandler runs on RunLoop timers,
+// which the Java port does not drive, so the memory limit is enforced
+// by polling the footprint on a WebCore timer instead.
+class MemoryLimit {
+public:
+    static MemoryLimit& singleton()
+    {
+        static NeverDestroyed<MemoryLimit> memoryLimit;
+        return memoryLimit;
+    }
+
+    MemoryLimit()
+    {
+        MemoryPressureHandler::singleton().setLowMemoryHandler([](Critical critical, Synchronous synchronous) {
+            releaseMemory(critical, synchronous);
+        });
+    }
+
+    size_t limit() const { return m_limit; }
+
+    void setLimit(size_t limit)
+    {
+        m_limit = limit;
+        resetBackoff();
+        if (!m_limit) {
+            m_timer.stop();
+            MemoryPressureHandler::singleton().setMemoryPressureStatus(WTF::SystemMemoryPressureStatus::Normal);
+            return;
+        }
+        check();
+        m_timer.startRepeating(pollInterval);
+    }
+
+private:
+    static constexpr Seconds pollInterval { 5_s };
+    static constexpr Seconds maxPurgeInterval { 5_min };
+    static constexpr double warningFraction { 0.8 };
+    // Smallest drop of the footprint, as a fraction of the limit, for
+    // a purge to count as having released anything
+    static constexpr double reliefFraction { 0.01 };
+
+    void resetBackoff()
+    {
+        m_purgeInterval = pollInterval;
+        m_nextPurgeTime = { };
+        m_footprintAtLastPurge = 0;
+    }
+
+    void check()
+    {
+        size_t footprint = memoryFootprint();
+        auto& handler = MemoryPressureHandler::singleton();
+        if (footprint < m_limit * warningFraction) {
+            handler.setMemoryPressureStatus(WTF::SystemMemoryPressureStatus::Normal);
+            resetBackoff();
+            return;
+        }
+
+        bool critical = footprint >= m_limit;
+        // Also keeps BackForwardCache from accepting new pages
+        handler.setMemoryPressureStatus(critical ? WTF::SystemMemoryPressureStatus::Critical : WTF::SystemMemoryPressureStatus::Warning);
+
+        auto now = MonotonicTime::now();
+        if (now < m_nextPurgeTime)
+            return;
+
+        // The footprint covers the whole process, Java heap included, so
+        // it can stay over the limit whatever WebKit releases. Purge less
+        // and less often while purging does not bring it down.
+        if (m_footprintAtLastPurge && footprint + m_limit * reliefFraction > m_footprintAtLastPurge)
+            m_purgeInterval = std::min(m_purgeInterval * 2, maxPurgeInterval);
+        else
+            m_purgeInterval = pollInterval;
+
+        handler.releaseMemory(critical ? Critical::Yes : Critical::No, Synchronous::No);
+        m_footprintAtLastPurge = footprint;
+        m_nextPurgeTime = now + m_purgeInterval;
+    }
+
+    size_t m_limit { 0 };
+    Seconds m_purgeInterval { pollInterval };
+    MonotonicTime m_nextPurgeTime;
+    size_t m_footprintAtLastPurge { 0 };
+    Timer m_timer { *this, &MemoryLimit::check };
+};
+
+} // namespace MemoryManagerJava
+
+} // namespace WebCore
+
+using namespace WebCore;
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_MemoryManager_twkGetMemoryFootprint
+  (JNIEnv *, jclass)
+{
+    return memoryFootprint();
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_MemoryManager_twkGetMemoryLimit
+  (JNIEnv *, jclass)
+{
+    return MemoryManagerJava::MemoryLimit::singleton().limit();
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_MemoryManager_twkSetMemoryLimit
+  (JNIEnv *, jclass, jlong limit)
+{
+    ASSERT(limit >= 0);
+    MemoryManagerJava::MemoryLimit::singleton().setLimit(limit);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_MemoryManager_twkSetCacheCapacities
+  (JNIEnv *, jclass, jint minDeadBytes, jint maxDeadBytes, jint totalBytes)
+{
+    ASSERT(minDeadBytes >= 0 && minDeadBytes <= maxDeadBytes && maxDeadBytes <= totalBytes);
+    MemoryCache::singleton().setCapacities(minDeadBytes, maxDeadBytes, totalBytes);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_MemoryManager_twkReleaseMemory
+  (JNIEnv *, jclass, jint level)
+{
+    using namespace MemoryManagerJava;
+
+    switch (level) {
+    case PurgeCaches:
+        releaseMemory(Critical::No, Synchronous::Yes);
+        break;
+    case PurgeDecodedData:
+        releaseMemory(Critical::Yes, Synchronous::Yes, MaintainBackForwardCache::Yes);
+        break;
+    case PurgeAll:
+        releaseMemory(Critical::Yes, Synchronous::Yes);
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
+
+}
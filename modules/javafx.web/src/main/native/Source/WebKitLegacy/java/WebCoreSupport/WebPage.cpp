@@ -136,6 +136,7 @@ namespace WebCore {
 
 WebPage::WebPage(std::unique_ptr<Page> page)
     : m_page(WTFMove(page))
+    , m_repaintTimer(*this, &WebPage::flushJavaRepaints)
 {
 #if ENABLE(NOTIFICATIONS) || ENABLE(LEGACY_NOTIFICATIONS)
     if(!NotificationController::from(m_page.get())) {
@@ -251,6 +252,7 @@ RefPtr<RQRef> WebPage::jRenderTheme()
 void WebPage::paint(jobject rq, jint x, jint y, jint w, jint h)
 {
     if (m_rootLayer) {
+        m_layerDamage.unite(IntRect(x, y, w, h));
         return;
     }
 
@@ -297,12 +299,42 @@ void WebPage::postPaint(jobject rq, jint x, jint y, jint w, jint h)
             m_syncLayers = false;
             syncLayers();
         }
-        renderCompositedLayers(gc, IntRect(x, y, w, h));
+
+        // Layer backing stores are retained between frames, so a frame that
+        // only advances animations recomposites the area the animated layers
+        // covered last frame and cover now, not the whole page.
+        IntRect clip(x, y, w, h);
+        TextureMapperLayer& rootTextureMapperLayer = downcast<GraphicsLayerTextureMapper>(*m_rootLayer).layer();
+        bool hasRunningAnimations = rootTextureMapperLayer.applyAnimationsRecursively(MonotonicTime::now());
+        // On the frame the last animation ends, the layers it moved are
+        // drawn in their final state and that area has to be included too.
+        IntRect animatedLayersRect = hasRunningAnimations || m_hadRunningAnimations
+            ? rootTextureMapperLayer.runningAnimationsBoundingRect(pageRect())
+            : IntRect();
+        m_hadRunningAnimations = hasRunningAnimations;
+
+        IntRect damage = m_layerDamage;
+        damage.unite(m_animatedLayersRect);
+        damage.unite(animatedLayersRect);
+        damage.intersect(clip);
+        m_layerDamage = IntRect();
+        m_animatedLayersRect = hasRunningAnimations ? animatedLayersRect : IntRect();
+
+        if (!damage.isEmpty()) {
+            renderCompositedLayers(gc, damage);
+        }
         if (m_page->settings().showDebugBorders()) {
-            drawDebugLed(gc, IntRect(x, y, w, h), SRGBA<uint8_t> { 0, 192, 0, 128 });
+            drawDebugLed(gc, clip, SRGBA<uint8_t> { 0, 192, 0, 128 });
         }
-        if (downcast<GraphicsLayerTextureMapper>(m_rootLayer.get())->layer().descendantsOrSelfHaveRunningAnimations()) {
-            requestJavaRepaint(pageRect());
+        if (hasRunningAnimations) {
+            // Schedules the next frame. An animation that is currently
+            // out of view still needs to tick, so ask for a minimal area.
+            requestJavaRepaint(animatedLayersRect.isEmpty()
+                    ? IntRect(clip.location(), IntSize(1, 1))
+                    : animatedLayersRect);
+        } else if (!clip.contains(animatedLayersRect)) {
+            // The final state lies partly outside of this paint
+            requestJavaRepaint(animatedLayersRect);
         }
     }
 
@@ -322,6 +354,10 @@ void WebPage::scroll(const IntSize& scrollDelta,
         return;
     }
 
+    // Java translates the rects that are dirty when the page is scrolled,
+    // so the ones invalidated before the scroll have to get there first.
+    flushJavaRepaints();
+
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(
@@ -352,21 +388,94 @@ void WebPage::repaint(const IntRect& rect)
 
 void WebPage::requestJavaRepaint(const IntRect& rect)
 {
+    static constexpr size_t maxPendingRepaints = 16;
+
+    if (rect.isEmpty()) {
+        return;
+    }
+
+    // Same merging as WebPage.addDirtyRect() on the Java side: covered
+    // rects are dropped, and two rects are replaced by their union when
+    // it is smaller than their total area.
+    auto area = [](const IntRect& r) {
+        return static_cast<uint64_t>(r.width()) * r.height();
+    };
+    IntRect toRepaint = rect;
+    for (size_t i = 0; i < m_pendingRepaints.size();) {
+        const IntRect& pending = m_pendingRepaints[i];
+        if (pending.contains(toRepaint)) {
+            return;
+        }
+        if (toRepaint.contains(pending)) {
+            m_pendingRepaints.remove(i);
+            continue;
+        }
+        IntRect united = unionRect(pending, toRepaint);
+        if (area(united) < area(pending) + area(toRepaint)) {
+            m_pendingRepaints.remove(i);
+            toRepaint = united;
+            continue;
+        }
+        ++i;
+    }
+
+    if (m_pendingRepaints.size() < maxPendingRepaints) {
+        m_pendingRepaints.append(toRepaint);
+    } else {
+        // Keep the list bounded by growing the rect that grows the least
+        size_t best = 0;
+        uint64_t bestGrowth = std::numeric_limits<uint64_t>::max();
+        for (size_t i = 0; i < m_pendingRepaints.size(); ++i) {
+            const IntRect& pending = m_pendingRepaints[i];
+            uint64_t growth = area(unionRect(pending, toRepaint)) - area(pending);
+            if (growth < bestGrowth) {
+                best = i;
+                bestGrowth = growth;
+            }
+        }
+        m_pendingRepaints[best].unite(toRepaint);
+    }
+
+    if (!m_repaintTimer.isActive()) {
+        m_repaintTimer.startOneShot(0_s);
+    }
+}
+
+void WebPage::flushJavaRepaints()
+{
+    m_repaintTimer.stop();
+    if (m_pendingRepaints.isEmpty()) {
+        return;
+    }
+
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(
             PG_GetWebPageClass(env),
             "fwkRepaint",
-            "(IIII)V");
+            "([I)V");
     ASSERT(mid);
 
+    Vector<jint> coords;
+    coords.reserveInitialCapacity(m_pendingRepaints.size() * 4);
+    for (const auto& rect : m_pendingRepaints) {
+        coords.append(rect.x());
+        coords.append(rect.y());
+        coords.append(rect.width());
+        coords.append(rect.height());
+    }
+    m_pendingRepaints.clear();
+
+    JLocalRef<jintArray> jcoords(env->NewIntArray(coords.size()));
+    if (WTF::CheckAndClearException(env)) { // OOME
+        return;
+    }
+    env->SetIntArrayRegion(jcoords, 0, coords.size(), coords.data());
+
     env->CallVoidMethod(
             jobjectFromPage(m_page.get()),
             mid,
-            rect.x(),
-            rect.y(),
-            rect.width(),
-            rect.height());
+            (jintArray)jcoords);
     WTF::CheckAndClearException(env);
 }
 
@@ -384,6 +493,9 @@ void WebPage::setRootChildLayer(GraphicsLayer* layer)
     } else {
         m_rootLayer = nullptr;
         m_textureMapper.reset();
+        m_layerDamage = IntRect();
+        m_animatedLayersRect = IntRect();
+        m_hadRunningAnimations = false;
     }
 }
 
@@ -418,6 +530,8 @@ void WebPage::syncLayers()
     if (!localFrame->contentRenderer() || !frameView)
         return;
 
+    // Layer contents or properties may change below
+    TextureMapperJava::invalidateCachedSurfaces();
     frameView->updateLayoutAndStyleIfNeededRecursive();
     // Updating layout might have taken us out of compositing mode
     if (m_rootLayer) {
@@ -445,7 +559,6 @@ void WebPage::renderCompositedLayers(GraphicsContext& context, const IntRect& cl
     TransformationMatrix matrix;
     m_textureMapper->beginPainting();
     m_textureMapper->beginClip(matrix, FloatRoundedRect(clip));
-    rootTextureMapperLayer.applyAnimationsRecursively(MonotonicTime::now());
     downcast<GraphicsLayerTextureMapper>(*m_rootLayer).updateBackingStoreIncludingSubLayers(*m_textureMapper);
     rootTextureMapperLayer.paint(*m_textureMapper);
     m_textureMapper->endClip();
@@ -462,6 +575,18 @@ void WebPage::notifyFlushRequired(const GraphicsLayer*)
     markForSync();
 }
 
+void WebPage::notifyContentsLayerNeedsDisplay(GraphicsLayer* layer)
+{
+    if (!m_rootLayer) {
+        return;
+    }
+    // Only the contents layer changed, e.g. a new video frame: the layer
+    // tree is up to date, so just recomposite the area the contents cover.
+    TextureMapperJava::invalidateCachedSurfaces();
+    TextureMapperLayer& textureMapperLayer = downcast<GraphicsLayerTextureMapper>(*layer).layer();
+    requestJavaRepaint(textureMapperLayer.contentsLayerBoundingRect(pageRect()));
+}
+
 void WebPage::paintContents(const GraphicsLayer*, GraphicsContext& context, const FloatRect& inClip, OptionSet<GraphicsLayerPaintBehavior>)
 {
     context.save();
@@ -860,16 +985,21 @@ namespace {
 bool s_useJIT;
 bool s_useDFGJIT;
 bool s_useCSS3D;
+unsigned s_jsHeapSize;
+bool s_dnsPrefetch;
 
 }  // namespace
 
 extern "C" {
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInitWebCore
-    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useCSS3D) {
+    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useCSS3D, jint compositingTileSize, jint jsHeapSize, jboolean dnsPrefetch) {
     s_useJIT = useJIT;
     s_useDFGJIT = useDFGJIT;
     s_useCSS3D = useCSS3D;
+    s_jsHeapSize = std::clamp(jsHeapSize, 0, 4095) * MB;
+    s_dnsPrefetch = dnsPrefetch;
+    TextureMapperJava::setTileSize(compositingTileSize);
 }
 
 JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
@@ -898,6 +1028,10 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
         JSC::Options::useJIT() = s_useJIT;
         // Enable DFG only if JIT is enabled.
         JSC::Options::useDFGJIT() = s_useJIT && s_useDFGJIT;
+        // The JavaScript heap grows and collects as if this much memory
+        // were installed, instead of the physical memory of the machine.
+        if (s_jsHeapSize)
+            JSC::Options::forceRAMSize() = s_jsHeapSize;
     });
 
     JLObject jlself(self, true);
@@ -912,7 +1046,7 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
     pc.editorClient = makeUniqueRef<EditorClientJava>(jlself);
     pc.dragClient = makeUnique<DragClientJava>(jlself);
     pc.inspectorClient = makeUnique<InspectorClientJava>(jlself);
-    pc.databaseProvider = &WebDatabaseProvider::singleton();
+    pc.databaseProvider = WebDatabaseProvider::create();
     pc.storageNamespaceProvider = adoptRef(new WebStorageNamespaceProviderJava());
     pc.visitedLinkStore = VisitedLinkStoreJava::create();
 
@@ -962,6 +1096,13 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInit
     page->setDeviceScaleFactor(devicePixelScale);
 
     settings.setLinkPrefetchEnabled(true);
+    settings.setDNSPrefetchingEnabled(s_dnsPrefetch);
+    // <link rel=preconnect> only resolves the host, like DNS prefetching
+    settings.setLinkPreconnectEnabled(s_dnsPrefetch);
+    // Pages hidden with WebPage.setVisible() align their DOM timers to
+    // a coarse interval and suspend their CSS animations.
+    settings.setHiddenPageDOMTimerThrottlingEnabled(true);
+    settings.setHiddenPageCSSAnimationSuspensionEnabled(true);
 
         Frame* mainFrame = (Frame*)&page->mainFrame();
     auto* frame = dynamicDowncast<LocalFrame>(mainFrame);
@@ -2371,6 +2512,19 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetEditable
     page->setEditable(jbool_to_bool(editable));
 }
 
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetVisible
+    (JNIEnv* env, jobject self, jlong pPage, jboolean visible)
+{
+    Page* page = WebPage::pageFromJLong(pPage);
+    ASSERT(page);
+    if (!page) {
+        return;
+    }
+    // Also suspends requestAnimationFrame callbacks and SVG animations
+    // while the page is hidden.
+    page->setIsVisible(jbool_to_bool(visible));
+}
+
 JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetHtml
     (JNIEnv* env, jobject self, jlong pFrame)
 {
@@ -2500,6 +2654,31 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetLocalStorageEnabled
     settings.setLocalStorageEnabled(jbool_to_bool(enabled));
 }
 
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetIndexedDatabasePath
+  (JNIEnv* env, jobject, jlong pPage, jstring path, jlong perOriginQuota)
+{
+    ASSERT(pPage);
+    Page* page = WebPage::pageFromJLong(pPage);
+    ASSERT(page);
+    static_cast<WebDatabaseProvider*>(
+      &page->databaseProvider())
+        ->setIndexedDatabaseDirectoryPath(String(env, path),
+            perOriginQuota > 0 ? std::optional<uint64_t>(perOriginQuota) : std::nullopt);
+    // Databases opened from now on go to the server of the new directory
+    page->clearIDBConnection();
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetDNSPrefetchEnabled
+  (JNIEnv*, jobject, jlong pPage, jboolean enabled)
+{
+    ASSERT(pPage);
+    Page* page = WebPage::pageFromJLong(pPage);
+    ASSERT(page);
+    Settings& settings = page->settings();
+    settings.setDNSPrefetchingEnabled(jbool_to_bool(enabled));
+    settings.setLinkPreconnectEnabled(jbool_to_bool(enabled));
+}
+
 JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkGetDeveloperExtrasEnabled
   (JNIEnv *, jobject, jlong pPage)
 {
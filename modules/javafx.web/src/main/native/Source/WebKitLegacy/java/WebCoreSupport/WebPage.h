@@ -31,6 +31,7 @@
 #include <WebCore/IntRect.h>
 #include <WebCore/PrintContext.h>
 #include <WebCore/ScrollTypes.h>
+#include <WebCore/Timer.h>
 #include <WebCore/HandleUserInputEventResult.h>
 
 #include "MediaPlayerPrivateJava.h"
@@ -106,6 +107,7 @@ public:
 
 private:
     void requestJavaRepaint(const IntRect&);
+    void flushJavaRepaints();
     void markForSync();
     void syncLayers();
     IntRect pageRect();
@@ -114,6 +116,7 @@ private:
     // GraphicsLayerClient
     void notifyAnimationStarted(const GraphicsLayer*, const String& /*animationKey*/, MonotonicTime /*time*/) override;
     void notifyFlushRequired(const GraphicsLayer*) override;
+    void notifyContentsLayerNeedsDisplay(GraphicsLayer*) override;
     void paintContents(const GraphicsLayer*, GraphicsContext&, const FloatRect& /* inClip */,  OptionSet<GraphicsLayerPaintBehavior>) override;
 
     bool keyEvent(const PlatformKeyboardEvent& event);
@@ -135,6 +138,18 @@ private:
     RefPtr<GraphicsLayer> m_rootLayer;
     std::unique_ptr<TextureMapper> m_textureMapper;
     bool m_syncLayers { false };
+    // The area that has to be composited in the next postPaint(): the rects
+    // repainted by Java plus where animated layers were drawn last time.
+    // Everything else is retained from the previous frame.
+    IntRect m_layerDamage;
+    IntRect m_animatedLayersRect;
+    bool m_hadRunningAnimations { false };
+
+    // Rects invalidated since the last flush. They are merged as they
+    // come in and sent to Java in a single call once the current task
+    // is done, instead of one JNI call per invalidation.
+    Vector<IntRect> m_pendingRepaints;
+    Timer m_repaintTimer;
 
     // Webkit expects keyPress events to be suppressed if the associated keyDown
     // event was handled. Safari implements this behavior by peeking out the
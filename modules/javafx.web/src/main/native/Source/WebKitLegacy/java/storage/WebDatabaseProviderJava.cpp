@@ -23,9 +23,42 @@
  * questions.
  */
 
+
 #include "WebDatabaseProvider.h"
 
-String WebDatabaseProvider::indexedDatabaseDirectoryPath()
+#include <pal/SessionID.h>
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+
+namespace {
+
+// The persistent servers by directory. Engines that apply the same user
+// data directory share a server, different directories never do.
+HashMap<String, RefPtr<InProcessIDBServer>>& persistentIDBServerMap()
+{
+    static NeverDestroyed<HashMap<String, RefPtr<InProcessIDBServer>>> map;
+    return map;
+}
+
+} // namespace
+
+Ref<WebDatabaseProvider> WebDatabaseProvider::create()
+{
+    return adoptRef(*new WebDatabaseProvider);
+}
+
+void WebDatabaseProvider::setIndexedDatabaseDirectoryPath(const String& path, std::optional<uint64_t> quota)
+{
+    ASSERT(isMainThread());
+    m_indexedDatabaseDirectoryPath = path;
+    m_indexedDatabasePerOriginQuota = quota;
+}
+
+InProcessIDBServer& WebDatabaseProvider::persistentIDBServer(PAL::SessionID sessionID)
 {
-    return ""_s;
+    ASSERT(isMainThread());
+    // The quota of the first page to open the directory applies to it.
+    return *persistentIDBServerMap().ensure(m_indexedDatabaseDirectoryPath, [&] {
+        return InProcessIDBServer::create(sessionID, m_indexedDatabaseDirectoryPath, m_indexedDatabasePerOriginQuota);
+    }).iterator->value;
 }
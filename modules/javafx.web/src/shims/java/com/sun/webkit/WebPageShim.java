@@ -43,6 +43,30 @@ public class WebPageShim {
         return page.test_getFramesCount();
     }
 
+    public static void setDNSPrefetchEnabled(WebPage page, boolean enabled) {
+        page.test_setDNSPrefetchEnabled(enabled);
+    }
+
+    public static void setPersistentIndexedDBEnabled(WebPage page, boolean enabled) {
+        page.test_setPersistentIndexedDBEnabled(enabled);
+    }
+
+    public static int getRepaintCount(WebPage page) {
+        return page.repaintCount;
+    }
+
+    public static int getRepaintRectCount(WebPage page) {
+        return page.repaintRectCount;
+    }
+
+    public static int[] getLastRepaintRects(WebPage page) {
+        return page.lastRepaintRects;
+    }
+
+    public static int getRepaintCountAtScroll(WebPage page) {
+        return page.repaintCountAtScroll;
+    }
+
     private static WCGraphicsContext setupPageWithGraphics(WebPage page, int x, int y, int w, int h) {
         page.setBounds(x, y, w, h);
         // forces layout and renders the page into RenderQueue.
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.sun.webkit.network;
+
+import java.nio.ByteBuffer;
+
+public class ByteBufferPoolShim {
+
+    private final ByteBufferPool pool;
+
+    private ByteBufferPoolShim(ByteBufferPool pool) {
+        this.pool = pool;
+    }
+
+    public static ByteBufferPoolShim newInstance(int bufferSize) {
+        return new ByteBufferPoolShim(ByteBufferPool.newInstance(bufferSize));
+    }
+
+    public Allocator newAllocator(int maxBufferCount) {
+        return new Allocator(pool.newAllocator(maxBufferCount));
+    }
+
+    public Allocator newSegmentAllocator(int maxBufferCount) {
+        return new Allocator(pool.newSegmentAllocator(maxBufferCount));
+    }
+
+    /**
+     * Frees a segment that has been handed over, as WebCore would.
+     */
+    public static void freeSegment(ByteBuffer byteBuffer) {
+        URLLoaderBase.twkReleaseSegment(byteBuffer);
+    }
+
+    public static class Allocator {
+
+        private final ByteBufferAllocator allocator;
+
+        private Allocator(ByteBufferAllocator allocator) {
+            this.allocator = allocator;
+        }
+
+        public ByteBuffer allocate() throws InterruptedException {
+            return allocator.allocate();
+        }
+
+        public void release(ByteBuffer byteBuffer) {
+            allocator.release(byteBuffer);
+        }
+
+        public void handOver(ByteBuffer byteBuffer) {
+            allocator.handOver(byteBuffer);
+        }
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,19 +23,32 @@
  * questions.
  */
 
-package com.sun.javafx.font.freetype;
+package com.sun.webkit.network;
 
-class PangoGlyphString {
-    /* Fields from PangoItem */
-    int offset;
-    int length;
-    int num_chars;
-    /* pangoItem->analysis->font*/
-    long font;
-    int num_glyphs;
-    /* PangoGlyphInfo->glyph */
-    int[] glyphs;
-    /* PangoGlyphInfo->PangoGlyphGeometry->width */
-    int[] widths;
-    int[] log_clusters;
+import java.net.InetAddress;
+import java.net.UnknownHostException;
+import java.util.function.Function;
+
+public class NetworkContextShim {
+
+    private static final NetworkContext.Resolver systemResolver = NetworkContext.resolver;
+
+    /**
+     * Resolves host names for DNS prefetch and preconnect with the given
+     * function, which returns null for unknown hosts. Null restores the
+     * system resolver.
+     */
+    public static void setResolver(Function<String, InetAddress[]> resolver) {
+        if (resolver == null) {
+            NetworkContext.resolver = systemResolver;
+            return;
+        }
+        NetworkContext.resolver = host -> {
+            InetAddress[] addresses = resolver.apply(host);
+            if (addresses == null) {
+                throw new UnknownHostException(host);
+            }
+            return addresses;
+        };
+    }
 }
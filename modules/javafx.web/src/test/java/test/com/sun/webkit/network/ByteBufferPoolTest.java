@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.webkit.network;
+
+import com.sun.javafx.PlatformUtil;
+import com.sun.javafx.tk.Toolkit;
+import com.sun.webkit.WebPage;
+import com.sun.webkit.network.ByteBufferPoolShim;
+import java.nio.ByteBuffer;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.TimeUnit;
+import org.junit.BeforeClass;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+public class ByteBufferPoolTest {
+
+    private static final int BUFFER_SIZE = 1024;
+    private static final int MAX_BUFFER_COUNT = 2;
+
+
+    @BeforeClass
+    public static void beforeClass() throws ClassNotFoundException {
+        if (PlatformUtil.isWindows()) {
+            // Must load Microsoft libs before loading jfxwebkit.dll
+            Toolkit.loadMSWindowsLibraries();
+        }
+        // Segments are allocated by jfxwebkit
+        Class.forName(WebPage.class.getName());
+    }
+
+
+    /**
+     * Allocates a buffer on another thread, which blocks while the
+     * allocator has no buffer left.
+     */
+    private static BlockingQueue<ByteBuffer> allocateLater(
+            ByteBufferPoolShim.Allocator allocator)
+    {
+        BlockingQueue<ByteBuffer> result = new ArrayBlockingQueue<>(1);
+        Thread thread = new Thread(() -> {
+            try {
+                result.add(allocator.allocate());
+            } catch (InterruptedException e) {
+            }
+        });
+        thread.setDaemon(true);
+        thread.start();
+        return result;
+    }
+
+    private static void assertBlocked(BlockingQueue<ByteBuffer> result)
+            throws InterruptedException
+    {
+        assertNull(result.poll(100, TimeUnit.MILLISECONDS));
+    }
+
+    private static ByteBuffer assertUnblocked(BlockingQueue<ByteBuffer> result)
+            throws InterruptedException
+    {
+        ByteBuffer byteBuffer = result.poll(5, TimeUnit.SECONDS);
+        assertNotNull(byteBuffer);
+        return byteBuffer;
+    }
+
+    private static void checkBuffer(ByteBuffer byteBuffer) {
+        assertNotNull(byteBuffer);
+        assertTrue(byteBuffer.isDirect());
+        assertEquals(BUFFER_SIZE, byteBuffer.capacity());
+        assertEquals(0, byteBuffer.position());
+        assertEquals(BUFFER_SIZE, byteBuffer.limit());
+    }
+
+    @Test
+    public void testReleaseRecyclesBuffer() throws Exception {
+        ByteBufferPoolShim pool = ByteBufferPoolShim.newInstance(BUFFER_SIZE);
+        ByteBufferPoolShim.Allocator allocator = pool.newAllocator(MAX_BUFFER_COUNT);
+
+        ByteBuffer b1 = allocator.allocate();
+        checkBuffer(b1);
+        b1.put((byte) 1).flip();
+        allocator.release(b1);
+
+        // Cleared and shared by all the allocators of the pool
+        ByteBuffer b2 = pool.newAllocator(MAX_BUFFER_COUNT).allocate();
+        assertSame(b1, b2);
+        checkBuffer(b2);
+    }
+
+    @Test
+    public void testHandOverRecyclesBuffer() throws Exception {
+        ByteBufferPoolShim.Allocator allocator =
+                ByteBufferPoolShim.newInstance(BUFFER_SIZE).newAllocator(1);
+
+        ByteBuffer b1 = allocator.allocate();
+        b1.put((byte) 1);
+        BlockingQueue<ByteBuffer> pending = allocateLater(allocator);
+        assertBlocked(pending);
+
+        // The contents were copied, the buffer goes back to the pool
+        allocator.handOver(b1);
+        ByteBuffer b2 = assertUnblocked(pending);
+        assertSame(b1, b2);
+        checkBuffer(b2);
+    }
+
+    @Test
+    public void testAllocatorLimit() throws Exception {
+        ByteBufferPoolShim.Allocator allocator =
+                ByteBufferPoolShim.newInstance(BUFFER_SIZE).newAllocator(MAX_BUFFER_COUNT);
+
+        ByteBuffer b1 = allocator.allocate();
+        ByteBuffer b2 = allocator.allocate();
+        assertNotSame(b1, b2);
+        BlockingQueue<ByteBuffer> pending = allocateLater(allocator);
+        assertBlocked(pending);
+
+        allocator.release(b2);
+        assertSame(b2, assertUnblocked(pending));
+    }
+
+    @Test
+    public void testSegmentAllocate() throws Exception {
+        ByteBufferPoolShim.Allocator allocator =
+                ByteBufferPoolShim.newInstance(BUFFER_SIZE).newSegmentAllocator(MAX_BUFFER_COUNT);
+
+        ByteBuffer s1 = allocator.allocate();
+        ByteBuffer s2 = allocator.allocate();
+        checkBuffer(s1);
+        checkBuffer(s2);
+        assertNotSame(s1, s2);
+
+        // Segments are writable native memory
+        for (int i = 0; i < BUFFER_SIZE; i++) {
+            s1.put((byte) i);
+        }
+        s1.flip();
+        for (int i = 0; i < BUFFER_SIZE; i++) {
+            assertEquals((byte) i, s1.get(i));
+        }
+
+        allocator.release(s1);
+        allocator.release(s2);
+    }
+
+    @Test
+    public void testSegmentRelease() throws Exception {
+        ByteBufferPoolShim.Allocator allocator =
+                ByteBufferPoolShim.newInstance(BUFFER_SIZE).newSegmentAllocator(1);
+
+        ByteBuffer s1 = allocator.allocate();
+        BlockingQueue<ByteBuffer> pending = allocateLater(allocator);
+        assertBlocked(pending);
+
+        // A released segment is freed, never recycled
+        allocator.release(s1);
+        ByteBuffer s2 = assertUnblocked(pending);
+        assertNotSame(s1, s2);
+        checkBuffer(s2);
+        allocator.release(s2);
+    }
+
+    @Test
+    public void testSegmentHandOver() throws Exception {
+        ByteBufferPoolShim.Allocator allocator =
+                ByteBufferPoolShim.newInstance(BUFFER_SIZE).newSegmentAllocator(1);
+
+        ByteBuffer s1 = allocator.allocate();
+        s1.put((byte) 42).flip();
+        BlockingQueue<ByteBuffer> pending = allocateLater(allocator);
+        assertBlocked(pending);
+
+        // A handed over segment no longer counts against the limit, but
+        // it is not freed either: its memory now belongs to WebCore.
+        allocator.handOver(s1);
+        ByteBuffer s2 = assertUnblocked(pending);
+        assertNotSame(s1, s2);
+        assertEquals(42, s1.get(0));
+
+        ByteBufferPoolShim.freeSegment(s1);
+        allocator.release(s2);
+    }
+}
@@ -105,6 +105,23 @@ public class CookieManagerTest {
         assertEquals("", get("http://example.org/"));
     }
 
+    /**
+     * Tests what happens if cookies expire in a domain other than
+     * the one being queried.
+     */
+    @Test
+    public void testGetExpiredCookiesInOtherDomain() {
+        put("http://example.org/", "foo=bar; Max-Age=1");
+        put("http://example.com/", "baz=qux", "quux=corge; Max-Age=2");
+        assertEquals("foo=bar", get("http://example.org/"));
+        sleep(1200);
+        assertEquals("baz=qux; quux=corge", get("http://example.com/"));
+        put("http://example.org/", "grault=garply");
+        assertEquals("grault=garply", get("http://example.org/"));
+        sleep(1000);
+        assertEquals("baz=qux", get("http://example.com/"));
+    }
+
     /**
      * Tests what happens if get() encounters domain mismatch.
      */
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.webkit.WebPage;
+import com.sun.webkit.WebPageShim;
+import java.awt.Color;
+import java.awt.image.BufferedImage;
+import javafx.scene.web.WebEngineShim;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * The tiles of composited layers with filters or masks are kept between
+ * frames. Painting again without a change draws the kept tiles, a change
+ * to the layer paints them anew.
+ */
+public class CompositedLayerTest extends TestBase {
+
+    private static final Color YELLOW = new Color(255, 255, 0);
+    private static final Color CYAN = new Color(0, 255, 255);
+
+    private static final String FILTERED =
+            "<html><body style='margin: 0px; background-color: #fff;'>" +
+            "<div id='layer' style='will-change: transform; filter: invert(1);" +
+            " width: 200px; height: 200px; background-color: #00f;'></div>" +
+            "</body></html>";
+
+    private static final String MASKED =
+            "<html><body style='margin: 0px; background-color: #fff;'>" +
+            "<div id='layer' style='will-change: transform;" +
+            " -webkit-mask-image: linear-gradient(#000 50%, transparent 50%);" +
+            " width: 200px; height: 200px; background-color: #00f;'></div>" +
+            "</body></html>";
+
+    @Before
+    public void enableCompositing() {
+        submit(() -> {
+            WebEngineShim.getPage(getEngine())
+                    .overridePreference("WebKitAcceleratedCompositingEnabled", "1");
+        });
+    }
+
+    private BufferedImage paint() {
+        return submit(() -> {
+            final WebPage webPage = WebEngineShim.getPage(getEngine());
+            assertNotNull(webPage);
+            final BufferedImage img = WebPageShim.paint(webPage, 0, 0, 800, 600);
+            assertNotNull(img);
+            return img;
+        });
+    }
+
+    private static void checkColor(BufferedImage img, int x, int y, Color expected) {
+        final Color actual = new Color(img.getRGB(x, y), true);
+        assertTrue("Color at " + x + "," + y + " should be " + expected + ": " + actual,
+                isColorsSimilar(expected, actual, 1));
+    }
+
+    @Test public void testFilteredLayerRepaint() {
+        loadContent(FILTERED);
+        for (int i = 0; i < 3; i++) {
+            final BufferedImage img = paint();
+            checkColor(img, 100, 100, YELLOW);
+            checkColor(img, 400, 400, Color.WHITE);
+        }
+    }
+
+    @Test public void testFilteredLayerContentsChange() {
+        loadContent(FILTERED);
+        checkColor(paint(), 100, 100, YELLOW);
+
+        executeScript("document.getElementById('layer').style.backgroundColor = '#f00'");
+        BufferedImage img = paint();
+        checkColor(img, 100, 100, CYAN);
+        checkColor(img, 400, 400, Color.WHITE);
+        checkColor(paint(), 100, 100, CYAN);
+    }
+
+    @Test public void testFilteredLayerFilterChange() {
+        loadContent(FILTERED);
+        checkColor(paint(), 100, 100, YELLOW);
+
+        executeScript("document.getElementById('layer').style.filter = 'none'");
+        checkColor(paint(), 100, 100, Color.BLUE);
+
+        executeScript("document.getElementById('layer').style.filter = 'invert(1)'");
+        checkColor(paint(), 100, 100, YELLOW);
+    }
+
+    @Test public void testFilteredLayerMove() {
+        loadContent(FILTERED);
+        checkColor(paint(), 100, 100, YELLOW);
+
+        executeScript("document.getElementById('layer').style.transform = 'translateX(300px)'");
+        final BufferedImage img = paint();
+        checkColor(img, 100, 100, Color.WHITE);
+        checkColor(img, 400, 100, YELLOW);
+    }
+
+    @Test public void testMaskedLayerRepaint() {
+        loadContent(MASKED);
+        for (int i = 0; i < 3; i++) {
+            final BufferedImage img = paint();
+            checkColor(img, 100, 50, Color.BLUE);
+            checkColor(img, 100, 150, Color.WHITE);
+        }
+
+        executeScript("document.getElementById('layer').style.backgroundColor = '#000'");
+        final BufferedImage img = paint();
+        checkColor(img, 100, 50, Color.BLACK);
+        checkColor(img, 100, 150, Color.WHITE);
+    }
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.net.httpserver.HttpServer;
+import com.sun.webkit.network.CookieManager;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.CookieHandler;
+import java.net.InetSocketAddress;
+import java.net.URI;
+import java.nio.charset.StandardCharsets;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+
+/**
+ * Tests that cookie lookups cached by WebCore follow changes of the
+ * default cookie handler and of its cookies.
+ */
+public class CookieCacheTest extends TestBase {
+
+    private static final String PAGE = "<html><body>cookies</body></html>";
+
+    private HttpServer server;
+    private String url;
+    private CookieHandler savedHandler;
+
+    /**
+     * A cookie handler that does not report its changes.
+     */
+    private static final class FixedCookieHandler extends CookieHandler {
+        private volatile String cookie;
+
+        FixedCookieHandler(String cookie) {
+            this.cookie = cookie;
+        }
+
+        @Override
+        public Map<String, List<String>> get(URI uri, Map<String, List<String>> requestHeaders) {
+            return Collections.singletonMap("Cookie", Collections.singletonList(cookie));
+        }
+
+        @Override
+        public void put(URI uri, Map<String, List<String>> responseHeaders) {
+        }
+    }
+
+    @Before
+    public void setUp() throws IOException {
+        savedHandler = CookieHandler.getDefault();
+        server = HttpServer.create(new InetSocketAddress(0), 0);
+        server.createContext("/", exchange -> {
+            byte[] body = PAGE.getBytes(StandardCharsets.UTF_8);
+            exchange.getResponseHeaders().add("Content-Type", "text/html; charset=utf-8");
+            exchange.sendResponseHeaders(200, body.length);
+            try (OutputStream out = exchange.getResponseBody()) {
+                out.write(body);
+            }
+        });
+        server.start();
+        url = "http://localhost:" + server.getAddress().getPort() + "/";
+    }
+
+    @After
+    public void tearDown() {
+        CookieHandler.setDefault(savedHandler);
+        server.stop(0);
+    }
+
+    private static void setCookie(CookieManager manager, String url, String cookie) {
+        manager.put(URI.create(url),
+                Collections.singletonMap("Set-Cookie", Collections.singletonList(cookie)));
+    }
+
+    private String getCookie() {
+        return (String) executeScript("document.cookie");
+    }
+
+    @Test
+    public void testCookieManagerChanges() {
+        CookieManager manager = new CookieManager();
+        CookieHandler.setDefault(manager);
+        setCookie(manager, url, "a=1");
+        load(url);
+        assertEquals("a=1", getCookie());
+        assertEquals("a=1", getCookie());
+
+        // Changes to the store are seen without a new load
+        setCookie(manager, url, "b=2");
+        assertEquals("a=1; b=2", getCookie());
+
+        executeScript("document.cookie = 'c=3'");
+        assertEquals("a=1; b=2; c=3", getCookie());
+
+        setCookie(manager, url, "a=1; Max-Age=0");
+        assertEquals("b=2; c=3", getCookie());
+    }
+
+    @Test
+    public void testReplacedCookieManager() {
+        CookieManager manager1 = new CookieManager();
+        CookieHandler.setDefault(manager1);
+        setCookie(manager1, url, "a=1");
+        load(url);
+        assertEquals("a=1", getCookie());
+
+        // The next load notices the new handler and drops cached lookups
+        CookieManager manager2 = new CookieManager();
+        setCookie(manager2, url, "b=2");
+        CookieHandler.setDefault(manager2);
+        load(url);
+        assertEquals("b=2", getCookie());
+
+        // Only the current handler's changes are reported
+        setCookie(manager1, url, "c=3");
+        assertEquals("b=2", getCookie());
+        setCookie(manager2, url, "d=4");
+        assertEquals("b=2; d=4", getCookie());
+    }
+
+    @Test
+    public void testOtherCookieHandler() {
+        CookieManager manager = new CookieManager();
+        CookieHandler.setDefault(manager);
+        setCookie(manager, url, "a=1");
+        load(url);
+        assertEquals("a=1", getCookie());
+
+        FixedCookieHandler handler = new FixedCookieHandler("b=2");
+        CookieHandler.setDefault(handler);
+        load(url);
+        assertEquals("b=2", getCookie());
+
+        // Results of handlers that do not report changes are never cached
+        handler.cookie = "c=3";
+        assertEquals("c=3", getCookie());
+
+        // Going back to a cookie manager
+        CookieHandler.setDefault(manager);
+        load(url);
+        assertEquals("a=1", getCookie());
+        setCookie(manager, url, "d=4");
+        assertEquals("a=1; d=4", getCookie());
+    }
+}
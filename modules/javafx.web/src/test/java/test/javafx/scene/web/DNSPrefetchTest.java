@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import com.sun.webkit.WebPageShim;
+import com.sun.webkit.network.NetworkContextShim;
+import java.net.InetAddress;
+import java.net.UnknownHostException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import javafx.scene.web.WebEngineShim;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+public class DNSPrefetchTest extends TestBase {
+
+    private static final int TIMEOUT = 10000;
+
+    // Every host the resolver has been asked about, in order
+    private final List<String> lookups = Collections.synchronizedList(new ArrayList<>());
+
+    @Before
+    public void before() throws UnknownHostException {
+        // A local resolver that only knows these hosts, like a hosts file
+        InetAddress[] preconnect = {
+            InetAddress.getByAddress("preconnect.test", new byte[] { 127, 0, 0, 1 })
+        };
+        InetAddress[] prefetch = {
+            InetAddress.getByAddress("prefetch.test", new byte[] { 127, 0, 0, 2 }),
+            InetAddress.getByAddress("prefetch.test", new byte[] {
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 })
+        };
+        NetworkContextShim.setResolver(host -> {
+            lookups.add(host);
+            switch (host) {
+                case "preconnect.test": return preconnect;
+                case "prefetch.test": return prefetch;
+                default: return null;
+            }
+        });
+        submit(() -> WebPageShim.setDNSPrefetchEnabled(WebEngineShim.getPage(getEngine()), true));
+    }
+
+    @After
+    public void after() {
+        NetworkContextShim.setResolver(null);
+    }
+
+    private void loadLinks(String... links) {
+        StringBuilder html = new StringBuilder("<html><head>");
+        for (String link : links) {
+            html.append(link);
+        }
+        loadContent(html.append("</head><body>Hello</body></html>").toString());
+    }
+
+    // Waits for the host to be looked up, then a little longer so that
+    // a second lookup would be seen too
+    private int countLookups(String host) throws InterruptedException {
+        long deadline = System.currentTimeMillis() + TIMEOUT;
+        while (!lookups.contains(host) && System.currentTimeMillis() < deadline) {
+            Thread.sleep(20);
+        }
+        assertTrue("Timed out waiting for a lookup of " + host, lookups.contains(host));
+        Thread.sleep(500);
+        return Collections.frequency(lookups, host);
+    }
+
+    @Test
+    public void testPreconnectResolvesOnce() throws Exception {
+        loadLinks("<link rel='preconnect' href='http://preconnect.test/'>");
+        assertEquals(1, countLookups("preconnect.test"));
+        // The load itself is not affected
+        assertEquals("Hello", executeScript("document.body.textContent"));
+    }
+
+    @Test
+    public void testDNSPrefetch() throws Exception {
+        loadLinks("<link rel='dns-prefetch' href='http://prefetch.test/'>");
+        assertEquals(1, countLookups("prefetch.test"));
+    }
+
+    @Test
+    public void testUnknownHost() throws Exception {
+        loadLinks("<link rel='preconnect' href='http://unknown.test/'>",
+                  "<link rel='dns-prefetch' href='http://unknown-prefetch.test/'>");
+        assertEquals(1, countLookups("unknown.test"));
+        assertEquals(1, countLookups("unknown-prefetch.test"));
+        assertEquals("Hello", executeScript("document.body.textContent"));
+    }
+
+    @Test
+    public void testDisabled() throws Exception {
+        submit(() -> WebPageShim.setDNSPrefetchEnabled(WebEngineShim.getPage(getEngine()), false));
+        loadLinks("<link rel='preconnect' href='http://preconnect.test/'>",
+                  "<link rel='dns-prefetch' href='http://prefetch.test/'>");
+        Thread.sleep(500);
+        assertTrue("Unexpected lookups " + lookups, lookups.isEmpty());
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import org.junit.AfterClass;
+import org.junit.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import com.sun.webkit.WebPageShim;
+import javafx.concurrent.Worker;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebEngineShim;
+
+public class IndexedDBTest extends TestBase {
+
+    private static final File USER_DATA_DIR = new File("IndexedDBDir");
+    private static final File OTHER_USER_DATA_DIR = new File("IndexedDBOtherDir");
+    private static final File PAGE = new File("src/test/resources/test/html/indexeddb.html");
+    private static final int TIMEOUT = 30000;
+
+    private static void deleteRecursively(File file) throws IOException {
+        if (file.isDirectory()) {
+            for (File f : file.listFiles()) {
+                deleteRecursively(f);
+            }
+        }
+        if (!file.delete()) {
+            // If WebKit takes time to close the file, better
+            // delete it during VM shutdown.
+            file.deleteOnExit();
+        }
+    }
+
+    @AfterClass
+    public static void afterClass() throws IOException {
+        deleteRecursively(USER_DATA_DIR);
+        deleteRecursively(OTHER_USER_DATA_DIR);
+    }
+
+    private WebEngine createWebEngine(File userDataDir) {
+        WebEngine webEngine = submit(() -> {
+            WebEngine engine = new WebEngine();
+            // The user data directory is applied on the first load
+            WebPageShim.setPersistentIndexedDBEnabled(WebEngineShim.getPage(engine), true);
+            engine.setUserDataDirectory(userDataDir);
+            return engine;
+        });
+        final CountDownLatch latch = new CountDownLatch(1);
+        submit(() -> {
+            webEngine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+                if (n == Worker.State.SUCCEEDED) {
+                    latch.countDown();
+                }
+            });
+            webEngine.load(PAGE.toURI().toASCIIString());
+        });
+        try {
+            assertTrue("Timed out loading the page", latch.await(TIMEOUT, TimeUnit.MILLISECONDS));
+        } catch (InterruptedException ex) {
+            throw new AssertionError(ex);
+        }
+        return webEngine;
+    }
+
+    private String runRequest(WebEngine webEngine, String script) {
+        submit(() -> webEngine.executeScript("result = null; " + script));
+        long deadline = System.currentTimeMillis() + TIMEOUT;
+        while (System.currentTimeMillis() < deadline) {
+            Object result = submit(() -> webEngine.executeScript("result"));
+            if (result != null) {
+                return (String) result;
+            }
+            try {
+                Thread.sleep(50);
+            } catch (InterruptedException ex) {
+                throw new AssertionError(ex);
+            }
+        }
+        fail("Timed out waiting for " + script);
+        return null;
+    }
+
+    private static boolean containsFiles(File dir) {
+        File[] files = dir.listFiles();
+        if (files == null) {
+            return false;
+        }
+        for (File f : files) {
+            if (f.isFile() || containsFiles(f)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    @Test
+    public void testDataPersistsAcrossEngines() {
+        WebEngine first = createWebEngine(USER_DATA_DIR);
+        assertEquals("stored", runRequest(first, "put_value('persisted');"));
+        submit(() -> first.load("about:blank"));
+
+        // The databases are kept in SQLite files, not in memory
+        assertTrue(containsFiles(new File(USER_DATA_DIR, "indexeddb")));
+
+        WebEngine second = createWebEngine(USER_DATA_DIR);
+        assertEquals("persisted", runRequest(second, "get_value();"));
+    }
+
+    @Test
+    public void testDirectoriesAreIsolated() {
+        WebEngine first = createWebEngine(USER_DATA_DIR);
+        assertEquals("stored", runRequest(first, "put_value('first');"));
+
+        // Another user data directory gets its own IndexedDB server
+        WebEngine other = createWebEngine(OTHER_USER_DATA_DIR);
+        assertEquals("missing", runRequest(other, "get_value();"));
+        assertEquals("stored", runRequest(other, "put_value('other');"));
+        assertTrue(containsFiles(new File(OTHER_USER_DATA_DIR, "indexeddb")));
+
+        // Neither write shows up in the other directory
+        assertEquals("first", runRequest(first, "get_value();"));
+        assertEquals("other", runRequest(other, "get_value();"));
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.webkit.MemoryManager;
+import org.junit.After;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+public class MemoryManagerTest extends TestBase {
+
+    // The default capacities of WebCore's MemoryCache
+    private static final int DEFAULT_CACHE_CAPACITY = 8192 * 1024;
+
+    private static final String PAGE =
+            "<html><head><style>p { color: red; }</style></head>" +
+            "<body><p id='p'>Memory</p>" +
+            "<canvas id='c' width='100' height='100'></canvas>" +
+            "<script>var data = []; for (var i = 0; i < 1000; i++) data.push('x' + i);" +
+            "document.getElementById('c').getContext('2d').fillRect(0, 0, 50, 50);" +
+            "</script></body></html>";
+
+    @After
+    public void tearDown() {
+        submit(() -> {
+            MemoryManager.setMemoryLimit(0);
+            MemoryManager.setCacheCapacities(0, DEFAULT_CACHE_CAPACITY,
+                                             DEFAULT_CACHE_CAPACITY);
+        });
+    }
+
+    private void checkPage() {
+        assertEquals("Memory", executeScript("document.getElementById('p').textContent"));
+        assertEquals(1000, executeScript("data.length"));
+        assertEquals("rgb(255, 0, 0)",
+                executeScript("getComputedStyle(document.getElementById('p')).color"));
+    }
+
+    @Test public void testReleaseMemory() {
+        loadContent(PAGE);
+        checkPage();
+
+        for (int level : new int[] {
+                MemoryManager.PURGE_CACHES,
+                MemoryManager.PURGE_DECODED_DATA,
+                MemoryManager.PURGE_ALL }) {
+            submit(() -> MemoryManager.releaseMemory(level));
+            // The page keeps working on whatever was released
+            checkPage();
+        }
+
+        loadContent(PAGE);
+        checkPage();
+    }
+
+    @Test public void testReleaseMemoryInvalidLevel() {
+        submit(() -> {
+            for (int level : new int[] { -1, MemoryManager.PURGE_ALL + 1 }) {
+                try {
+                    MemoryManager.releaseMemory(level);
+                    fail("IllegalArgumentException expected for " + level);
+                } catch (IllegalArgumentException e) {
+                }
+            }
+        });
+    }
+
+    @Test public void testSetCacheCapacities() {
+        submit(() -> {
+            MemoryManager.setCacheCapacities(0, 1 << 20, 2 << 20);
+            MemoryManager.setCacheCapacities(0, 0, 0);
+        });
+        // Nothing can be kept, but pages still load
+        loadContent(PAGE);
+        checkPage();
+        submit(() -> MemoryManager.releaseMemory(MemoryManager.PURGE_CACHES));
+        checkPage();
+
+        submit(() -> {
+            int[][] invalid = {
+                { -1, 10, 20 },
+                { 20, 10, 30 },
+                { 0, 30, 20 },
+            };
+            for (int[] c : invalid) {
+                try {
+                    MemoryManager.setCacheCapacities(c[0], c[1], c[2]);
+                    fail("IllegalArgumentException expected for " +
+                         c[0] + ", " + c[1] + ", " + c[2]);
+                } catch (IllegalArgumentException e) {
+                }
+            }
+        });
+    }
+
+    @Test public void testMemoryLimit() {
+        submit(() -> {
+            assertTrue(MemoryManager.getMemoryFootprint() > 0);
+
+            MemoryManager.setMemoryLimit(1L << 40);
+            assertEquals(1L << 40, MemoryManager.getMemoryLimit());
+
+            try {
+                MemoryManager.setMemoryLimit(-1);
+                fail("IllegalArgumentException expected");
+            } catch (IllegalArgumentException e) {
+            }
+            assertEquals(1L << 40, MemoryManager.getMemoryLimit());
+
+            // A limit the process is already over purges on every poll
+            MemoryManager.setMemoryLimit(1);
+            assertEquals(1, MemoryManager.getMemoryLimit());
+        });
+        loadContent(PAGE);
+        checkPage();
+
+        submit(() -> {
+            MemoryManager.setMemoryLimit(0);
+            assertEquals(0, MemoryManager.getMemoryLimit());
+        });
+    }
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.webkit.WebPage;
+import com.sun.webkit.WebPageShim;
+import javafx.scene.web.WebEngineShim;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+/**
+ * The native page collects the rects it repaints and passes them to
+ * WebPage.fwkRepaint in batches, when its repaint timer fires or before
+ * the page is scrolled.
+ */
+public class RepaintBatchTest extends TestBase {
+
+    private static final int TIMEOUT = 10000;
+
+    private WebPage page;
+
+    @Before
+    public void setUp() {
+        page = WebEngineShim.getPage(getEngine());
+        submit(() -> page.setBounds(0, 0, 800, 600));
+    }
+
+    private static String box(String id, int x, int y, int w, int h) {
+        return "<div id='" + id + "' style='position: absolute; left: " + x + "px; top: " + y + "px;"
+                + " width: " + w + "px; height: " + h + "px; background-color: #000;'></div>";
+    }
+
+    private void load(String body) throws InterruptedException {
+        loadContent("<html><body style='margin: 0px; height: 3000px;'>" + body + "</body></html>");
+        waitForRepaints();
+    }
+
+    private int getRepaintCount() {
+        return submit(() -> WebPageShim.getRepaintCount(page));
+    }
+
+    // Waits until no fwkRepaint call has come for a while
+    private void waitForRepaints() throws InterruptedException {
+        long deadline = System.currentTimeMillis() + TIMEOUT;
+        int count = getRepaintCount();
+        while (System.currentTimeMillis() < deadline) {
+            Thread.sleep(200);
+            int last = count;
+            count = getRepaintCount();
+            if (count == last) {
+                return;
+            }
+        }
+        fail("Timed out waiting for the repaints to settle");
+    }
+
+    // Changes the color of the boxes and lays the page out, in a single
+    // event, and checks that nothing was passed to Java meanwhile
+    private void recolor(int count, String extraScript) {
+        submit(() -> {
+            int calls = WebPageShim.getRepaintCount(page);
+            getEngine().executeScript(
+                    "for (var i = 0; i < " + count + "; i++)"
+                    + " document.getElementById('b' + i).style.backgroundColor = '#f00';"
+                    + " document.body.offsetHeight;" + extraScript);
+            if (extraScript.isEmpty()) {
+                assertEquals("Repaints passed before the timer fired",
+                        calls, WebPageShim.getRepaintCount(page));
+            }
+        });
+    }
+
+    private static boolean contains(int[] rects, int x, int y, int w, int h) {
+        for (int i = 0; i + 3 < rects.length; i += 4) {
+            if (rects[i] <= x && rects[i + 1] <= y
+                    && rects[i] + rects[i + 2] >= x + w
+                    && rects[i + 1] + rects[i + 3] >= y + h) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    @Test public void testTimerFlush() throws Exception {
+        load(box("b0", 10, 10, 20, 20));
+        int calls = getRepaintCount();
+
+        recolor(1, "");
+        waitForRepaints();
+        submit(() -> {
+            assertEquals(calls + 1, WebPageShim.getRepaintCount(page));
+            assertTrue(contains(WebPageShim.getLastRepaintRects(page), 10, 10, 20, 20));
+        });
+    }
+
+    @Test public void testDistantRectsKeptApart() throws Exception {
+        load(box("b0", 0, 0, 10, 10) + box("b1", 300, 300, 10, 10));
+        int calls = getRepaintCount();
+
+        recolor(2, "");
+        waitForRepaints();
+        submit(() -> {
+            assertEquals(calls + 1, WebPageShim.getRepaintCount(page));
+            int[] rects = WebPageShim.getLastRepaintRects(page);
+            assertEquals(2 * 4, rects.length);
+            assertTrue(contains(rects, 0, 0, 10, 10));
+            assertTrue(contains(rects, 300, 300, 10, 10));
+        });
+    }
+
+    @Test public void testOverlappingRectsMerged() throws Exception {
+        load(box("b0", 0, 0, 100, 20) + box("b1", 50, 0, 100, 20));
+        int calls = getRepaintCount();
+
+        recolor(2, "");
+        waitForRepaints();
+        submit(() -> {
+            assertEquals(calls + 1, WebPageShim.getRepaintCount(page));
+            int[] rects = WebPageShim.getLastRepaintRects(page);
+            assertEquals(4, rects.length);
+            assertTrue(contains(rects, 0, 0, 150, 20));
+        });
+    }
+
+    @Test public void testRectCountBounded() throws Exception {
+        StringBuilder body = new StringBuilder();
+        for (int i = 0; i < 100; i++) {
+            body.append(box("b" + i, (i % 10) * 50, (i / 10) * 50, 4, 4));
+        }
+        load(body.toString());
+        int calls = getRepaintCount();
+        int rectCount = submit(() -> WebPageShim.getRepaintRectCount(page));
+
+        recolor(100, "");
+        waitForRepaints();
+        submit(() -> {
+            // The rects that grow the least absorb the others
+            assertEquals(calls + 1, WebPageShim.getRepaintCount(page));
+            assertEquals(rectCount + 16, WebPageShim.getRepaintRectCount(page));
+            int[] rects = WebPageShim.getLastRepaintRects(page);
+            for (int i = 0; i < 100; i++) {
+                assertTrue("Box " + i + " not repainted",
+                        contains(rects, (i % 10) * 50, (i / 10) * 50, 4, 4));
+            }
+        });
+    }
+
+    @Test public void testFlushBeforeScroll() throws Exception {
+        load(box("b0", 10, 10, 20, 20));
+        int calls = getRepaintCount();
+
+        recolor(1, " window.scrollTo(0, 500);");
+        submit(() -> {
+            // The box was passed to Java before the page was scrolled
+            assertEquals(calls + 1, WebPageShim.getRepaintCountAtScroll(page));
+            assertTrue(contains(WebPageShim.getLastRepaintRects(page), 10, 10, 20, 20));
+        });
+        waitForRepaints();
+    }
+}
@@ -27,15 +27,22 @@ package test.javafx.scene.web;
 
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
 
 import java.io.File;
+import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.FutureTask;
+import java.util.concurrent.TimeUnit;
 
 import javafx.event.Event;
+import javafx.scene.Group;
+import javafx.scene.Scene;
 import javafx.scene.input.MouseButton;
 import javafx.scene.input.MouseEvent;
 import javafx.scene.web.WebEngineShim;
 import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+import netscape.javascript.JSObject;
 
 import org.junit.Test;
 
@@ -114,4 +121,73 @@ public class WebViewTest extends TestBase {
                 "document.getElementById('six').offsetWidth == document.getElementById('nine').offsetWidth"));
         });
     }
+
+    /**
+     * Checks that a page is hidden while its view is invisible or outside
+     * of its scene.
+     */
+    @Test public void testPageVisibility() throws Exception {
+        loadContent("<html><body>Hello, World</body></html>");
+        Stage stage = submit(() -> {
+            Stage s = new Stage();
+            s.setScene(new Scene(new Group(getView()), 400, 300));
+            s.show();
+            return s;
+        });
+        try {
+            checkVisibilityState("visible");
+
+            submit(() -> getView().setVisible(false));
+            checkVisibilityState("hidden");
+            assertEquals("document.hidden", Boolean.TRUE, executeScript("document.hidden"));
+
+            submit(() -> getView().setVisible(true));
+            checkVisibilityState("visible");
+            assertEquals("document.hidden", Boolean.FALSE, executeScript("document.hidden"));
+
+            submit(() -> getView().setTranslateX(1000));
+            checkVisibilityState("hidden");
+
+            submit(() -> getView().setTranslateX(0));
+            checkVisibilityState("visible");
+        } finally {
+            submit(() -> stage.hide());
+        }
+    }
+
+    /**
+     * Checks that a page whose view is never shown stays visible and keeps
+     * running its animation frame callbacks.
+     */
+    @Test public void testNeverShownPageVisibility() throws Exception {
+        loadContent("<html><body>Hello, World</body></html>");
+        for (int i = 0; i < 10; i++) {
+            assertEquals("document.visibilityState", "visible",
+                    executeScript("document.visibilityState"));
+            Thread.sleep(50);
+        }
+
+        final CountDownLatch latch = new CountDownLatch(1);
+        submit(() -> {
+            final JSObject window = (JSObject) getEngine().executeScript("window");
+            window.setMember("latch", latch);
+            getEngine().executeScript(
+                    "window.requestAnimationFrame(function() { latch.countDown(); });");
+        });
+        assertTrue("No callback received from window.requestAnimationFrame",
+                latch.await(10, TimeUnit.SECONDS));
+    }
+
+    // The visibility is updated on the next stage pulse
+    private void checkVisibilityState(String expected) throws InterruptedException {
+        Object state = null;
+        for (int i = 0; i < 100; i++) {
+            state = executeScript("document.visibilityState");
+            if (expected.equals(state)) {
+                break;
+            }
+            Thread.sleep(50);
+        }
+        assertEquals("document.visibilityState", expected, state);
+    }
 }
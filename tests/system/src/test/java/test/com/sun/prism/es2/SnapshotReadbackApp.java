@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.prism.es2;
+
+import com.sun.prism.GraphicsPipeline;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.Group;
+import javafx.scene.Scene;
+import javafx.scene.image.PixelReader;
+import javafx.scene.image.WritableImage;
+import javafx.scene.paint.Color;
+import javafx.scene.shape.Rectangle;
+import javafx.stage.Stage;
+
+/**
+ * Application run by SnapshotReadbackTest in its own VM with the ES2
+ * pipeline and a small maximum texture size. It takes a snapshot that fits
+ * one texture and one that has to be tiled, both of which are read back
+ * through pixel buffer objects when the GL supports them, and checks every
+ * pixel of a grid of distinct colors.
+ */
+public class SnapshotReadbackApp extends Application {
+
+    // Error exit codes, 0 and 1 are reserved for normal exit and failure to
+    // launch java
+    static final int ERROR_NONE = 2;
+    static final int ERROR_TIMEOUT = 3;
+    static final int ERROR_UNEXPECTED_EXCEPTION = 4;
+    static final int ERROR_NOT_ES2 = 5;
+    static final int ERROR_WRONG_PIXELS = 6;
+
+    // Must match -Dprism.maxTextureSize passed by SnapshotReadbackTest
+    static final int MAX_TEXTURE_SIZE = 64;
+
+    private static final int TIMEOUT = 20000;
+    private static final int CELL = 10;
+    // Neither divides evenly into tiles, so there are R, B and C tiles
+    private static final int WIDTH = 170;
+    private static final int HEIGHT = 130;
+
+    public static void main(String[] args) {
+        Thread timeoutThread = new Thread(() -> {
+            try {
+                Thread.sleep(TIMEOUT);
+            } catch (InterruptedException ex) {
+            }
+            System.err.println("*** Timeout waiting for SnapshotReadbackApp to finish");
+            System.exit(ERROR_TIMEOUT);
+        });
+        timeoutThread.setDaemon(true);
+        timeoutThread.start();
+
+        try {
+            Application.launch(args);
+        } catch (Error | Exception ex) {
+            ex.printStackTrace(System.err);
+            System.exit(ERROR_UNEXPECTED_EXCEPTION);
+        }
+    }
+
+    private static int cellColor(int col, int row) {
+        return 0xff000000 | ((col * 15) << 16) | ((row * 16) << 8) | ((col + row) % 2 == 0 ? 0xff : 0x00);
+    }
+
+    @Override
+    public void start(Stage stage) {
+        if (!GraphicsPipeline.getPipeline().getClass().getSimpleName().equals("ES2Pipeline")) {
+            System.err.println("*** Not running with the ES2 pipeline");
+            System.exit(ERROR_NOT_ES2);
+        }
+
+        Group root = new Group();
+        for (int row = 0; row < HEIGHT / CELL; row++) {
+            for (int col = 0; col < WIDTH / CELL; col++) {
+                Rectangle r = new Rectangle(col * CELL, row * CELL, CELL, CELL);
+                int argb = cellColor(col, row);
+                r.setFill(Color.rgb((argb >> 16) & 0xff, (argb >> 8) & 0xff, argb & 0xff));
+                root.getChildren().add(r);
+            }
+        }
+
+        stage.setScene(new Scene(root, WIDTH, HEIGHT, Color.WHITE));
+        stage.setX(0);
+        stage.setY(0);
+        stage.show();
+        Platform.runLater(() -> check(stage));
+    }
+
+    private void check(Stage stage) {
+        try {
+            // Larger than the maximum texture size, so it is tiled
+            WritableImage tiled = stage.getScene().snapshot(null);
+            // A single cell-aligned region that fits one texture
+            Group root = (Group) stage.getScene().getRoot();
+            WritableImage whole = root.getChildren().get(0).snapshot(null, null);
+            if ((tiled.getWidth() <= MAX_TEXTURE_SIZE) || (whole.getWidth() > MAX_TEXTURE_SIZE)) {
+                System.err.println("*** Snapshot sizes do not exercise tiling");
+                System.exit(ERROR_WRONG_PIXELS);
+            }
+            if (!checkPixels(tiled.getPixelReader(), WIDTH, HEIGHT)
+                    || !checkPixels(whole.getPixelReader(), CELL, CELL)) {
+                System.exit(ERROR_WRONG_PIXELS);
+            }
+            System.exit(ERROR_NONE);
+        } catch (Error | Exception ex) {
+            ex.printStackTrace(System.err);
+            System.exit(ERROR_UNEXPECTED_EXCEPTION);
+        }
+    }
+
+    private static boolean checkPixels(PixelReader reader, int width, int height) {
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int expected = cellColor(x / CELL, y / CELL);
+                int actual = reader.getArgb(x, y);
+                if (actual != expected) {
+                    System.err.printf("*** Wrong pixel at %d,%d: expected 0x%08x, got 0x%08x%n",
+                            x, y, expected, actual);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
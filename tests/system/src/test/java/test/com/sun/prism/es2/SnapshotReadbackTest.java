@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.prism.es2;
+
+import com.sun.javafx.PlatformUtil;
+import java.util.ArrayList;
+import junit.framework.AssertionFailedError;
+import org.junit.Test;
+
+import static org.junit.Assume.assumeTrue;
+import static test.com.sun.prism.es2.SnapshotReadbackApp.*;
+
+/**
+ * Runs SnapshotReadbackApp on Mesa's llvmpipe software rasterizer, which
+ * supports pixel buffer objects and fences, so snapshots are read back
+ * asynchronously by the ES2 pipeline.
+ */
+public class SnapshotReadbackTest {
+
+    @Test (timeout = 30000)
+    public void testSnapshotReadbackOnLlvmpipe() throws Exception {
+        assumeTrue(PlatformUtil.isLinux());
+
+        final String[] jvmArgs = {
+            "--add-exports=javafx.graphics/com.sun.prism=ALL-UNNAMED",
+            "-Dprism.order=es2",
+            "-Dprism.maxTextureSize=" + MAX_TEXTURE_SIZE,
+        };
+        final ArrayList<String> cmd =
+                test.util.Util.createApplicationLaunchCommand(
+                        SnapshotReadbackApp.class.getName(), null, null, jvmArgs);
+
+        final ProcessBuilder builder = new ProcessBuilder(cmd);
+        builder.environment().put("LIBGL_ALWAYS_SOFTWARE", "1");
+        builder.environment().put("GALLIUM_DRIVER", "llvmpipe");
+        builder.redirectError(ProcessBuilder.Redirect.INHERIT);
+        builder.redirectOutput(ProcessBuilder.Redirect.INHERIT);
+        Process process = builder.start();
+        int retVal = process.waitFor();
+        switch (retVal) {
+            case ERROR_NONE:
+                return;
+            case ERROR_NOT_ES2:
+                // No GL at all, e.g. a headless machine without Mesa
+                assumeTrue(false);
+                return;
+            case 1:
+                throw new AssertionFailedError("Unable to launch SnapshotReadbackApp");
+            case ERROR_TIMEOUT:
+                throw new AssertionFailedError("SnapshotReadbackApp timed out");
+            case ERROR_WRONG_PIXELS:
+                throw new AssertionFailedError("Snapshot pixels do not match the scene");
+            default:
+                throw new AssertionFailedError("Unexpected exit code: " + retVal);
+        }
+    }
+}
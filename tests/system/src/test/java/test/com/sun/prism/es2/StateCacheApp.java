@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.prism.es2;
+
+import com.sun.prism.GraphicsPipeline;
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import javafx.animation.AnimationTimer;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.Group;
+import javafx.scene.Scene;
+import javafx.scene.image.ImageView;
+import javafx.scene.image.PixelWriter;
+import javafx.scene.image.WritableImage;
+import javafx.scene.paint.Color;
+import javafx.scene.paint.LinearGradient;
+import javafx.scene.paint.Stop;
+import javafx.scene.shape.Rectangle;
+import javafx.stage.Stage;
+
+/**
+ * Application run by StateCacheTest in its own VM with the ES2 pipeline and
+ * the native state cache enabled. It renders frames that repeat the same
+ * texture, program and uniform state while flipping the filter of a texture
+ * shared by two image views, then checks that the filter in effect is the
+ * one last requested and that the cache actually elided calls.
+ */
+public class StateCacheApp extends Application {
+
+    // Error exit codes, 0 and 1 are reserved for normal exit and failure to
+    // launch java
+    static final int ERROR_NONE = 2;
+    static final int ERROR_TIMEOUT = 3;
+    static final int ERROR_UNEXPECTED_EXCEPTION = 4;
+    static final int ERROR_NOT_ES2 = 5;
+    static final int ERROR_WRONG_PIXELS = 6;
+    static final int ERROR_NOTHING_ELIDED = 7;
+
+    private static final int TIMEOUT = 20000;
+    private static final int FRAMES = 60;
+    private static final int WIDTH = 200;
+
+    public static void main(String[] args) {
+        Thread timeoutThread = new Thread(() -> {
+            try {
+                Thread.sleep(TIMEOUT);
+            } catch (InterruptedException ex) {
+            }
+            System.err.println("*** Timeout waiting for StateCacheApp to finish");
+            System.exit(ERROR_TIMEOUT);
+        });
+        timeoutThread.setDaemon(true);
+        timeoutThread.start();
+
+        try {
+            Application.launch(args);
+        } catch (Error | Exception ex) {
+            ex.printStackTrace(System.err);
+            System.exit(ERROR_UNEXPECTED_EXCEPTION);
+        }
+    }
+
+    private ImageView smoothView;
+    private ImageView sharpView;
+    private int frame;
+
+    @Override
+    public void start(Stage stage) {
+        if (!GraphicsPipeline.getPipeline().getClass().getSimpleName().equals("ES2Pipeline")) {
+            System.err.println("*** Not running with the ES2 pipeline");
+            System.exit(ERROR_NOT_ES2);
+        }
+
+        // A black and a white texel, stretched so that linear filtering
+        // blends them and nearest filtering does not
+        WritableImage image = new WritableImage(2, 1);
+        PixelWriter pw = image.getPixelWriter();
+        pw.setArgb(0, 0, 0xff000000);
+        pw.setArgb(1, 0, 0xffffffff);
+
+        smoothView = createView(image, 0);
+        sharpView = createView(image, 50);
+
+        Group root = new Group(smoothView, sharpView);
+        for (int i = 0; i < 8; i++) {
+            // Same program with alternating uniforms from frame to frame
+            Rectangle r = new Rectangle(i * 25, 100, 25, 50);
+            r.setFill(new LinearGradient(0, 0, 1, 0, true, null,
+                    new Stop(0, (i % 2 == 0) ? Color.RED : Color.BLUE),
+                    new Stop(1, Color.GREEN)));
+            root.getChildren().add(r);
+        }
+
+        stage.setScene(new Scene(root, WIDTH, 150, Color.WHITE));
+        stage.setX(0);
+        stage.setY(0);
+        stage.show();
+
+        new AnimationTimer() {
+            @Override
+            public void handle(long now) {
+                // Flip the filter of the shared texture between draws
+                smoothView.setSmooth((frame % 2) == 0);
+                sharpView.setSmooth((frame % 2) != 0);
+                if (++frame == FRAMES) {
+                    stop();
+                    smoothView.setSmooth(true);
+                    sharpView.setSmooth(false);
+                    Platform.runLater(() -> check(stage));
+                }
+            }
+        }.start();
+    }
+
+    private static ImageView createView(WritableImage image, int y) {
+        ImageView view = new ImageView(image);
+        view.setFitWidth(WIDTH);
+        view.setFitHeight(50);
+        view.setY(y);
+        return view;
+    }
+
+    private void check(Stage stage) {
+        try {
+            WritableImage shot = stage.getScene().snapshot(null);
+            int mid = WIDTH / 2;
+            int smooth = shot.getPixelReader().getArgb(mid, 25) & 0xff;
+            int sharpLeft = shot.getPixelReader().getArgb(mid - 10, 75) & 0xff;
+            int sharpRight = shot.getPixelReader().getArgb(mid + 10, 75) & 0xff;
+            if ((smooth < 0x40) || (smooth > 0xc0)
+                    || (sharpLeft != 0x00) || (sharpRight != 0xff)) {
+                System.err.printf("*** Wrong filtering: smooth=0x%02x sharp=0x%02x,0x%02x%n",
+                        smooth, sharpLeft, sharpRight);
+                System.exit(ERROR_WRONG_PIXELS);
+            }
+
+            int elided = 0;
+            for (int count : getStateCacheCounters()) {
+                elided += count;
+            }
+            if (elided == 0) {
+                System.err.println("*** The state cache did not elide any call");
+                System.exit(ERROR_NOTHING_ELIDED);
+            }
+            System.exit(ERROR_NONE);
+        } catch (Error | Exception ex) {
+            ex.printStackTrace(System.err);
+            System.exit(ERROR_UNEXPECTED_EXCEPTION);
+        }
+    }
+
+    private static int[] getStateCacheCounters() throws Exception {
+        Object factory = GraphicsPipeline.getDefaultResourceFactory();
+        Field contextField = factory.getClass().getDeclaredField("context");
+        contextField.setAccessible(true);
+        Object context = contextField.get(factory);
+        Method getGLContext = context.getClass().getDeclaredMethod("getGLContext");
+        getGLContext.setAccessible(true);
+        Object glContext = getGLContext.invoke(context);
+        Class<?> glContextClass = glContext.getClass();
+        while (!glContextClass.getSimpleName().equals("GLContext")) {
+            glContextClass = glContextClass.getSuperclass();
+        }
+        Method getCounters = glContextClass.getDeclaredMethod("getStateCacheCounters", boolean.class);
+        getCounters.setAccessible(true);
+        return (int[]) getCounters.invoke(glContext, false);
+    }
+}